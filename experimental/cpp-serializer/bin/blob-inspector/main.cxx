@@ -1,115 +1,655 @@
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <cerrno>
+#include <unordered_map>
+#include <cstring>
+#include <fstream>
+#include <sstream>
 #include <iostream>
 #include <iomanip>
-#include <fstream>
 #include <cstddef>
+#include <stdexcept>
 
+#include <glob.h>
 #include <assert.h>
-#include <string.h>
-#include <proton/types.h>
-#include <proton/codec.h>
+#include <dirent.h>
+#include <getopt.h>
+#include <unistd.h>
 #include <sys/stat.h>
 
 #import "debug.h"
 
-#include "proton/proton_wrapper.h"
+#include "codec/MappedBlob.h"
+#include "codec/codec_wrapper.h"
 
-#include "amqp/AMQPHeader.h"
 #include "amqp/AMQPSectionId.h"
 #include "amqp/descriptors/AMQPDescriptorRegistory.h"
 
 #include "amqp/schema/Envelope.h"
-#include "amqp/CompositeFactory.h"
+#include "amqp/SchemaCache.h"
+#include "amqp/WorkStealingPool.h"
+#include "amqp/reader/Query.h"
+#include "amqp/reader/JsonWriter.h"
 
 /******************************************************************************/
 
-void
-data_and_stop(std::ifstream & f_, ssize_t sz) {
-    char * blob = new char[sz];
-    memset (blob, 0, sz);
-    f_.read(blob, sz);
-
-    pn_data_t * d = pn_data(sz);
-
-    // returns how many bytes we processed which right now we don't care
-    // about but I assume there is a case where it doesn't process the
-    // entire file
-    auto rtn = pn_data_decode (d, blob, sz);
-    assert (rtn == sz);
+/**
+ * Returns false if the blob didn't satisfy the query, in which case
+ * nothing is written
+ */
+bool
+data_and_stop(
+    const char * blob,
+    size_t sz,
+    amqp::internal::SchemaCache & cache_,
+    amqp::internal::reader::JsonWriter & json_,
+    amqp::internal::reader::Queries * queries_,
+    const char * path_
+) {
+    /*
+     * Walk the blob in place rather than have proton build a tree of
+     * every value in it, only the schema section gets that treatment
+     */
+    codec::Cursor d (blob, sz);
+    d.next();
 
     std::unique_ptr<amqp::internal::schema::Envelope> envelope;
 
-    if (pn_data_is_described(d)) {
-        proton::auto_enter p (d);
+    if (d.isDescribed()) {
+        codec::auto_enter p (&d);
 
-        auto a = pn_data_get_ulong(d);
+        auto a = d.getULong();
 
         envelope.reset (
             dynamic_cast<amqp::internal::schema::Envelope *> (
-                amqp::AMQPDescriptorRegistory[a]->build(d).release()));
+                amqp::descriptor (a).build (&d).release()));
+    }
+
+    if (!envelope) {
+        throw std::runtime_error ("Blob doesn't contain an envelope");
+    }
+
+    /*
+     * Only decode the schema, and build readers for it, if we haven't
+     * seen it before
+     */
+    auto & compiled = cache_.compile (*envelope);
 
-        DBG (std::cout << std::endl << "Types in schema: " << std::endl
-            << *envelope << std::endl); // NOLINT
+    DBG (std::cout << std::endl << "Types in schema: " << std::endl
+        << compiled.schema() << std::endl); // NOLINT
+
+    auto reader = compiled.factory().byDescriptor (envelope->descriptor());
+
+    if (!reader) {
+        throw std::runtime_error (
+            "No reader for descriptor " + envelope->descriptor());
     }
 
-    amqp::internal::CompositeFactory cf;
+    const amqp::internal::reader::Query * query { nullptr };
+
+    if (queries_) {
+        auto r = dynamic_cast<const amqp::internal::reader::Reader *>(reader.get());
 
-    cf.process (envelope->schema());
+        std::string why ("Cannot query " + envelope->descriptor());
+
+        if (r) {
+            query = queries_->compile (*r, &why);
+        }
 
-    auto reader = cf.byDescriptor (envelope->descriptor());
-    assert (reader);
+        /*
+         * In a batch a type the query doesn't fit is simply one more that
+         * doesn't match, only a blob inspected on its own is told why
+         */
+        if (!query) {
+            if (path_) return false;
+
+            throw std::runtime_error (why);
+        }
+    }
 
     {
         // move to the actual blob entry in the tree - ideally we'd have
         // saved this on the Envelope but that's not easily doable as we
         // can't grab an actual copy of our data pointer
-        proton::auto_enter p (d);
-        pn_data_next (d);
-        proton::is_list (d);
-        assert (pn_data_get_list (d) == 3);
+        codec::auto_enter p (&d);
+        d.next();
+        codec::is_list (&d);
+        assert (d.getList() == 3);
         {
-            proton::auto_enter p (d);
+            codec::auto_enter p (&d);
+
+            if (query && !query->matches (&d, compiled.schema())) {
+                return false;
+            }
 
             // We wrap our output like this to make sure it's valid JSON to
-            // facilitate easy pretty printing
-            std::cout
-                << reader->dump ("{ Parsed", d, envelope->schema())->dump()
-                << " }" << std::endl;
+            // facilitate easy pretty printing. Values are written as they're
+            // read rather than building them into a tree first.
+            json_.beginComposite ("");
+
+            if (path_) {
+                json_.field ("path");
+                json_.value (std::string_view (path_));
+            }
+
+            if (query && query->selects()) {
+                query->select (&d, compiled.schema(), json_);
+            } else {
+                json_.field ("Parsed");
+                reader->visit (&d, compiled.schema(), json_);
+            }
+
+            json_.endComposite();
+            json_.endDocument();
+        }
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+
+bool
+inspect (
+    const char * path_,
+    amqp::internal::SchemaCache & cache_,
+    amqp::internal::reader::JsonWriter & json_,
+    amqp::internal::reader::Queries * queries_,
+    bool batch_
+) {
+    codec::MappedBlob blob (path_);
+
+    if (blob.section() != amqp::DATA_AND_STOP) {
+        std::stringstream ss;
+        ss << "BAD ENCODING " << blob.section() << " != " << amqp::DATA_AND_STOP;
+        throw std::runtime_error (ss.str());
+    }
+
+    return data_and_stop (
+        blob.payload(), blob.payloadSize(), cache_, json_, queries_,
+        batch_ ? path_ : nullptr);
+}
+
+/******************************************************************************
+ *
+ * Batch mode
+ *
+ ******************************************************************************/
+
+/**
+ * Where the documents rendered by parallel workers end up. Ordered, they're
+ * held back until everything before them has been written so the output
+ * matches a single threaded run. Unordered, they go out as they finish.
+ */
+class Output {
+    private :
+        int  m_fd;
+        bool m_ordered;
+
+        std::mutex m_lock;
+
+        /**
+         * Rendered out of turn, keyed on their position
+         */
+        std::map<size_t, std::string> m_pending;
+        size_t m_next;
+
+        std::string m_buffer;
+
+    public :
+        Output (int fd_, bool ordered_)
+            : m_fd (fd_)
+            , m_ordered (ordered_)
+            , m_next (0)
+        { }
+
+        void
+        write (size_t seq_, std::string docs_) {
+            std::lock_guard<std::mutex> lock (m_lock);
+
+            if (!m_ordered) {
+                append (docs_);
+                return;
+            }
+
+            if (seq_ != m_next) {
+                m_pending.emplace (seq_, std::move (docs_));
+                return;
+            }
+
+            append (docs_);
+
+            for (auto it = m_pending.find (++m_next) ;
+                 it != m_pending.end() && it->first == m_next ;
+                 it = m_pending.erase (it), ++m_next
+            ) {
+                append (it->second);
+            }
+        }
+
+        void
+        flush() {
+            std::lock_guard<std::mutex> lock (m_lock);
+            drain();
+        }
+
+    private :
+        void
+        append (const std::string & docs_) {
+            m_buffer += docs_;
+            if (m_buffer.size() >= 64 * 1024) drain();
+        }
+
+        void
+        drain() {
+            const char * p = m_buffer.data();
+            size_t left = m_buffer.size();
+
+            while (left > 0) {
+                auto rtn = ::write (m_fd, p, left);
+
+                if (rtn < 0) {
+                    if (errno == EINTR) continue;
+                    m_buffer.clear();
+                    throw std::runtime_error (
+                        std::string ("Failed to write JSON: ") + strerror (errno));
+                }
+
+                p += rtn;
+                left -= rtn;
+            }
+
+            m_buffer.clear();
+        }
+};
+
+/******************************************************************************/
+
+/**
+ * Decodes every blob it's given against a single schema cache, writing one
+ * JSON document per line. A blob that can't be decoded gets a line saying
+ * why rather than stopping the run.
+ *
+ * Given a pool, blobs are decoded by its workers, each rendering into a
+ * writer of its own, with the results passed through an Output. Otherwise
+ * they're decoded as they're found straight into the writer we were given.
+ *
+ * Given queries, only the blobs that match them are written. Blobs of types
+ * the queries don't fit are among those that don't, not failures.
+ */
+class Batch {
+    private :
+        amqp::internal::SchemaCache &        m_cache;
+        amqp::internal::reader::JsonWriter & m_json;
+
+        amqp::internal::WorkStealingPool * m_pool;
+        Output *                           m_output;
+        amqp::internal::reader::Queries *  m_queries;
+
+        std::vector<std::unique_ptr<amqp::internal::reader::JsonWriter>> m_writers;
+
+        size_t              m_blobs;
+        std::atomic<size_t> m_failures;
+        std::atomic<size_t> m_matches;
+
+    public :
+        Batch (
+            amqp::internal::SchemaCache & cache_,
+            amqp::internal::reader::JsonWriter & json_,
+            amqp::internal::WorkStealingPool * pool_ = nullptr,
+            Output * output_ = nullptr,
+            amqp::internal::reader::Queries * queries_ = nullptr
+        ) : m_cache (cache_)
+          , m_json (json_)
+          , m_pool (pool_)
+          , m_output (output_)
+          , m_queries (queries_)
+          , m_blobs (0)
+          , m_failures (0)
+          , m_matches (0)
+        {
+            for (size_t i { 0 } ; m_pool && i < m_pool->size() ; ++i) {
+                m_writers.emplace_back (
+                    std::make_unique<amqp::internal::reader::JsonWriter>());
+                m_writers.back()->references (m_json.references());
+            }
+        }
+
+        /**
+         * Queued tasks refer back to us so can't be left to outlive us if
+         * we're unwinding because finding blobs failed
+         */
+        ~Batch() {
+            try {
+                if (m_pool) m_pool->wait();
+            } catch (...) {
+            }
+        }
+
+        void
+        operator() (const char * path_) {
+            auto seq = m_blobs++;
+
+            if (!m_pool) {
+                decode (path_, m_json);
+                return;
+            }
+
+            m_pool->submit ([this, seq, path = std::string (path_)](size_t worker_) {
+                auto & json = *m_writers[worker_];
+
+                // our slot is filled whatever happens, in order everything
+                // after it would otherwise be held back for good
+                try {
+                    decode (path.c_str(), json);
+                } catch (...) {
+                    json.rollback();
+                    m_output->write (seq, std::string());
+                    throw;
+                }
+
+                m_output->write (seq, json.take());
+            });
+        }
+
+        /**
+         * Wait for anything still being decoded
+         */
+        void
+        finish() {
+            if (m_pool) {
+                m_pool->wait();
+                m_output->flush();
+            }
+        }
+
+        size_t blobs() const { return m_blobs; }
+        size_t failures() const { return m_failures; }
+        size_t matches() const { return m_matches; }
+
+    private :
+        void
+        decode (const char * path_, amqp::internal::reader::JsonWriter & json_) {
+            try {
+                if (inspect (path_, m_cache, json_, m_queries, true)) {
+                    ++m_matches;
+                }
+            } catch (const std::exception & e) {
+                fail (path_, e.what(), json_);
+            } catch (...) {
+                fail (path_, "Unknown error", json_);
+            }
+        }
+
+        void
+        fail (
+            const char * path_,
+            const char * why_,
+            amqp::internal::reader::JsonWriter & json_
+        ) {
+            ++m_failures;
+
+            // if some of the document has already gone out there's
+            // nothing to do but finish off the line it's on
+            if (!json_.rollback()) {
+                json_.endDocument();
+            }
+
+            json_.beginComposite ("");
+            json_.field ("path");
+            json_.value (std::string_view (path_));
+            json_.field ("error");
+            json_.value (std::string_view (why_));
+            json_.endComposite();
+            json_.endDocument();
+        }
+};
+
+/******************************************************************************/
+
+/**
+ * Every regular file beneath a directory, in the order the file system
+ * gives them to us
+ */
+void
+fromDirectory (const std::string & path_, Batch & batch_) {
+    std::unique_ptr<DIR, int (*)(DIR *)> dir (opendir (path_.c_str()), closedir);
+
+    if (!dir) {
+        throw std::runtime_error ("Cannot open directory " + path_);
+    }
+
+    while (auto * entry = readdir (dir.get())) {
+        if (strcmp (entry->d_name, ".") == 0 || strcmp (entry->d_name, "..") == 0) {
+            continue;
+        }
+
+        auto path = path_ + "/" + entry->d_name;
+
+        struct stat st { };
+        if (stat (path.c_str(), &st) != 0) continue;
+
+        if (S_ISDIR (st.st_mode)) {
+            fromDirectory (path, batch_);
+        } else if (S_ISREG (st.st_mode)) {
+            batch_ (path.c_str());
+        }
+    }
+}
+
+/******************************************************************************/
+
+void
+fromGlob (const std::string & pattern_, Batch & batch_) {
+    glob_t g;
+
+    switch (glob (pattern_.c_str(), 0, nullptr, &g)) {
+        case 0 : break;
+        case GLOB_NOMATCH : return;
+        default : throw std::runtime_error ("Bad pattern " + pattern_);
+    }
+
+    std::unique_ptr<glob_t, void (*)(glob_t *)> guard (&g, globfree);
+
+    for (size_t i { 0 } ; i < g.gl_pathc ; ++i) {
+        batch_ (g.gl_pathv[i]);
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * One path per line, "-" reads them from stdin
+ */
+void
+fromList (const std::string & path_, Batch & batch_) {
+    std::ifstream file;
+
+    if (path_ != "-") {
+        file.open (path_);
+
+        if (!file) {
+            throw std::runtime_error ("Cannot open file list " + path_);
         }
     }
+
+    std::istream & in = path_ == "-" ? std::cin : file;
+
+    std::string line;
+    while (std::getline (in, line)) {
+        if (!line.empty()) {
+            batch_ (line.c_str());
+        }
+    }
+}
+
+/******************************************************************************/
+
+void
+usage (const char * name_) {
+    std::cerr << "usage: " << name_ << " [-c catalog] [-r] [query] blob" << std::endl
+              << "       " << name_ << " [-c catalog] [-r] [-s] [-j threads [-u]] [query] "
+                 "(-d directory | -g glob | -l list) ..." << std::endl
+              << std::endl
+              << "  query is any of" << std::endl
+              << "    --select path    write only the value at path, repeatable" << std::endl
+              << "    --where  cond    write only blobs where path op literal holds, repeatable" << std::endl
+              << std::endl
+              << "  -c catalog    reuse decoded schemas across runs" << std::endl
+              << "  -d directory  decode every file beneath directory" << std::endl
+              << "  -g glob       decode every file matching glob" << std::endl
+              << "  -l list       decode every file named in list, one per line, - for stdin" << std::endl
+              << "  -j threads    decode in parallel, 0 for a thread per core" << std::endl
+              << "  -r            write back references as {\"@ref\" : n} rather than repeating" << std::endl
+              << "                the object, n counting objects in the order they finish" << std::endl
+              << "  -s            report schema cache statistics on stderr" << std::endl
+              << "  -u            with -j, write blobs as they finish rather than in order" << std::endl
+              << std::endl
+              << "In batch mode, -d, -g or -l, each blob is written as a single line"
+                 " of JSON" << std::endl
+              << "including its path." << std::endl
+              << std::endl
+              << "Paths name fields separated by dots, lists are stepped into with [*]," << std::endl
+              << "for example --select 'legs[*].amount' --where 'legs[*].currency == GBP'." << std::endl
+              << "The operators are == != < <= > >=, a condition on a list holds if it" << std::endl
+              << "holds for any element. With --where, nothing matching is a failure." << std::endl;
 }
 
 /******************************************************************************/
 
 int
 main (int argc, char **argv) {
-    struct stat results { };
+    /*
+     * A schema catalog lets repeated invocations skip decoding any schema
+     * a previous run has already seen
+     */
+    std::unique_ptr<amqp::internal::SchemaCatalog> catalog;
+    std::string catalogPath;
 
-    if (stat(argv[1], &results) != 0) {
-        return EXIT_FAILURE;
-    }
+    /*
+     * Batch sources in the order they were given, tagged by their flag
+     */
+    std::vector<std::pair<char, std::string>> sources;
+    bool stats { false };
+
+    /*
+     * Negative for single threaded
+     */
+    long threads { -1 };
+    bool ordered { true };
+    bool references { false };
 
-    std::ifstream f (argv[1], std::ios::in | std::ios::binary);
-    std::array<char, 7> header { };
-    f.read(header.data(), 7);
+    std::vector<std::string> select;
+    std::vector<amqp::internal::reader::Query::Condition> where;
+
+    static const struct option options[] = {
+        { "select", required_argument, nullptr, 'S' },
+        { "where",  required_argument, nullptr, 'W' },
+        { nullptr,  0,                 nullptr, 0 }
+    };
+
+    int opt;
+    while ((opt = getopt_long (argc, argv, "c:d:g:j:l:rsu", options, nullptr)) != -1) {
+        switch (opt) {
+            case 'S' : select.emplace_back (optarg); break;
+            case 'W' :
+                try {
+                    where.emplace_back (amqp::internal::reader::Query::condition (optarg));
+                } catch (const std::runtime_error & e) {
+                    std::cerr << e.what() << std::endl;
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'c' : catalogPath = optarg; break;
+            case 'd' :
+            case 'g' :
+            case 'l' : sources.emplace_back (opt, optarg); break;
+            case 'j' : threads = strtol (optarg, nullptr, 10); break;
+            case 'r' : references = true; break;
+            case 's' : stats = true; break;
+            case 'u' : ordered = false; break;
+            default  : usage (argv[0]); return EXIT_FAILURE;
+        }
+    }
 
-    if (header != amqp::AMQP_HEADER) {
-        std::cerr << "Bad Header in blob" << std::endl;
+    if (sources.empty() == (optind >= argc) || optind + 1 < argc
+        || (sources.empty() && threads >= 0)
+    ) {
+        usage (argv[0]);
         return EXIT_FAILURE;
     }
 
-    amqp::amqp_section_id_t encoding;
-    f.read((char *)&encoding, 1);
+    try {
+        if (!catalogPath.empty()) {
+            catalog = std::make_unique<amqp::internal::SchemaCatalog> (catalogPath);
+        }
+
+        amqp::internal::SchemaCache cache (catalog.get());
+        amqp::internal::reader::JsonWriter json (STDOUT_FILENO);
+        json.references (references);
+
+        std::unique_ptr<amqp::internal::reader::Queries> queries;
+
+        if (!select.empty() || !where.empty()) {
+            queries = std::make_unique<amqp::internal::reader::Queries> (select, where);
+        }
+
+        int rtn { EXIT_SUCCESS };
+
+        if (sources.empty()) {
+            if (!inspect (argv[optind], cache, json, queries.get(), false)) {
+                rtn = EXIT_FAILURE;
+            }
+        } else {
+            std::unique_ptr<amqp::internal::WorkStealingPool> pool;
+            std::unique_ptr<Output> output;
+
+            if (threads >= 0) {
+                pool = std::make_unique<amqp::internal::WorkStealingPool> (threads);
+                output = std::make_unique<Output> (STDOUT_FILENO, ordered);
+            }
+
+            Batch batch (cache, json, pool.get(), output.get(), queries.get());
 
-    if (encoding == amqp::DATA_AND_STOP) {
-        data_and_stop(f, results.st_size - 8);
-    } else {
-        std::cerr << "BAD ENCODING " << encoding << " != "
-            << amqp::DATA_AND_STOP << std::endl;
+            for (const auto & source : sources) {
+                switch (source.first) {
+                    case 'd' : fromDirectory (source.second, batch); break;
+                    case 'g' : fromGlob (source.second, batch); break;
+                    case 'l' : fromList (source.second, batch); break;
+                }
+            }
 
+            batch.finish();
+
+            if (batch.failures()) {
+                std::cerr << batch.failures() << " of " << batch.blobs()
+                          << " blobs could not be decoded" << std::endl;
+                rtn = EXIT_FAILURE;
+            }
+
+            if (!where.empty() && !batch.matches()) {
+                rtn = EXIT_FAILURE;
+            }
+        }
+
+        json.flush();
+
+        if (stats) {
+            std::cerr << "schemas: " << cache.size()
+                      << " hits: " << cache.hits()
+                      << " misses: " << cache.misses() << std::endl;
+        }
+
+        if (catalog) catalog->save();
+
+        return rtn;
+    } catch (const std::exception & e) {
+        std::cerr << e.what() << std::endl;
         return EXIT_FAILURE;
     }
-
-    return EXIT_SUCCESS;
 }
 
 /******************************************************************************/
@@ -1,25 +1,31 @@
+#include <set>
+#include <fstream>
 #include <iostream>
 #include <iomanip>
-#include <fstream>
 #include <cstddef>
+#include <stdexcept>
 
 #include <assert.h>
-#include <string.h>
+#include <unistd.h>
 #include <proton/types.h>
 #include <proton/codec.h>
-#include <sys/stat.h>
 #include <sstream>
 
 #import "debug.h"
 
+#include "codec/MappedBlob.h"
 #include "proton/proton_wrapper.h"
 
-#include "amqp/AMQPHeader.h"
 #include "amqp/AMQPSectionId.h"
 #include "amqp/descriptors/AMQPDescriptorRegistory.h"
 
 #include "amqp/schema/Envelope.h"
 #include "amqp/CompositeFactory.h"
+#include "amqp/SchemaCache.h"
+#include "amqp/SchemaCatalog.h"
+#include "amqp/CodeGenerator.h"
+
+#include "codec/codec_wrapper.h"
 
 /******************************************************************************/
 
@@ -28,7 +34,7 @@ printNode (pn_data_t * d_) {
     std::stringstream ss;
 
     if (pn_data_is_described (d_)) {
-        amqp::AMQPDescriptorRegistory[22UL]->read (d_, ss);
+        amqp::describedDescriptor().read (d_, ss);
     }
 
     std::cout << ss.str() << std::endl;
@@ -38,51 +44,185 @@ printNode (pn_data_t * d_) {
 /******************************************************************************/
 
 void
-data_and_stop(std::ifstream & f_, ssize_t sz) {
-    char * blob = new char[sz];
-    memset (blob, 0, sz);
-    f_.read(blob, sz);
-
+data_and_stop(const char * blob, size_t sz) {
     pn_data_t * d = pn_data(sz);
 
     // returns how many bytes we processed which right now we don't care
     // about but I assume there is a case where it doesn't process the
     // entire file
     auto rtn = pn_data_decode (d, blob, sz);
-    assert (rtn == sz);
+    assert (rtn == static_cast<ssize_t>(sz));
 
     printNode (d);
 
+    pn_data_free (d);
 }
 
 /******************************************************************************/
 
-int
-main (int argc, char **argv) {
-    struct stat results { };
+/**
+ * Pull the schema out of a blob without going through proton, the cache
+ * only decodes each distinct schema once however many blobs share it
+ */
+const amqp::internal::schema::Schema &
+schema (const char * path_, amqp::internal::SchemaCache & cache_) {
+    codec::MappedBlob blob (path_);
 
-    if (stat(argv[1], &results) != 0) {
-        return EXIT_FAILURE;
+    if (blob.section() != amqp::DATA_AND_STOP) {
+        throw std::runtime_error (std::string ("BAD ENCODING ") + path_);
     }
 
-    std::ifstream f (argv[1], std::ios::in | std::ios::binary);
-    std::array<char, 7> header { };
-    f.read(header.data(), 7);
+    codec::Cursor d (blob.payload(), blob.payloadSize());
+    d.next();
+
+    std::unique_ptr<amqp::internal::schema::Envelope> envelope;
+
+    if (d.isDescribed()) {
+        codec::auto_enter p (&d);
+
+        auto a = d.getULong();
+
+        envelope.reset (
+            dynamic_cast<amqp::internal::schema::Envelope *> (
+                amqp::descriptor (a).build (&d).release()));
+    }
 
-    if (header != amqp::AMQP_HEADER) {
-        std::cerr << "Bad Header in blob" << std::endl;
+    if (!envelope) {
+        throw std::runtime_error (std::string ("No envelope in ") + path_);
+    }
+
+    return cache_.compile (*envelope).schema();
+}
+
+/******************************************************************************/
+
+/**
+ * Write the C++ structs and bindings for every type in the blobs and
+ * catalog we were given
+ */
+void
+generate (
+    const std::string & header_,
+    const std::string & namespace_,
+    const std::string & cmake_,
+    const std::string & target_,
+    const std::string & catalog_,
+    char ** blobs_,
+    int count_
+) {
+    amqp::internal::CodeGenerator generator (namespace_);
+    amqp::internal::SchemaCache cache;
+
+    std::set<const amqp::internal::schema::Schema *> seen;
+
+    for (int i { 0 } ; i < count_ ; ++i) {
+        const auto & s = schema (blobs_[i], cache);
+
+        if (seen.insert (&s).second) {
+            generator.add (s);
+        }
+    }
+
+    if (!catalog_.empty()) {
+        amqp::internal::SchemaCatalog catalog (catalog_);
+
+        for (const auto & s : catalog.schemas()) {
+            generator.add (*s);
+        }
+    }
+
+    auto write = [](const std::string & path_, const auto & f_) {
+        if (path_ == "-") {
+            f_ (std::cout);
+            return;
+        }
+
+        std::ofstream out (path_);
+
+        if (!out) {
+            throw std::runtime_error ("Cannot write " + path_);
+        }
+
+        f_ (out);
+    };
+
+    write (header_, [&generator](std::ostream & out_) {
+        generator.header (out_);
+    });
+
+    if (!cmake_.empty()) {
+        auto slash = header_.rfind ('/');
+        auto name = slash == std::string::npos ? header_ : header_.substr (slash + 1);
+
+        write (cmake_, [&](std::ostream & out_) {
+            generator.cmake (out_, target_, name);
+        });
+    }
+}
+
+/******************************************************************************/
+
+void
+usage (const char * name_) {
+    std::cerr << "usage: " << name_ << " blob" << std::endl
+              << "       " << name_ << " -g header [-n namespace] [-m cmake [-t target]] "
+                 "[-c catalog] [blob ...]" << std::endl
+              << std::endl
+              << "  -g header     write C++ structs and bindings for every type, - for stdout" << std::endl
+              << "  -n namespace  put the structs in namespace, default corda" << std::endl
+              << "  -m cmake      write a CMake snippet declaring a library for the header" << std::endl
+              << "  -t target     name the library target, default corda-types" << std::endl
+              << "  -c catalog    include every schema in a schema catalog" << std::endl;
+}
+
+/******************************************************************************/
+
+int
+main (int argc, char **argv) {
+    std::string header;
+    std::string ns { "corda" };
+    std::string cmake;
+    std::string target { "corda-types" };
+    std::string catalog;
+
+    int opt;
+    while ((opt = getopt (argc, argv, "c:g:m:n:t:")) != -1) {
+        switch (opt) {
+            case 'c' : catalog = optarg; break;
+            case 'g' : header = optarg; break;
+            case 'm' : cmake = optarg; break;
+            case 'n' : ns = optarg; break;
+            case 't' : target = optarg; break;
+            default  : usage (argv[0]); return EXIT_FAILURE;
+        }
+    }
+
+    if (header.empty()
+        ? (optind + 1 != argc || !catalog.empty() || !cmake.empty())
+        : (optind == argc && catalog.empty())
+    ) {
+        usage (argv[0]);
         return EXIT_FAILURE;
     }
 
-    amqp::amqp_section_id_t encoding;
-    f.read((char *)&encoding, 1);
+    try {
+        if (!header.empty()) {
+            generate (header, ns, cmake, target, catalog, argv + optind, argc - optind);
+            return EXIT_SUCCESS;
+        }
+
+        codec::MappedBlob blob (argv[optind]);
 
-    if (encoding == amqp::DATA_AND_STOP) {
-        data_and_stop(f, results.st_size - 8);
-    } else {
-        std::cerr << "BAD ENCODING " << encoding << " != "
-            << amqp::DATA_AND_STOP << std::endl;
+        if (blob.section() == amqp::DATA_AND_STOP) {
+            data_and_stop (blob.payload(), blob.payloadSize());
+        } else {
+            std::cerr << "BAD ENCODING " << blob.section() << " != "
+                << amqp::DATA_AND_STOP << std::endl;
 
+            return EXIT_FAILURE;
+        }
+    } catch (const std::runtime_error & e) {
+        std::cerr << e.what() << std::endl;
         return EXIT_FAILURE;
     }
 
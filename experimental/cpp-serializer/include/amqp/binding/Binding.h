@@ -0,0 +1,129 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <tuple>
+#include <string_view>
+#include <type_traits>
+
+/******************************************************************************
+ *
+ * amqp::binding
+ *
+ ******************************************************************************/
+
+/**
+ * Declares how a Corda type maps onto a C++ struct so blobs of it can be
+ * decoded straight into the struct's members. Specialise Binding for the
+ * struct, naming the Java type it binds to and listing its fields
+ *
+ *   struct Cash {
+ *       int64_t     quantity;
+ *       std::string currency;
+ *   };
+ *
+ *   template<>
+ *   struct amqp::binding::Binding<Cash> {
+ *       static constexpr std::string_view type { "net.corda.finance.Cash" };
+ *
+ *       static constexpr auto fields = std::make_tuple (
+ *           amqp::binding::field ("quantity", &Cash::quantity),
+ *           amqp::binding::field ("currency", &Cash::currency));
+ *   };
+ *
+ * Members may be an int32_t, int64_t, double, bool, std::string or
+ * amqp::reader::Binary, another bound struct or enum, a std::vector of any
+ * of those, or a std::optional of any of those. A Binary is a view of the
+ * blob, only good for as long as it is. Fields the type has that aren't
+ * listed are skipped, listing one it doesn't have is an error unless the
+ * member is optional.
+ *
+ * Types evolve. Each schema a blob might carry is bound separately, by
+ * field name, so fields may be reordered, added or removed across
+ * versions. As with nullable properties on the JVM an optional member
+ * is left empty when the blob's version of its type predates the field,
+ * or the field was null.
+ *
+ * Enums are bound by listing their constants, by the names the JVM
+ * gives them
+ *
+ *   enum class Currency { GBP, USD };
+ *
+ *   template<>
+ *   struct amqp::binding::Binding<Currency> {
+ *       static constexpr std::string_view type { "net.corda.finance.Currency" };
+ *
+ *       static constexpr auto constants = std::array {
+ *           amqp::binding::constant ("GBP", Currency::GBP),
+ *           amqp::binding::constant ("USD", Currency::USD) };
+ *   };
+ *
+ * A blob holding a constant that isn't listed is read through the renames
+ * and defaults recorded in its transforms schema, see schema::Transforms.
+ *
+ * A binding may also name the type's descriptor on the JVM
+ *
+ *   static constexpr std::string_view descriptor { "net.corda:..." };
+ *
+ * which serialising uses rather than deriving one, decoding matches
+ * descriptors from the blob's own schema and ignores it.
+ *
+ * See amqp::internal::binding::Decoder for the decoding and
+ * serialiser::Serialiser for the encoding, which doesn't yet cover enum
+ * or optional members.
+ */
+namespace amqp::binding {
+
+    template<typename T>
+    struct Binding;
+
+    template<class C, typename M>
+    struct Field {
+        using Type = M;
+
+        std::string_view name;
+        M C::*           member;
+    };
+
+    template<class C, typename M>
+    constexpr Field<C, M>
+    field (std::string_view name_, M C::* member_) {
+        return Field<C, M> { name_, member_ };
+    }
+
+    template<typename E>
+    struct Constant {
+        std::string_view name;
+        E                value;
+    };
+
+    template<typename E>
+    constexpr Constant<E>
+    constant (std::string_view name_, E value_) {
+        return Constant<E> { name_, value_ };
+    }
+
+    /**
+     * Whether T has a Binding
+     */
+    template<typename T, typename = void>
+    struct is_bound : std::false_type { };
+
+    template<typename T>
+    struct is_bound<T, std::void_t<decltype (Binding<T>::type)>> : std::true_type { };
+
+    template<typename T>
+    inline constexpr bool is_bound_v = is_bound<T>::value;
+
+    /**
+     * Whether T is a bound struct or a bound enum
+     */
+    template<typename T>
+    inline constexpr bool is_bound_struct_v = is_bound_v<T> && !std::is_enum_v<T>;
+
+    template<typename T>
+    inline constexpr bool is_bound_enum_v = is_bound_v<T> && std::is_enum_v<T>;
+
+}
+
+/******************************************************************************/
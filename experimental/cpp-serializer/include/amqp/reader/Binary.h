@@ -0,0 +1,29 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string_view>
+
+/******************************************************************************
+ *
+ * struct amqp::reader::Binary
+ *
+ ******************************************************************************/
+
+namespace amqp::reader {
+
+    /**
+     * Binary data, a SecureHash or a key say, as a view of the bytes in
+     * the blob rather than a copy of them. Only valid for as long as the
+     * blob is.
+     */
+    struct Binary {
+        std::string_view bytes;
+
+        bool operator== (const Binary & rhs_) const { return bytes == rhs_.bytes; }
+        bool operator!= (const Binary & rhs_) const { return bytes != rhs_.bytes; }
+    };
+
+}
+
+/******************************************************************************/
@@ -2,9 +2,9 @@
 
 /******************************************************************************/
 
-#include <any>
-
 #include "amqp/AMQPDescribed.h"
+#include "amqp/reader/Variant.h"
+#include "amqp/reader/IVisitor.h"
 
 #include "amqp/schema/Schema.h"
 
@@ -14,7 +14,11 @@
  *
  ******************************************************************************/
 
-struct pn_data_t;
+namespace codec {
+
+    class Cursor;
+
+}
 
 /******************************************************************************
  *
@@ -56,18 +60,31 @@ namespace amqp::reader {
             virtual const std::string & name() const = 0;
             virtual const std::string & type() const = 0;
 
-            virtual std::any read (pn_data_t *) const = 0;
-            virtual std::string readString (pn_data_t *) const = 0;
+            /**
+             * Decode the value at the cursor, and move past it, into
+             * native types, lists as lists and composites as records
+             * of their fields
+             */
+            virtual Variant read (codec::Cursor *) const = 0;
+            virtual std::string readString (codec::Cursor *) const = 0;
 
             virtual std::unique_ptr<IValue> dump(
                     const std::string &,
-                    pn_data_t *,
+                    codec::Cursor *,
                     const SchemaType &) const = 0;
 
             virtual std::unique_ptr<IValue> dump(
-                    pn_data_t *,
+                    codec::Cursor *,
                     const SchemaType &) const = 0;
 
+            /**
+             * Read the value at the cursor, reporting it as a series of
+             * events to the visitor rather than building it up in memory
+             */
+            virtual void visit (
+                    codec::Cursor *,
+                    const SchemaType &,
+                    IVisitor &) const = 0;
     };
 
 }
@@ -0,0 +1,102 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+/******************************************************************************
+ *
+ * class amqp::reader::IVisitor
+ *
+ ******************************************************************************/
+
+/**
+ * The event based alternative to building a tree of IValue's. Readers
+ * call back into one of these as they walk the blob so whatever is
+ * consuming the values never needs to hold more than the current
+ * path through the object graph.
+ *
+ * Events always nest correctly, within a composite each value, composite
+ * or list is preceded by a call to field naming it. List elements are
+ * unnamed.
+ *
+ * Strings are views into the blob and are only valid for the duration
+ * of the call. The smaller integer types are passed on as an int32_t, a
+ * uint as an int64_t and a float as a double. Chars, uuids and symbols
+ * are passed on as their string form, decimals as the binary of their
+ * encoding.
+ *
+ * Where the blob refers back to an object it already holds, rather than
+ * repeating it, the visitor is offered the reference first, see below,
+ * and only if it declines is the object walked again in its place.
+ */
+namespace amqp::reader {
+
+    class IVisitor {
+        public :
+            virtual ~IVisitor() = default;
+
+            virtual void beginComposite (const std::string & type_) = 0;
+            virtual void endComposite() = 0;
+
+            virtual void beginList() = 0;
+            virtual void endList() = 0;
+
+            virtual void field (const std::string & name_) = 0;
+
+            virtual void value (int32_t) = 0;
+            virtual void value (int64_t) = 0;
+            virtual void value (double) = 0;
+            virtual void value (bool) = 0;
+            virtual void value (std::string_view) = 0;
+
+            /**
+             * The rest have defaults, for visitors with no use for the
+             * distinction, passing them on as one of the above
+             */
+            virtual void
+            value (uint64_t value_) {
+                if (value_ > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+                    value (static_cast<double>(value_));
+                } else {
+                    value (static_cast<int64_t>(value_));
+                }
+            }
+
+            /**
+             * Bytes that aren't text, only valid for the duration of the
+             * call, as with strings
+             */
+            virtual void
+            binary (std::string_view bytes_) {
+                value (bytes_);
+            }
+
+            /**
+             * Milliseconds since the epoch
+             */
+            virtual void
+            timestamp (int64_t millis_) {
+                value (millis_);
+            }
+
+            virtual void null() = 0;
+
+            /**
+             * Return true to have taken the reference as the value, it
+             * numbers the object in the order objects finished in the
+             * blob, false, the default, to be shown the object again
+             */
+            virtual bool reference (size_t index_) {
+                return false;
+            }
+    };
+
+}
+
+/******************************************************************************/
+
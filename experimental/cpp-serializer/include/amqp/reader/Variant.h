@@ -0,0 +1,130 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <variant>
+#include <stdexcept>
+#include <string_view>
+
+#include "amqp/reader/Binary.h"
+
+/******************************************************************************
+ *
+ * class amqp::reader::Variant
+ *
+ ******************************************************************************/
+
+namespace amqp::reader {
+
+    class Variant;
+
+    /**
+     * A composite's fields, in the order its schema declares them. Names
+     * aren't repeated for every instance, they're the reader's to give.
+     */
+    struct Record {
+        std::vector<Variant> fields;
+
+        bool operator== (const Record & rhs_) const;
+    };
+
+    /**
+     * A decoded value as returned by IReader::read. Primitives are held in
+     * place, so only strings too long for the small string buffer, and the
+     * backing arrays of lists and records, ever touch the heap. Binary
+     * values aren't copied at all, they're views of the blob.
+     *
+     * The smaller integer types are held as an Int, a uint as a Long and
+     * a float as a Double. Chars, uuids and symbols are held as their
+     * String form, timestamps as a Long of milliseconds since the epoch
+     * and decimals as the Binary of their encoding.
+     */
+    class Variant {
+        public :
+            enum class Type {
+                Null, Bool, Int, Long, Double, String, List, Record, ULong, Binary };
+
+            using List = std::vector<Variant>;
+
+        private :
+            /**
+             * Alternatives in the same order as Type so one indexes the other
+             */
+            std::variant<
+                std::monostate, bool, int32_t, int64_t, double,
+                std::string, List, amqp::reader::Record,
+                uint64_t, amqp::reader::Binary> m_value;
+
+            template<typename T>
+            const T &
+            get (const char * what_) const {
+                if (auto p = std::get_if<T> (&m_value)) return *p;
+                throw std::runtime_error (std::string ("Value is not ") + what_);
+            }
+
+        public :
+            Variant() = default;
+
+            explicit Variant (bool v_) : m_value (v_) { }
+            explicit Variant (int32_t v_) : m_value (v_) { }
+            explicit Variant (int64_t v_) : m_value (v_) { }
+            explicit Variant (double v_) : m_value (v_) { }
+            explicit Variant (std::string v_) : m_value (std::move (v_)) { }
+            explicit Variant (const char * v_) : m_value (std::string (v_)) { }
+            explicit Variant (List v_) : m_value (std::move (v_)) { }
+            explicit Variant (amqp::reader::Record v_) : m_value (std::move (v_)) { }
+            explicit Variant (uint64_t v_) : m_value (v_) { }
+            explicit Variant (amqp::reader::Binary v_) : m_value (v_) { }
+
+            Type type() const { return static_cast<Type> (m_value.index()); }
+
+            bool isNull() const { return type() == Type::Null; }
+
+            /**
+             * Each throws std::runtime_error if we aren't one
+             */
+            bool asBool() const { return get<bool> ("a bool"); }
+            int32_t asInt() const { return get<int32_t> ("an int"); }
+            int64_t asLong() const { return get<int64_t> ("a long"); }
+            double asDouble() const { return get<double> ("a double"); }
+            const std::string & asString() const { return get<std::string> ("a string"); }
+            const List & asList() const { return get<List> ("a list"); }
+            const amqp::reader::Record & asRecord() const {
+                return get<amqp::reader::Record> ("a record");
+            }
+            uint64_t asULong() const { return get<uint64_t> ("a ulong"); }
+            const amqp::reader::Binary & asBinary() const {
+                return get<amqp::reader::Binary> ("binary");
+            }
+
+            /**
+             * An element of a list or a field of a record
+             */
+            const Variant &
+            operator[] (size_t idx_) const {
+                const auto & values = type() == Type::List
+                    ? asList()
+                    : asRecord().fields;
+
+                if (idx_ >= values.size()) {
+                    throw std::runtime_error ("Index out of range");
+                }
+
+                return values[idx_];
+            }
+
+            bool operator== (const Variant & rhs_) const { return m_value == rhs_.m_value; }
+            bool operator!= (const Variant & rhs_) const { return !(*this == rhs_); }
+    };
+
+    inline bool
+    Record::operator== (const Record & rhs_) const {
+        return fields == rhs_.fields;
+    }
+
+}
+
+/******************************************************************************/
@@ -2,14 +2,109 @@
 
 /******************************************************************************/
 
+#include <string>
+#include <string_view>
+
+#include "amqp/AMQPHeader.h"
+#include "amqp/AMQPSectionId.h"
+#include "amqp/binding/Binding.h"
+
+#include "serialiser/Member.h"
+
+/******************************************************************************
+ *
+ * class serialiser::Serialiser
+ *
+ ******************************************************************************/
+
 namespace serialiser {
 
+    /**
+     * Encodes bound structs, see amqp/binding/Binding.h, as Corda blobs,
+     * the header, section id and an envelope holding the object, its
+     * schema and an empty transforms schema.
+     *
+     * The whole blob is written in one pass straight into a single
+     * buffer. A type's schema section is only encoded the first time
+     * it's serialised, after that the cached bytes are copied in as they
+     * are, leaving just the object itself to encode.
+     *
+     * Blobs read back with the Decoder for the same struct, and with
+     * anything else that reads Corda blobs given the descriptors are
+     * either the JVM's, when the Binding names them, or derived ones
+     * the JVM will evolve from.
+     *
+     * The cached schemas are shared, and built once, between every
+     * Serialiser. A Serialiser's own buffer isn't, use one per thread.
+     */
     class Serialiser {
+        private :
+            std::string m_buffer;
+
+        public :
+            /**
+             * Valid until this serialises something else
+             */
+            template<typename T>
+            std::string_view
+            serialise (const T & value_) {
+                serialise (value_, m_buffer);
+                return m_buffer;
+            }
+
+            /**
+             * Replaces whatever the buffer held, reusing its storage
+             */
+            template<typename T>
+            static void
+            serialise (const T & value_, std::string & buffer_) {
+                buffer_.clear();
+                buffer_.append (amqp::AMQP_HEADER.data(), amqp::AMQP_HEADER.size());
+                buffer_ += static_cast<char>(amqp::DATA_AND_STOP);
+
+                amqp::internal::serialiser::Encoder out (buffer_);
+
+                out.putDescribed (amqp::internal::ENVELOPE);
+                auto envelope = out.beginList();
+                amqp::internal::serialiser::Member<T>::encode (out, value_);
+                out.putEncoded (schema<T>());
+                out.endList (envelope, 3);
+            }
 
+            /**
+             * The encoded schema and transforms schema sections of blobs
+             * of T, as they'll be spliced into every one of them
+             */
+            template<typename T>
+            static const std::string &
+            schema() {
+                static_assert (amqp::binding::is_bound_struct_v<T>,
+                    "Only bound structs can be serialised");
+
+                static const std::string bytes = []() {
+                    amqp::internal::serialiser::Types types;
+                    amqp::internal::serialiser::Member<T>::schema (types);
+
+                    std::string rtn;
+                    amqp::internal::serialiser::Encoder out (rtn);
+
+                    out.putDescribed (amqp::internal::SCHEMA);
+                    auto schema = out.beginList();
+                    auto notations = out.beginList();
+                    out.putEncoded (types.bytes);
+                    out.endList (notations, types.count);
+                    out.endList (schema, 1);
+
+                    out.putDescribed (amqp::internal::TRANSFORM_SCHEMA);
+                    out.putEmptyMap();
+
+                    return rtn;
+                }();
+
+                return bytes;
+            }
     };
 
 }
 
 /******************************************************************************/
-
-
@@ -0,0 +1,340 @@
+#include "CodeGenerator.h"
+
+#include <cctype>
+#include <ostream>
+#include <algorithm>
+
+#include "debug.h"
+
+#include "amqp/schema/Composite.h"
+#include "amqp/schema/restricted-types/List.h"
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * The C++ type each primitive is bound as, see binding::Member
+     */
+    const std::map<std::string, std::string> primitives { // NOLINT
+        { "int",     "int32_t" },
+        { "long",    "int64_t" },
+        { "double",  "double" },
+        { "boolean", "bool" },
+        { "string",  "std::string" },
+        { "binary",  "amqp::reader::Binary" }
+    };
+
+    const std::set<std::string> keywords { // NOLINT
+        "alignas", "alignof", "and", "asm", "auto", "bool", "break", "case",
+        "catch", "char", "class", "const", "constexpr", "continue", "default",
+        "delete", "do", "double", "else", "enum", "explicit", "export",
+        "extern", "false", "float", "for", "friend", "goto", "if", "inline",
+        "int", "long", "mutable", "namespace", "new", "noexcept", "not",
+        "nullptr", "operator", "or", "private", "protected", "public",
+        "register", "return", "short", "signed", "sizeof", "static",
+        "struct", "switch", "template", "this", "throw", "true", "try",
+        "typedef", "typeid", "typename", "union", "unsigned", "using",
+        "virtual", "void", "volatile", "while", "xor"
+    };
+
+    /**
+     * Anything that can't appear in an identifier becomes an underscore,
+     * keywords get one on the end
+     */
+    std::string
+    identifier (const std::string & name_) {
+        std::string rtn { name_ };
+
+        std::replace_if (rtn.begin(), rtn.end(),
+            [](char c_) { return !isalnum (static_cast<unsigned char>(c_)); }, '_');
+
+        if (rtn.empty() || isdigit (static_cast<unsigned char>(rtn.front()))) {
+            rtn.insert (0, "_");
+        }
+
+        if (keywords.count (rtn)) rtn += "_";
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::CodeGenerator
+ *
+ ******************************************************************************/
+
+amqp::internal::
+CodeGenerator::CodeGenerator (std::string namespace_)
+    : m_namespace (std::move (namespace_))
+    , m_schemas (0)
+{ }
+
+/******************************************************************************/
+
+void
+amqp::internal::
+CodeGenerator::add (const schema::Schema & schema_) {
+    ++m_schemas;
+
+    for (const auto & level : schema_) {
+        for (const auto & type : level) {
+            if (type->type() == schema::AMQPTypeNotation::Restricted) {
+                if (auto list = dynamic_cast<const schema::List *>(type.get())) {
+                    m_lists[list->name()] = list->listOf();
+                }
+
+                continue;
+            }
+
+            const auto & composite = dynamic_cast<const schema::Composite &>(*type);
+
+            std::vector<Field> fields;
+            for (const auto & field : composite.fields()) {
+                fields.push_back ({ field->name(), field->resolvedType() });
+            }
+
+            auto it = m_composites.find (composite.name());
+
+            if (it == m_composites.end()) {
+                Type t { composite.name(), { composite.descriptor() }, std::move (fields), { } };
+                m_composites.emplace (composite.name(), std::move (t));
+                continue;
+            }
+
+            // another version of a type we already know, keep what the two
+            // have in common
+            auto & known = it->second;
+
+            known.descriptors.insert (composite.descriptor());
+
+            auto common = std::remove_if (known.fields.begin(), known.fields.end(),
+                [&fields](const Field & field_) {
+                    return std::none_of (fields.begin(), fields.end(),
+                        [&field_](const Field & other_) {
+                            return other_.name == field_.name && other_.type == field_.type;
+                        });
+                });
+
+            for (auto i = common ; i != known.fields.end() ; ++i) {
+                DBG ("CodeGenerator: " << known.name << "." << i->name
+                    << " isn't in every version" << std::endl); // NOLINT
+                known.skipped.push_back (i->name + " : " + i->type + ", not in every version");
+            }
+
+            known.fields.erase (common, known.fields.end());
+        }
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * An empty string if the type can't be bound
+ */
+std::string
+amqp::internal::
+CodeGenerator::cppType (const std::string & type_) const {
+    auto p = primitives.find (type_);
+    if (p != primitives.end()) return p->second;
+
+    if (m_composites.count (type_)) return structName (type_);
+
+    auto l = m_lists.find (type_);
+    if (l != m_lists.end()) {
+        auto element = cppType (l->second);
+        return element.empty() ? "" : "std::vector<" + element + ">";
+    }
+
+    return "";
+}
+
+/******************************************************************************/
+
+/**
+ * Whether the struct is the whole of the one version of its type we've
+ * seen, when serialising it can use that version's descriptor
+ */
+bool
+amqp::internal::
+CodeGenerator::exact (const Type & type_) const {
+    return type_.descriptors.size() == 1
+        && type_.skipped.empty()
+        && std::none_of (type_.fields.begin(), type_.fields.end(),
+            [this](const Field & field_) { return cppType (field_.type).empty(); });
+}
+
+/******************************************************************************/
+
+/**
+ * The class's simple name unless two types share it, when the whole of
+ * its name is used for all of them
+ */
+std::string
+amqp::internal::
+CodeGenerator::structName (const std::string & type_) const {
+    auto simple = [](const std::string & name_) {
+        auto generic = name_.find ('<');
+        auto dot = name_.rfind ('.', generic);
+
+        return identifier (dot == std::string::npos ? name_ : name_.substr (dot + 1));
+    };
+
+    auto name = simple (type_);
+
+    for (const auto & other : m_composites) {
+        if (other.first != type_ && simple (other.first) == name) {
+            return identifier (type_);
+        }
+    }
+
+    return name;
+}
+
+/******************************************************************************/
+
+/**
+ * Anything a struct holds by value has to be defined before it, vectors
+ * of types not yet defined are fine
+ */
+void
+amqp::internal::
+CodeGenerator::order (
+    const std::string & type_,
+    std::set<std::string> & seen_,
+    std::vector<const Type *> & ordered_
+) const {
+    auto it = m_composites.find (type_);
+
+    if (it == m_composites.end() || !seen_.insert (type_).second) {
+        return;
+    }
+
+    for (const auto & field : it->second.fields) {
+        order (field.type, seen_, ordered_);
+
+        auto l = m_lists.find (field.type);
+        while (l != m_lists.end()) {
+            order (l->second, seen_, ordered_);
+            l = m_lists.find (l->second);
+        }
+    }
+
+    ordered_.push_back (&it->second);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+CodeGenerator::header (std::ostream & out_) const {
+    std::set<std::string> seen;
+    std::vector<const Type *> ordered;
+
+    for (const auto & composite : m_composites) {
+        order (composite.first, seen, ordered);
+    }
+
+    out_ << "#pragma once\n\n"
+         << "/*\n"
+         << " * Generated by schema-dumper from " << m_schemas
+         << (m_schemas == 1 ? " schema" : " schemas") << ", do not edit\n"
+         << " */\n\n"
+         << "#include <string>\n"
+         << "#include <vector>\n"
+         << "#include <cstdint>\n"
+         << "#include <string_view>\n\n"
+         << "#include \"amqp/reader/Binary.h\"\n"
+         << "#include \"amqp/binding/Binding.h\"\n\n"
+         << "/******************************************************************************/\n\n"
+         << "namespace " << m_namespace << " {\n";
+
+    for (const auto * type : ordered) {
+        out_ << "\n    /**\n"
+             << "     * " << type->name << "\n";
+
+        for (const auto & descriptor : type->descriptors) {
+            out_ << "     *   " << descriptor << "\n";
+        }
+
+        out_ << "     */\n"
+             << "    struct " << structName (type->name) << " {\n";
+
+        for (const auto & field : type->fields) {
+            auto cpp = cppType (field.type);
+
+            if (cpp.empty()) {
+                out_ << "        // " << field.name << " : " << field.type << ", not bound\n";
+            } else {
+                out_ << "        " << cpp << " " << identifier (field.name) << " { };\n";
+            }
+        }
+
+        for (const auto & skipped : type->skipped) {
+            out_ << "        // " << skipped << "\n";
+        }
+
+        out_ << "    };\n";
+    }
+
+    out_ << "\n}\n\n"
+         << "/******************************************************************************/\n\n"
+         << "namespace amqp::binding {\n";
+
+    for (const auto * type : ordered) {
+        auto name = m_namespace + "::" + structName (type->name);
+
+        out_ << "\n    template<>\n"
+             << "    struct Binding<" << name << "> {\n"
+             << "        static constexpr std::string_view type {\n"
+             << "            \"" << type->name << "\" };\n\n";
+
+        if (exact (*type)) {
+            out_ << "        static constexpr std::string_view descriptor {\n"
+                 << "            \"" << *type->descriptors.begin() << "\" };\n\n";
+        }
+
+        out_ << "        static constexpr auto fields = std::make_tuple (";
+
+        const char * sep = "";
+
+        for (const auto & field : type->fields) {
+            if (cppType (field.type).empty()) continue;
+
+            out_ << sep << "\n            field (\"" << field.name << "\", &"
+                 << name << "::" << identifier (field.name) << ")";
+            sep = ",";
+        }
+
+        out_ << ");\n"
+             << "    };\n";
+    }
+
+    out_ << "\n}\n\n"
+         << "/******************************************************************************/\n";
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+CodeGenerator::cmake (
+    std::ostream & out_,
+    const std::string & target_,
+    const std::string & header_
+) const {
+    out_ << "#\n"
+         << "# Generated by schema-dumper, do not edit\n"
+         << "#\n"
+         << "# The bindings in " << header_ << " are header only, linking against\n"
+         << "# " << target_ << " brings in its directory and the libraries that decoding\n"
+         << "# and serialising need\n"
+         << "#\n\n"
+         << "add_library (" << target_ << " INTERFACE)\n\n"
+         << "target_include_directories (" << target_ << " INTERFACE ${CMAKE_CURRENT_LIST_DIR})\n\n"
+         << "target_link_libraries (" << target_ << " INTERFACE serialiser amqp codec)\n";
+}
+
+/******************************************************************************/
@@ -0,0 +1,93 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <set>
+#include <map>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "amqp/schema/Schema.h"
+
+/******************************************************************************
+ *
+ * class amqp::internal::CodeGenerator
+ *
+ ******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * Turns the types of one or more schemas into C++, a struct for every
+     * composite along with the amqp::binding::Binding that lets a
+     * binding::Decoder decode blobs straight into it, see
+     * amqp/binding/Binding.h.
+     *
+     * Lists become std::vectors of their elements. Fields of a type we
+     * can't bind are left out of the struct, noted with a comment.
+     *
+     * The same type seen in several schemas, different versions of it,
+     * keeps only the fields every version has, with the same type, so
+     * the binding fits them all. A struct that is all of the only
+     * version seen keeps its descriptor, so serialising one writes blobs
+     * the JVM recognises.
+     */
+    class CodeGenerator {
+        private :
+            struct Field {
+                std::string name;
+                std::string type;
+            };
+
+            struct Type {
+                std::string              name;
+                std::set<std::string>    descriptors;
+                std::vector<Field>       fields;
+                std::vector<std::string> skipped;
+            };
+
+            std::string m_namespace;
+
+            std::map<std::string, Type> m_composites;
+
+            /**
+             * List type to the type of its elements
+             */
+            std::map<std::string, std::string> m_lists;
+
+            size_t m_schemas;
+
+        public :
+            /**
+             * The namespace, possibly nested, the structs are put in
+             */
+            explicit CodeGenerator (std::string);
+
+            void add (const schema::Schema &);
+
+            /**
+             * A header holding every struct and its binding
+             */
+            void header (std::ostream &) const;
+
+            /**
+             * A CMake snippet declaring an interface library, named by
+             * target, for the header, to be included from its directory
+             */
+            void cmake (std::ostream &, const std::string &, const std::string &) const;
+
+        private :
+            std::string cppType (const std::string &) const;
+            std::string structName (const std::string &) const;
+            bool exact (const Type &) const;
+
+            void order (
+                const std::string &,
+                std::set<std::string> &,
+                std::vector<const Type *> &) const;
+    };
+
+}
+
+/******************************************************************************/
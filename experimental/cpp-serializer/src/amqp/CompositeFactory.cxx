@@ -7,6 +7,7 @@
 #include <functional>
 
 #include <assert.h>
+#include <stdexcept>
 
 #include "debug.h"
 
@@ -15,9 +16,13 @@
 #include "amqp/reader/PropertyReader.h"
 #include "reader/CompositeReader.h"
 #include "reader/RestrictedReader.h"
+#include "reader/restricted-readers/MapReader.h"
 #include "reader/restricted-readers/ListReader.h"
+#include "reader/restricted-readers/EnumReader.h"
 
+#include "schema/restricted-types/Map.h"
 #include "schema/restricted-types/List.h"
+#include "schema/restricted-types/Enum.h"
 
 /******************************************************************************/
 
@@ -42,7 +47,17 @@ namespace {
                                       << std::endl); // NOLINT
             assert (map_[k_]);
             assert (map_[k_] != nullptr);
-            assert (k_ == map_[k_]->type());
+
+            /*
+             * Not an assert, a schema naming a type we build a reader
+             * for under a different name is bad input, not a bug
+             */
+            if (k_ != map_[k_]->type()) {
+                auto type = map_[k_]->type();
+                map_.erase (k_);
+                throw std::runtime_error (
+                    "Reader for \"" + k_ + "\" reads \"" + type + "\"");
+            }
 
             return map_[k_];
         } else {
@@ -86,6 +101,20 @@ CompositeFactory::process (const SchemaType & schema_) {
 
 /******************************************************************************/
 
+/**
+ * Every reader is owned by m_readersByType, and lives as long as we do,
+ * so resolving the references between them into plain pointers is safe
+ */
+void
+amqp::internal::
+CompositeFactory::freeze() {
+    for (auto & reader : m_readersByType) {
+        if (reader.second) reader.second->freeze();
+    }
+}
+
+/******************************************************************************/
+
 std::shared_ptr<amqp::internal::reader::Reader>
 amqp::internal::
 CompositeFactory::process(
@@ -113,7 +142,7 @@ amqp::internal::
 CompositeFactory::processComposite (
         const amqp::internal::schema::AMQPTypeNotation & type_)
 {
-    std::vector<std::weak_ptr<reader::Reader>> readers;
+    std::vector<reader::CompositeReader::Field> readers;
 
     const auto & fields = dynamic_cast<const amqp::internal::schema::Composite &> (
             type_).fields();
@@ -133,32 +162,57 @@ CompositeFactory::processComposite (
                         });
 
                 assert (reader);
-                readers.emplace_back(reader);
-                assert (readers.back().lock());
+                readers.emplace_back (reader::CompositeReader::Field { field->name(), reader });
+                assert (readers.back().reader.lock());
                 break;
             }
             case amqp::internal::schema::FieldType::CompositeProperty : {
                 auto reader = m_readersByType[field->type()];
 
                 assert (reader);
-                readers.emplace_back(reader);
-                assert (readers.back().lock());
+                readers.emplace_back (reader::CompositeReader::Field { field->name(), reader });
+                assert (readers.back().reader.lock());
                 break;
             }
             case schema::FieldType::RestrictedProperty :  {
                 auto reader = m_readersByType[field->requires().front()];
 
                 assert (reader);
-                readers.emplace_back(reader);
-                assert (readers.back().lock());
+                readers.emplace_back (reader::CompositeReader::Field { field->name(), reader });
+                assert (readers.back().reader.lock());
                 break;
             }
         }
 
-        assert (readers.back().lock());
+        assert (readers.back().reader.lock());
     }
 
-    return std::make_shared<reader::CompositeReader> (type_.name(), readers);
+    return std::make_shared<reader::CompositeReader> (
+            type_.name(), type_.descriptor(), std::move (readers));
+}
+
+/******************************************************************************/
+
+/**
+ * The reader for what a restricted type holds, the elements of a list or
+ * the keys or values of a map. Anything that isn't a primitive will
+ * already have been built, the schema being ordered by dependency.
+ */
+std::shared_ptr<amqp::internal::reader::Reader>
+amqp::internal::
+CompositeFactory::processElement (const std::string & type_) {
+    if (amqp::internal::schema::Field::typeIsPrimitive (type_)) {
+        DBG ("  Primitive - " << type_ << std::endl); // NOLINT
+        return computeIfAbsent<reader::Reader> (
+                m_readersByType,
+                type_,
+                [& type_] () -> std::shared_ptr<reader::PropertyReader> {
+                    return reader::PropertyReader::make (type_);
+                });
+    } else {
+        DBG ("  Composite - " << type_ << std::endl); // NOLINT
+        return m_readersByType[type_];
+    }
 }
 
 /******************************************************************************/
@@ -172,28 +226,31 @@ CompositeFactory::processRestricted (
     const auto & restricted = dynamic_cast<const amqp::internal::schema::Restricted &> (
             type_);
 
-    if (restricted.restrictedType() ==
-        amqp::internal::schema::Restricted::RestrictedTypes::List)
-    {
-        const auto & list = dynamic_cast<const amqp::internal::schema::List &> (restricted);
+    switch (restricted.restrictedType()) {
+        case amqp::internal::schema::Restricted::RestrictedTypes::List : {
+            const auto & list = dynamic_cast<const amqp::internal::schema::List &> (restricted);
 
-        DBG ("Processing List - " << list.listOf() << std::endl); // NOLINT
+            DBG ("Processing List - " << list.listOf() << std::endl); // NOLINT
 
-        if (amqp::internal::schema::Field::typeIsPrimitive(list.listOf())) {
-            DBG ("  List of Primitives" << std::endl); // NOLINT
-            auto reader = computeIfAbsent<reader::Reader> (
-                    m_readersByType,
-                    list.listOf(),
-                    [& list] () -> std::shared_ptr<reader::PropertyReader> {
-                        return reader::PropertyReader::make (list.listOf());
-                    });
+            return std::make_shared<reader::ListReader> (
+                    list.name(), processElement (list.listOf()));
+        }
+        case amqp::internal::schema::Restricted::RestrictedTypes::Map : {
+            const auto & map = dynamic_cast<const amqp::internal::schema::Map &> (restricted);
 
-            return std::make_shared<reader::ListReader> (type_.name(), reader);
-        } else {
-            DBG ("  List of Composite - " << list.listOf() << std::endl); // NOLINT
-            auto reader = m_readersByType[list.listOf()];
+            DBG ("Processing Map - " << map.keyType() << " -> " << map.valueType() << std::endl); // NOLINT
+
+            auto key = processElement (map.keyType());
+            auto value = processElement (map.valueType());
+
+            return std::make_shared<reader::MapReader> (map.name(), key, value);
+        }
+        case amqp::internal::schema::Restricted::RestrictedTypes::Enum : {
+            const auto & enum_ = dynamic_cast<const amqp::internal::schema::Enum &> (restricted);
+
+            DBG ("Processing Enum - " << enum_.choices().size() << " choices" << std::endl); // NOLINT
 
-            return std::make_shared<reader::ListReader> (list.name(), reader);
+            return std::make_shared<reader::EnumReader> (enum_.name(), enum_.choices());
         }
     }
 
@@ -32,6 +32,13 @@ namespace amqp::internal {
 
             void process (const SchemaType &) override;
 
+            /**
+             * Once every schema has been processed, fix the reader graph
+             * in place so reading never needs to lock a weak_ptr. Anything
+             * processed afterwards requires another freeze before use.
+             */
+            void freeze();
+
             const std::shared_ptr<ReaderType> byType (
                     const std::string &) override;
 
@@ -47,6 +54,9 @@ namespace amqp::internal {
 
             std::shared_ptr<reader::Reader> processRestricted (
                     const schema::AMQPTypeNotation &);
+
+            std::shared_ptr<reader::Reader> processElement (
+                    const std::string &);
     };
 
 }
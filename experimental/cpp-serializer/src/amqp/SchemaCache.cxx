@@ -0,0 +1,192 @@
+#include "SchemaCache.h"
+
+#include "debug.h"
+
+#include "descriptors/corda-descriptors/EnvelopeDescriptor.h"
+
+/******************************************************************************
+ *
+ * amqp::internal::CompiledSchema
+ *
+ ******************************************************************************/
+
+amqp::internal::
+CompiledSchema::CompiledSchema (
+    uPtr<schema::Schema> schema_,
+    uPtr<schema::Transforms> transforms_
+) : m_schema (std::move (schema_))
+  , m_transforms (std::move (transforms_))
+{
+    m_factory.process (*m_schema);
+    m_factory.freeze();
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::Schema &
+amqp::internal::
+CompiledSchema::schema() const {
+    return *m_schema;
+}
+
+/******************************************************************************/
+
+const amqp::internal::schema::Transforms &
+amqp::internal::
+CompiledSchema::transforms() const {
+    return *m_transforms;
+}
+
+/******************************************************************************/
+
+amqp::internal::CompositeFactory &
+amqp::internal::
+CompiledSchema::factory() {
+    return m_factory;
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::SchemaCache
+ *
+ ******************************************************************************/
+
+amqp::internal::
+SchemaCache::SchemaCache (SchemaCatalog * catalog_)
+    : m_catalog (catalog_)
+    , m_hits (0)
+    , m_misses (0)
+{ }
+
+/******************************************************************************/
+
+/**
+ * 64 bit FNV-1a, we only need something cheap with a good spread, the
+ * byte comparison on a hit is what actually guarantees correctness
+ */
+uint64_t
+amqp::internal::
+SchemaCache::fingerprint (std::string_view bytes_) {
+    uint64_t hash { 0xcbf29ce484222325UL };
+
+    for (auto c : bytes_) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 0x100000001b3UL;
+    }
+
+    return hash;
+}
+
+/******************************************************************************/
+
+amqp::internal::CompiledSchema &
+amqp::internal::
+SchemaCache::compile (const schema::Envelope & envelope_) {
+    return compile (envelope_.schemaBytes());
+}
+
+/******************************************************************************/
+
+/**
+ * Caller must hold the lock, shared or otherwise
+ */
+amqp::internal::CompiledSchema *
+amqp::internal::
+SchemaCache::find (uint64_t key_, std::string_view bytes_) const {
+    auto range = m_cache.equal_range (key_);
+
+    for (auto it = range.first ; it != range.second ; ++it) {
+        if (it->second.bytes == bytes_) {
+            return it->second.compiled.get();
+        }
+    }
+
+    return nullptr;
+}
+
+/******************************************************************************/
+
+amqp::internal::CompiledSchema &
+amqp::internal::
+SchemaCache::compile (std::string_view bytes_) {
+    auto key = fingerprint (bytes_);
+
+    {
+        std::shared_lock<std::shared_mutex> lock (m_lock);
+
+        if (auto * compiled = find (key, bytes_)) {
+            DBG ("SchemaCache - hit " << key << std::endl); // NOLINT
+            ++m_hits;
+            return *compiled;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock (m_lock);
+
+    /*
+     * Someone else may have compiled it whilst we waited for the lock
+     */
+    if (auto * compiled = find (key, bytes_)) {
+        DBG ("SchemaCache - hit " << key << std::endl); // NOLINT
+        ++m_hits;
+        return *compiled;
+    }
+
+    DBG ("SchemaCache - miss " << key << std::endl); // NOLINT
+    ++m_misses;
+
+    uPtr<schema::Schema> schema;
+
+    if (m_catalog) {
+        schema = m_catalog->find (key, bytes_);
+    }
+
+    if (!schema) {
+        schema = EnvelopeDescriptor::buildSchema (bytes_);
+
+        if (m_catalog) {
+            m_catalog->add (key, bytes_, *schema);
+        }
+    }
+
+    /*
+     * The catalog only keeps schemas, transforms are rare and small
+     * enough to just decode again
+     */
+    auto it = m_cache.emplace (
+            key,
+            Entry {
+                std::string (bytes_),
+                std::make_unique<CompiledSchema> (
+                    std::move (schema),
+                    EnvelopeDescriptor::buildTransforms (bytes_)) });
+
+    return *(it->second.compiled);
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::
+SchemaCache::size() const {
+    std::shared_lock<std::shared_mutex> lock (m_lock);
+    return m_cache.size();
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::
+SchemaCache::hits() const {
+    return m_hits;
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::
+SchemaCache::misses() const {
+    return m_misses;
+}
+
+/******************************************************************************/
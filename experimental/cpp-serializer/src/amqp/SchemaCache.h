@@ -0,0 +1,120 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <cstdint>
+#include <string_view>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "types.h"
+
+#include "CompositeFactory.h"
+#include "SchemaCatalog.h"
+#include "amqp/schema/Schema.h"
+#include "amqp/schema/Envelope.h"
+#include "amqp/schema/Transforms.h"
+
+/******************************************************************************
+ *
+ * class amqp::internal::CompiledSchema
+ *
+ ******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * A decoded schema, and the transforms that came with it, along with
+     * the factory holding every reader built from it. Readers hold no
+     * references into the blob they were first built for so one of these
+     * can be reused for any blob whose schema and transforms sections are
+     * byte for byte the same.
+     *
+     * Nothing is modified once constructed, any number of threads can
+     * read blobs against one at the same time.
+     */
+    class CompiledSchema {
+        private :
+            uPtr<schema::Schema>     m_schema;
+            uPtr<schema::Transforms> m_transforms;
+            CompositeFactory         m_factory;
+
+        public :
+            explicit CompiledSchema (
+                uPtr<schema::Schema>,
+                uPtr<schema::Transforms> = std::make_unique<schema::Transforms>());
+
+            const schema::Schema & schema() const;
+            const schema::Transforms & transforms() const;
+            CompositeFactory & factory();
+    };
+
+}
+
+/******************************************************************************
+ *
+ * class amqp::internal::SchemaCache
+ *
+ ******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * Every blob carries its full schema but in practice the vast majority
+     * of blobs we see share a handful of them. Rather than decode and
+     * process the schema for each, cache the result keyed on a fingerprint
+     * of the encoded schema and transforms sections.
+     *
+     * The bytes themselves are kept alongside the entry so a fingerprint
+     * collision costs us a second entry rather than a wrong answer.
+     * Entries are never evicted, references handed out remain valid for
+     * the lifetime of the cache.
+     *
+     * Optionally backed by a persistent catalog that is consulted before
+     * decoding a schema we've not seen in this process, and which is
+     * told about anything we do end up decoding.
+     *
+     * Safe to share between threads. Lookups only take a shared lock,
+     * a miss is compiled under an exclusive one, which also covers the
+     * catalog, so concurrent misses on the same schema only build it
+     * once.
+     */
+    class SchemaCache {
+        private :
+            struct Entry {
+                std::string          bytes;
+                uPtr<CompiledSchema> compiled;
+            };
+
+            std::unordered_multimap<uint64_t, Entry> m_cache;
+
+            mutable std::shared_mutex m_lock;
+
+            SchemaCatalog * m_catalog;
+
+            std::atomic<size_t> m_hits;
+            std::atomic<size_t> m_misses;
+
+        public :
+            explicit SchemaCache (SchemaCatalog * catalog_ = nullptr);
+
+            CompiledSchema & compile (const schema::Envelope &);
+            CompiledSchema & compile (std::string_view);
+
+            size_t size() const;
+            size_t hits() const;
+            size_t misses() const;
+
+            static uint64_t fingerprint (std::string_view);
+
+        private :
+            CompiledSchema * find (uint64_t, std::string_view) const;
+    };
+
+}
+
+/******************************************************************************/
+
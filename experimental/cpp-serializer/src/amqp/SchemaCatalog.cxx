@@ -0,0 +1,499 @@
+#include "SchemaCatalog.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+
+#include "debug.h"
+
+#include "schema/Field.h"
+#include "schema/Composite.h"
+#include "schema/Descriptor.h"
+#include "schema/restricted-types/Enum.h"
+#include "schema/restricted-types/Restricted.h"
+
+/******************************************************************************/
+
+namespace {
+
+    const char MAGIC[8] = { 'c', 'o', 'r', 'd', 'a', 'c', 'a', 't' };
+    const uint32_t VERSION = 2;
+    const size_t HEADER = sizeof (MAGIC) + 2 * sizeof (uint32_t);
+
+    const uint8_t COMPOSITE  = 0;
+    const uint8_t RESTRICTED = 1;
+
+    /**
+     * Append fixed width integers and length prefixed strings to a record
+     */
+    class RecordWriter {
+        private :
+            std::string & m_out;
+
+        public :
+            explicit RecordWriter (std::string & out_) : m_out (out_) { }
+
+            template<typename T>
+            void
+            integer (T val_) {
+                m_out.append (reinterpret_cast<const char *>(&val_), sizeof (T));
+            }
+
+            void
+            str (std::string_view s_) {
+                integer<uint32_t> (s_.size());
+                m_out.append (s_.data(), s_.size());
+            }
+
+            template<class Container>
+            void
+            strs (const Container & c_) {
+                integer<uint32_t> (c_.size());
+                for (const auto & s : c_) str (s);
+            }
+    };
+
+    /**
+     * The mirror of the writer, walking a record in place. Anything that
+     * would take us past the end of the record means the catalog is
+     * corrupt.
+     */
+    class RecordReader {
+        private :
+            const char * m_pos;
+            const char * m_end;
+
+            void
+            check (size_t sz_) const {
+                if (sz_ > static_cast<size_t>(m_end - m_pos)) {
+                    throw std::runtime_error ("Corrupt schema catalog");
+                }
+            }
+
+        public :
+            explicit RecordReader (std::string_view record_)
+                : m_pos (record_.data())
+                , m_end (record_.data() + record_.size())
+            { }
+
+            bool done() const { return m_pos == m_end; }
+
+            template<typename T>
+            T
+            integer() {
+                T val;
+                check (sizeof (T));
+                memcpy (&val, m_pos, sizeof (T));
+                m_pos += sizeof (T);
+                return val;
+            }
+
+            std::string_view
+            bytes (size_t sz_) {
+                check (sz_);
+                std::string_view rtn (m_pos, sz_);
+                m_pos += sz_;
+                return rtn;
+            }
+
+            std::string_view
+            str() {
+                return bytes (integer<uint32_t>());
+            }
+
+            template<class Container>
+            Container
+            strs() {
+                Container rtn;
+                for (auto i = integer<uint32_t>() ; i > 0 ; --i) {
+                    rtn.emplace_back (str());
+                }
+                return rtn;
+            }
+    };
+
+    /******************************************************************************/
+
+    void
+    writeField (RecordWriter & w_, const amqp::internal::schema::Field & field_) {
+        w_.str (field_.name());
+        w_.str (field_.type());
+        w_.strs (field_.requires());
+        w_.str (field_.defaultValue());
+        w_.str (field_.label());
+        w_.integer<uint8_t> (field_.mandatory());
+        w_.integer<uint8_t> (field_.multiple());
+    }
+
+    /******************************************************************************/
+
+    void
+    writeType (RecordWriter & w_, const amqp::internal::schema::AMQPTypeNotation & type_) {
+        using namespace amqp::internal::schema;
+
+        switch (type_.type()) {
+            case AMQPTypeNotation::Composite : {
+                const auto & composite = dynamic_cast<const Composite &>(type_);
+
+                w_.integer<uint8_t> (COMPOSITE);
+                w_.str (composite.name());
+                w_.str (composite.label());
+                w_.str (composite.descriptor());
+                w_.strs (composite.provides());
+
+                w_.integer<uint32_t> (composite.fields().size());
+                for (const auto & field : composite.fields()) {
+                    writeField (w_, *field);
+                }
+                break;
+            }
+            case AMQPTypeNotation::Restricted : {
+                const auto & restricted = dynamic_cast<const Restricted &>(type_);
+
+                std::stringstream source;
+                source << restricted.restrictedType();
+
+                w_.integer<uint8_t> (RESTRICTED);
+                w_.str (restricted.name());
+                w_.str (restricted.label());
+                w_.str (restricted.descriptor());
+                w_.strs (restricted.provides());
+                w_.str (source.str());
+
+                if (restricted.restrictedType() == Restricted::Enum) {
+                    w_.strs (dynamic_cast<const Enum &>(restricted).choices());
+                }
+                break;
+            }
+        }
+    }
+
+    /******************************************************************************/
+
+    uPtr<amqp::internal::schema::AMQPTypeNotation>
+    readType (RecordReader & r_) {
+        using namespace amqp::internal::schema;
+
+        auto kind = r_.integer<uint8_t>();
+        std::string name { r_.str() };
+        std::string label { r_.str() };
+        auto descriptor = std::make_unique<Descriptor> (std::string { r_.str() });
+
+        switch (kind) {
+            case COMPOSITE : {
+                auto provides = r_.strs<std::list<std::string>>();
+
+                std::vector<uPtr<Field>> fields;
+
+                for (auto i = r_.integer<uint32_t>() ; i > 0 ; --i) {
+                    std::string fieldName { r_.str() };
+                    std::string type { r_.str() };
+                    auto requires = r_.strs<std::list<std::string>>();
+                    std::string def { r_.str() };
+                    std::string fieldLabel { r_.str() };
+                    bool mandatory = r_.integer<uint8_t>();
+                    bool multiple = r_.integer<uint8_t>();
+
+                    fields.emplace_back (std::make_unique<Field> (
+                            fieldName, type, requires, def, fieldLabel,
+                            mandatory, multiple));
+                }
+
+                return std::make_unique<Composite> (
+                        name, label, provides, descriptor, fields);
+            }
+            case RESTRICTED : {
+                auto provides = r_.strs<std::vector<std::string>>();
+                std::string source { r_.str() };
+
+                std::vector<std::string> choices;
+                if (source == "enum") {
+                    choices = r_.strs<std::vector<std::string>>();
+                }
+
+                return Restricted::make (descriptor, name, label, provides, source, choices);
+            }
+            default :
+                throw std::runtime_error ("Corrupt schema catalog");
+        }
+    }
+
+    /******************************************************************************/
+
+    /**
+     * The types of a record, r_ having been read up to them
+     */
+    uPtr<amqp::internal::schema::Schema>
+    readSchema (RecordReader & r_) {
+        using namespace amqp::internal::schema;
+
+        OrderedTypeNotations<AMQPTypeNotation> types;
+
+        for (auto i = r_.integer<uint32_t>() ; i > 0 ; --i) {
+            types.insert (readType (r_));
+        }
+
+        return std::make_unique<Schema> (std::move (types));
+    }
+
+    /******************************************************************************/
+
+    bool
+    validHeader (std::string_view file_) {
+        if (file_.size() < HEADER) return false;
+
+        uint32_t version;
+        memcpy (&version, file_.data() + sizeof (MAGIC), sizeof (version));
+
+        return memcmp (file_.data(), MAGIC, sizeof (MAGIC)) == 0
+            && version == VERSION;
+    }
+
+    /******************************************************************************/
+
+    /**
+     * Walk the record headers of a mapped catalog calling f_ with each
+     * record's fingerprint and its body
+     */
+    template<typename F>
+    void
+    forEachRecord (std::string_view file_, F f_) {
+        RecordReader r (file_.substr (HEADER));
+
+        while (!r.done()) {
+            auto record = r.bytes (r.integer<uint32_t>());
+            RecordReader fp (record);
+            f_ (fp.integer<uint64_t>(), record);
+        }
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::SchemaCatalog
+ *
+ ******************************************************************************/
+
+amqp::internal::
+SchemaCatalog::SchemaCatalog (std::string path_)
+    : m_path (std::move (path_))
+{
+    load();
+}
+
+/******************************************************************************/
+
+/**
+ * A missing or unreadable catalog isn't an error, it's just empty. It
+ * will be (re)created when we save.
+ */
+void
+amqp::internal::
+SchemaCatalog::load() {
+    m_index.clear();
+    m_file.reset();
+
+    try {
+        m_file = std::make_unique<codec::MappedFile> (m_path);
+    } catch (const std::runtime_error &) {
+        DBG ("SchemaCatalog - no catalog at " << m_path << std::endl); // NOLINT
+        return;
+    }
+
+    if (!validHeader (m_file->view())) {
+        DBG ("SchemaCatalog - ignoring " << m_path << std::endl); // NOLINT
+        m_file.reset();
+        return;
+    }
+
+    try {
+        forEachRecord (m_file->view(), [this](uint64_t fingerprint_, std::string_view record_) {
+            m_index.emplace (fingerprint_, record_);
+        });
+    } catch (const std::runtime_error &) {
+        DBG ("SchemaCatalog - corrupt catalog " << m_path << std::endl); // NOLINT
+        m_index.clear();
+        m_file.reset();
+    }
+}
+
+/******************************************************************************/
+
+uPtr<amqp::internal::schema::Schema>
+amqp::internal::
+SchemaCatalog::find (uint64_t fingerprint_, std::string_view bytes_) const {
+    auto decode = [&bytes_](std::string_view record_) -> uPtr<schema::Schema> {
+        RecordReader r (record_);
+
+        r.integer<uint64_t>();
+
+        if (r.str() != bytes_) return nullptr;
+
+        return readSchema (r);
+    };
+
+    auto range = m_index.equal_range (fingerprint_);
+
+    for (auto it = range.first ; it != range.second ; ++it) {
+        if (auto schema = decode (it->second)) {
+            return schema;
+        }
+    }
+
+    for (const auto & record : m_pending) {
+        if (RecordReader (record).integer<uint64_t>() == fingerprint_) {
+            if (auto schema = decode (record)) {
+                return schema;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+/******************************************************************************/
+
+/**
+ * Every schema in the catalog, saved or not, in no particular order
+ */
+std::vector<uPtr<amqp::internal::schema::Schema>>
+amqp::internal::
+SchemaCatalog::schemas() const {
+    std::vector<uPtr<schema::Schema>> rtn;
+
+    auto decode = [&rtn](std::string_view record_) {
+        RecordReader r (record_);
+
+        r.integer<uint64_t>();
+        r.str();
+
+        rtn.emplace_back (readSchema (r));
+    };
+
+    for (const auto & record : m_index) decode (record.second);
+    for (const auto & record : m_pending) decode (record);
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+SchemaCatalog::add (
+    uint64_t fingerprint_,
+    std::string_view bytes_,
+    const schema::Schema & schema_
+) {
+    std::string record;
+    RecordWriter w (record);
+
+    w.integer<uint64_t> (fingerprint_);
+    w.str (bytes_);
+
+    uint32_t count { 0 };
+    for (const auto & i : schema_) count += i.size();
+
+    w.integer<uint32_t> (count);
+
+    for (const auto & i : schema_) {
+        for (const auto & j : i) {
+            writeType (w, *j);
+        }
+    }
+
+    m_pending.emplace_back (std::move (record));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+SchemaCatalog::save() {
+    if (m_pending.empty()) return;
+
+    auto lockPath = m_path + ".lock";
+    int lock = ::open (lockPath.c_str(), O_CREAT | O_RDWR, 0644);
+
+    if (lock == -1 || ::flock (lock, LOCK_EX) != 0) {
+        std::stringstream ss;
+        ss << "Cannot lock " << lockPath << ": " << strerror (errno);
+        if (lock != -1) ::close (lock);
+        throw std::runtime_error (ss.str());
+    }
+
+    try {
+        // someone else may have saved since we loaded
+        load();
+
+        std::stringstream tmpPath;
+        tmpPath << m_path << ".tmp." << ::getpid();
+
+        {
+            std::ofstream out (tmpPath.str(), std::ios::out | std::ios::binary | std::ios::trunc);
+
+            out.write (MAGIC, sizeof (MAGIC));
+            out.write (reinterpret_cast<const char *>(&VERSION), sizeof (VERSION));
+            uint32_t reserved { 0 };
+            out.write (reinterpret_cast<const char *>(&reserved), sizeof (reserved));
+
+            if (m_file) {
+                out.write (m_file->data() + HEADER, m_file->size() - HEADER);
+            }
+
+            for (const auto & record : m_pending) {
+                RecordReader r (record);
+                auto fingerprint = r.integer<uint64_t>();
+                auto bytes = r.str();
+
+                bool present { false };
+                auto range = m_index.equal_range (fingerprint);
+                for (auto it = range.first ; it != range.second && !present ; ++it) {
+                    RecordReader existing (it->second);
+                    existing.integer<uint64_t>();
+                    present = existing.str() == bytes;
+                }
+
+                if (present) continue;
+
+                uint32_t sz = record.size();
+                out.write (reinterpret_cast<const char *>(&sz), sizeof (sz));
+                out.write (record.data(), record.size());
+            }
+
+            if (!out) {
+                throw std::runtime_error ("Failed writing " + tmpPath.str());
+            }
+        }
+
+        if (::rename (tmpPath.str().c_str(), m_path.c_str()) != 0) {
+            ::unlink (tmpPath.str().c_str());
+            throw std::runtime_error ("Failed replacing " + m_path);
+        }
+
+        m_pending.clear();
+        load();
+    } catch (...) {
+        ::close (lock);
+        throw;
+    }
+
+    ::close (lock);
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::
+SchemaCatalog::size() const {
+    return m_index.size() + m_pending.size();
+}
+
+/******************************************************************************/
@@ -0,0 +1,102 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+
+#include "types.h"
+
+#include "codec/MappedFile.h"
+#include "amqp/schema/Schema.h"
+
+/******************************************************************************
+ *
+ * class amqp::internal::SchemaCatalog
+ *
+ ******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * A persistent, on disk, catalog of every schema we've decoded, stored
+     * in a compact binary form that can be turned back into a Schema
+     * without going anywhere near proton or the descriptor registry.
+     *
+     * The file is memory mapped when the catalog is opened, only the
+     * record headers are walked to build an index of schema fingerprints,
+     * a record's types are only decoded when it's asked for.
+     *
+     * Several processes may share a catalog. Readers never lock, the file
+     * is only ever replaced whole (write a temporary, rename it over the
+     * top) so an existing mapping is never modified underneath anyone.
+     * Writers serialise on a lock file and merge with whatever is on disk
+     * at the time so nobody's additions are lost.
+     *
+     * Layout, all integers in native byte order. It's a cache, not an
+     * interchange format, a catalog from a different architecture is
+     * simply ignored.
+     *
+     *   header  : magic[8] version:u32 reserved:u32
+     *   record* : length:u32 fingerprint:u64 schema:str types:u32 type*
+     *
+     *   type      : kind:u8 name:str label:str descriptor:str provides:strs
+     *   composite : fields:u32 field*
+     *   field     : name:str type:str requires:strs default:str label:str
+     *               mandatory:u8 multiple:u8
+     *   restricted: source:str, enums followed by choices:strs
+     *
+     *   str       : length:u32 bytes
+     *   strs      : count:u32 str*
+     *
+     * The raw schema section is kept so a lookup is confirmed byte for
+     * byte and not just on its fingerprint.
+     */
+    class SchemaCatalog {
+        private :
+            std::string m_path;
+
+            uPtr<codec::MappedFile> m_file;
+
+            /**
+             * fingerprint to the record, past its length prefix
+             */
+            std::unordered_multimap<uint64_t, std::string_view> m_index;
+
+            /**
+             * Encoded records added since we were opened, not yet saved
+             */
+            std::vector<std::string> m_pending;
+
+        public :
+            explicit SchemaCatalog (std::string);
+
+            SchemaCatalog (const SchemaCatalog &) = delete;
+
+            /**
+             * Returns nullptr if the schema isn't in the catalog
+             */
+            uPtr<schema::Schema> find (uint64_t, std::string_view) const;
+
+            std::vector<uPtr<schema::Schema>> schemas() const;
+
+            void add (uint64_t, std::string_view, const schema::Schema &);
+
+            /**
+             * Merge anything added with the catalog on disk
+             */
+            void save();
+
+            size_t size() const;
+
+        private :
+            void load();
+    };
+
+}
+
+/******************************************************************************/
+
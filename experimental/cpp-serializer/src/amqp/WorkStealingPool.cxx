@@ -0,0 +1,157 @@
+#include "WorkStealingPool.h"
+
+#include <utility>
+#include <algorithm>
+
+/******************************************************************************
+ *
+ * amqp::internal::WorkStealingPool
+ *
+ ******************************************************************************/
+
+amqp::internal::
+WorkStealingPool::WorkStealingPool (size_t workers_)
+    : m_queued (0)
+    , m_outstanding (0)
+    , m_next (0)
+    , m_stop (false)
+{
+    if (workers_ == 0) {
+        workers_ = std::max (std::thread::hardware_concurrency(), 1U);
+    }
+
+    for (size_t i { 0 } ; i < workers_ ; ++i) {
+        m_queues.emplace_back (std::make_unique<Queue>());
+    }
+
+    for (size_t i { 0 } ; i < workers_ ; ++i) {
+        m_threads.emplace_back (&WorkStealingPool::run, this, i);
+    }
+}
+
+/******************************************************************************/
+
+amqp::internal::
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock (m_lock);
+        m_stop = true;
+    }
+
+    m_work.notify_all();
+
+    for (auto & thread : m_threads) {
+        thread.join();
+    }
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::
+WorkStealingPool::size() const {
+    return m_queues.size();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+WorkStealingPool::submit (Task task_) {
+    {
+        std::lock_guard<std::mutex> lock (m_lock);
+        ++m_outstanding;
+    }
+
+    {
+        auto & queue = *m_queues[m_next++ % m_queues.size()];
+        std::lock_guard<std::mutex> lock (queue.lock);
+        queue.tasks.emplace_back (std::move (task_));
+    }
+
+    /*
+     * Taking the lock, even to do nothing, means a worker can't be caught
+     * between checking the count and going to sleep
+     */
+    ++m_queued;
+    { std::lock_guard<std::mutex> lock (m_lock); }
+
+    m_work.notify_one();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+WorkStealingPool::wait() {
+    std::unique_lock<std::mutex> lock (m_lock);
+
+    m_idle.wait (lock, [this]() { return m_outstanding == 0; });
+
+    if (m_error) {
+        std::rethrow_exception (std::exchange (m_error, nullptr));
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Our own deque first, then everyone else's starting with our neighbour so
+ * idle workers don't all descend on the same victim
+ */
+bool
+amqp::internal::
+WorkStealingPool::take (size_t worker_, Task & task_) {
+    for (size_t i { 0 } ; i < m_queues.size() ; ++i) {
+        auto & queue = *m_queues[(worker_ + i) % m_queues.size()];
+        std::lock_guard<std::mutex> lock (queue.lock);
+
+        if (queue.tasks.empty()) continue;
+
+        if (i == 0) {
+            task_ = std::move (queue.tasks.front());
+            queue.tasks.pop_front();
+        } else {
+            task_ = std::move (queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+
+        --m_queued;
+        return true;
+    }
+
+    return false;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::
+WorkStealingPool::run (size_t worker_) {
+    for (;;) {
+        Task task;
+
+        if (take (worker_, task)) {
+            try {
+                task (worker_);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock (m_lock);
+                if (!m_error) m_error = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock (m_lock);
+            if (--m_outstanding == 0) m_idle.notify_all();
+
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock (m_lock);
+
+        m_work.wait (lock, [this]() { return m_stop || m_queued > 0; });
+
+        if (m_stop && m_queued == 0) return;
+    }
+}
+
+/******************************************************************************/
+
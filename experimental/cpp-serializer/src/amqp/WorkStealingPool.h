@@ -0,0 +1,109 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+#include "types.h"
+
+/******************************************************************************
+ *
+ * class amqp::internal::WorkStealingPool
+ *
+ ******************************************************************************/
+
+namespace amqp::internal {
+
+    /**
+     * A fixed set of worker threads, each with its own deque of tasks.
+     * Submitted tasks are dealt out round robin, a worker takes from the
+     * front of its own deque and, once that's empty, steals from the back
+     * of someone else's. A worker that draws a run of large blobs doesn't
+     * leave the rest of its share waiting whilst everyone else sits idle.
+     *
+     * Owners working front to back keeps completion roughly in submission
+     * order, which keeps anything reordering the results small.
+     *
+     * Tasks are handed the index of the worker running them so callers can
+     * keep per worker state without locking it.
+     *
+     * Our tasks are whole blobs, coarse enough that a mutex per deque costs
+     * nothing measurable next to the decoding, there's nothing to be gained
+     * from a lock free deque.
+     *
+     * The first exception to escape a task is rethrown from wait, any
+     * others are dropped.
+     */
+    class WorkStealingPool {
+        public :
+            using Task = std::function<void (size_t)>;
+
+        private :
+            struct Queue {
+                std::mutex       lock;
+                std::deque<Task> tasks;
+            };
+
+            std::vector<uPtr<Queue>> m_queues;
+            std::vector<std::thread> m_threads;
+
+            /**
+             * Tasks sitting in a deque, read without the lock by workers
+             * looking for something to do
+             */
+            std::atomic<size_t> m_queued;
+
+            /**
+             * Guards everything below, and is what idle workers and anyone
+             * waiting for the pool to drain sleep on
+             */
+            std::mutex              m_lock;
+            std::condition_variable m_work;
+            std::condition_variable m_idle;
+
+            /**
+             * Submitted but not yet finished
+             */
+            size_t m_outstanding;
+            size_t m_next;
+            bool   m_stop;
+
+            std::exception_ptr m_error;
+
+        public :
+            /**
+             * Zero means one worker per hardware thread
+             */
+            explicit WorkStealingPool (size_t workers_ = 0);
+            WorkStealingPool (const WorkStealingPool &) = delete;
+
+            /**
+             * Runs anything still queued before returning
+             */
+            ~WorkStealingPool();
+
+            size_t size() const;
+
+            void submit (Task);
+
+            /**
+             * Block until every task submitted so far has run
+             */
+            void wait();
+
+        private :
+            void run (size_t);
+            bool take (size_t, Task &);
+    };
+
+}
+
+/******************************************************************************/
+
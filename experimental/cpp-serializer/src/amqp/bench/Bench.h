@@ -0,0 +1,155 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include <functional>
+
+#include "amqp/reader/IVisitor.h"
+
+/******************************************************************************
+ *
+ * Minimal timing harness for the amqp benchmarks
+ *
+ ******************************************************************************/
+
+namespace amqp::bench {
+
+    /**
+     * Run f_ repeatedly, reporting the best of the runs. f_ returns
+     * something derived from its work so it can't be optimised away.
+     */
+    inline void
+    run (
+        const std::string & name_,
+        int repeats_,
+        const std::function<size_t()> & f_
+    ) {
+        using clock = std::chrono::steady_clock;
+
+        auto best = clock::duration::max();
+        size_t check { 0 };
+
+        for (int i { 0 } ; i < repeats_ ; ++i) {
+            auto start = clock::now();
+            check += f_();
+            best = std::min (best, clock::now() - start);
+        }
+
+        std::cout << name_ << " : "
+            << std::chrono::duration_cast<std::chrono::microseconds> (best).count()
+            << " us (" << check / repeats_ << ")" << std::endl;
+    }
+
+}
+
+/******************************************************************************
+ *
+ * Visitors that cost next to nothing, so what's timed is the decoding
+ *
+ ******************************************************************************/
+
+namespace amqp::bench {
+
+    /**
+     * Ignores everything it's shown, override what's to be kept
+     */
+    class Visitor : public amqp::reader::IVisitor {
+        public :
+            void beginComposite (const std::string &) override { }
+            void endComposite() override { }
+            void beginList() override { }
+            void endList() override { }
+            void field (const std::string &) override { }
+            void value (int32_t) override { }
+            void value (int64_t) override { }
+            void value (double) override { }
+            void value (bool) override { }
+            void value (std::string_view) override { }
+            void null() override { }
+    };
+
+    /**
+     * Counts the values it's shown
+     */
+    class Counter : public Visitor {
+        public :
+            size_t values { 0 };
+
+            void value (int32_t) override { ++values; }
+            void value (int64_t) override { ++values; }
+            void value (double) override { ++values; }
+            void value (bool) override { ++values; }
+            void value (std::string_view) override { ++values; }
+            void null() override { ++values; }
+    };
+
+}
+
+/******************************************************************************
+ *
+ * Just enough of an AMQP encoder to build blobs to time
+ *
+ ******************************************************************************/
+
+namespace amqp::bench {
+
+    inline std::string
+    be32 (uint32_t i_) {
+        return std::string {
+            static_cast<char>(i_ >> 24U), static_cast<char>(i_ >> 16U),
+            static_cast<char>(i_ >> 8U), static_cast<char>(i_) };
+    }
+
+    inline std::string
+    be64 (uint64_t i_) {
+        return be32 (i_ >> 32U) + be32 (i_);
+    }
+
+    inline std::string
+    string (const std::string & s_) {
+        return std::string ("\xa1", 1) + static_cast<char>(s_.size()) + s_;
+    }
+
+    /*
+     * A list32 of already encoded elements
+     */
+    inline std::string
+    list (const std::vector<std::string> & elements_) {
+        std::string body;
+        for (const auto & e : elements_) body += e;
+
+        return std::string ("\xd0", 1) + be32 (body.size() + 4)
+            + be32 (elements_.size()) + body;
+    }
+
+    /*
+     * An array32 of values sharing the constructor code_, each encoded
+     * without it
+     */
+    inline std::string
+    array (char code_, const std::vector<std::string> & values_) {
+        std::string body (1, code_);
+        for (const auto & v : values_) body += v;
+
+        return std::string ("\xf0", 1) + be32 (body.size() + 4)
+            + be32 (values_.size()) + body;
+    }
+
+    /*
+     * Described by a symbol, as Corda's own types are
+     */
+    inline std::string
+    described (const std::string & descriptor_, const std::string & body_) {
+        return std::string ("\0\xa3", 2) + static_cast<char>(descriptor_.size())
+            + descriptor_ + body_;
+    }
+
+}
+
+/******************************************************************************/
+
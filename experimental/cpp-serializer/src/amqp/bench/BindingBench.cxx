@@ -0,0 +1,131 @@
+#include <string>
+#include <vector>
+
+#include "Bench.h"
+
+#include "codec/Cursor.h"
+#include "codec/codec_wrapper.h"
+
+#include "amqp/schema/Schema.h"
+#include "amqp/binding/Decoder.h"
+#include "amqp/reader/PropertyReader.h"
+#include "amqp/reader/CompositeReader.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal::reader;
+
+    struct Settlement {
+        std::string reference;
+        int64_t     quantity;
+        std::string currency;
+        double      rate;
+        bool        settled;
+    };
+
+    std::string
+    settlement (size_t i_) {
+        using namespace amqp::bench;
+
+        return described ("net.corda:settle", list ({
+            string ("SETTLEMENT-" + std::to_string (i_)),
+            std::string ("\x81", 1) + be64 (i_ * 100),
+            string ("GBP"),
+            std::string ("\x82", 1) + be64 (0x3ff0000000000000ULL),
+            std::string ("\x41", 1) }));
+    }
+
+}
+
+/******************************************************************************/
+
+namespace amqp::binding {
+
+    template<>
+    struct Binding<Settlement> {
+        static constexpr std::string_view type { "net.corda.Settlement" };
+
+        static constexpr auto fields = std::make_tuple (
+            field ("reference", &Settlement::reference),
+            field ("quantity", &Settlement::quantity),
+            field ("currency", &Settlement::currency),
+            field ("rate", &Settlement::rate),
+            field ("settled", &Settlement::settled));
+    };
+
+}
+
+/******************************************************************************/
+
+/**
+ * A small state decoded over and over, through the readers as events, as
+ * Variants and straight into a bound struct
+ */
+void
+binding() {
+    const size_t instances { 100000 };
+
+    auto string = PropertyReader::make ("string");
+    auto integer = PropertyReader::make ("long");
+    auto real = PropertyReader::make ("double");
+    auto boolean = PropertyReader::make ("boolean");
+
+    CompositeReader reader ("net.corda.Settlement", "net.corda:settle", {
+        { "reference", string },
+        { "quantity", integer },
+        { "currency", string },
+        { "rate", real },
+        { "settled", boolean } });
+
+    reader.freeze();
+
+    std::string blob;
+    for (size_t i { 0 } ; i < instances ; ++i) blob += settlement (i);
+
+    amqp::internal::schema::Schema schema {
+        amqp::internal::schema::OrderedTypeNotations<
+                amqp::internal::schema::AMQPTypeNotation> { } };
+
+    auto each = [&](const auto & f_) {
+        codec::Cursor cursor (blob.data(), blob.size());
+        cursor.next();
+
+        size_t rtn { 0 };
+        for (size_t i { 0 } ; i < instances ; ++i) {
+            rtn += f_ (&cursor);
+        }
+
+        return rtn;
+    };
+
+    amqp::bench::run ("visit", 20, [&]() {
+        amqp::bench::Counter counter;
+        each ([&](codec::Cursor * c_) {
+            reader.visit (c_, schema, counter);
+            return 0;
+        });
+
+        return counter.values;
+    });
+
+    amqp::bench::run ("read as Variants", 20, [&]() {
+        return each ([&](codec::Cursor * c_) {
+            return reader.read (c_)[1].asLong() > 0;
+        });
+    });
+
+    amqp::internal::binding::Plans plans;
+    const auto & plan = plans.get<Settlement> (reader, "net.corda.Settlement");
+
+    amqp::bench::run ("decode into a bound struct", 20, [&]() {
+        Settlement s;
+        return each ([&](codec::Cursor * c_) {
+            amqp::internal::binding::decode (c_, s, plan);
+            return s.quantity > 0;
+        });
+    });
+}
+
+/******************************************************************************/
@@ -0,0 +1,115 @@
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include "Bench.h"
+
+#include "codec/Bulk.h"
+#include "codec/Cursor.h"
+#include "codec/ByteSwap.h"
+#include "codec/codec_wrapper.h"
+
+#include "amqp/schema/Schema.h"
+#include "amqp/binding/Decoder.h"
+#include "amqp/reader/PropertyReader.h"
+#include "amqp/reader/restricted-readers/ListReader.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal::reader;
+
+    class Summer : public amqp::bench::Visitor {
+        public :
+            size_t sum { 0 };
+
+            using Visitor::value;
+
+            void value (int32_t v_) override { sum += v_; }
+            void value (int64_t v_) override { sum += v_; }
+    };
+
+    /*
+     * A price history, long[p] as the JVM writes it, and the same as a
+     * List<long>
+     */
+    std::string
+    history (size_t prices_, bool array_) {
+        using namespace amqp::bench;
+
+        std::vector<std::string> prices;
+        prices.reserve (prices_);
+
+        for (size_t i { 0 } ; i < prices_ ; ++i) {
+            prices.emplace_back ((array_ ? "" : std::string ("\x81", 1)) + be64 (100000 + i * 7));
+        }
+
+        return described ("net.corda:px:", array_ ? array ('\x81', prices) : list (prices));
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * Hundreds of thousands of longs, as an array and as a list, element by
+ * element and in bulk
+ */
+void
+bulk() {
+    const size_t prices { 250000 };
+
+    std::cout << "byteswap kernel : " << codec::byteswapKernel() << std::endl;
+
+    auto integer = PropertyReader::make ("long");
+    ListReader reader ("long[p]", integer);
+    reader.freeze();
+
+    amqp::internal::schema::Schema schema {
+        amqp::internal::schema::OrderedTypeNotations<
+                amqp::internal::schema::AMQPTypeNotation> { } };
+
+    amqp::internal::binding::Plans plans;
+    auto plan = amqp::internal::binding::Member<std::vector<int64_t>>::plan (
+        reader, plans, "prices");
+
+    for (auto array : { true, false }) {
+        auto blob = history (prices, array);
+        std::string what = array ? "array" : "list";
+
+        amqp::bench::run (what + " element by element", 20, [&]() {
+            codec::Cursor c (blob.data(), blob.size());
+            c.next();
+            codec::auto_enter ae (&c, true);
+            codec::auto_list_enter ale (&c, true);
+
+            size_t sum { 0 };
+            for (size_t i { 0 } ; i < ale.elements() ; ++i) {
+                sum += codec::readAndNext<long> (&c);
+            }
+
+            return sum;
+        });
+
+        amqp::bench::run (what + " visited", 20, [&]() {
+            codec::Cursor c (blob.data(), blob.size());
+            c.next();
+            Summer summer;
+            reader.visit (&c, schema, summer);
+
+            return summer.sum;
+        });
+
+        amqp::bench::run (what + " decoded into a std::vector", 20, [&]() {
+            codec::Cursor c (blob.data(), blob.size());
+            c.next();
+            std::vector<int64_t> out;
+            amqp::internal::binding::Member<std::vector<int64_t>>::decode (&c, out, plan);
+
+            return out.size();
+        });
+    }
+}
+
+/******************************************************************************/
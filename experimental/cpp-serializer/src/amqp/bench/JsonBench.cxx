@@ -0,0 +1,90 @@
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include "Bench.h"
+
+#include "amqp/reader/JsonString.h"
+#include "amqp/reader/JsonWriter.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal::reader;
+
+    /*
+     * What most of the bytes we print are, X.500 names and free text
+     * notes, a few with a quote, a newline or something other than ASCII
+     */
+    std::vector<std::string>
+    strings (size_t count_) {
+        std::vector<std::string> rtn;
+        rtn.reserve (count_);
+
+        for (size_t i { 0 } ; i < count_ ; ++i) {
+            switch (i % 4) {
+                case 0 :
+                    rtn.push_back ("O=Bank " + std::to_string (i) + ", L=London, C=GB");
+                    break;
+                case 1 :
+                    rtn.push_back ("O=Bank " + std::to_string (i) + " AG, L=Z\xc3\xbcrich, C=CH");
+                    break;
+                case 2 :
+                    rtn.push_back ("Settlement of invoice " + std::to_string (i)
+                        + " against the purchase order agreed last quarter, see the"
+                        " attached terms for the delivery schedule and penalties");
+                    break;
+                default :
+                    rtn.push_back ("Note " + std::to_string (i)
+                        + ": \"urgent\"\nplease confirm receipt before the close of business");
+            }
+        }
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * Escaping a few megabytes of names and notes as a JSON writer would
+ */
+void
+escaping() {
+    auto input = strings (50000);
+
+    size_t bytes { 0 };
+    for (const auto & s : input) bytes += s.size();
+
+    std::cout << "escape kernel : " << format::escapeKernel()
+        << ", " << bytes << " bytes" << std::endl;
+
+    amqp::bench::run ("strings scanned", 20, [&]() {
+        size_t plain { 0 };
+        for (const auto & s : input) plain += format::plain (s);
+
+        return plain;
+    });
+
+    amqp::bench::run ("strings escaped", 20, [&]() {
+        std::string out;
+        out.reserve (bytes * 2);
+        for (const auto & s : input) format::quote (s, out);
+
+        return out.size();
+    });
+
+    amqp::bench::run ("strings written", 20, [&]() {
+        JsonWriter json;
+        json.beginList();
+        for (const auto & s : input) json.value (std::string_view (s));
+        json.endList();
+        json.endDocument();
+
+        return json.take().size();
+    });
+}
+
+/******************************************************************************/
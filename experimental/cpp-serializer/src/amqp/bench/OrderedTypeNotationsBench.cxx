@@ -0,0 +1,119 @@
+#include <random>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "Bench.h"
+
+#include "amqp/schema/OrderedTypeNotations.h"
+
+/******************************************************************************/
+
+namespace {
+
+    class Type : public amqp::internal::schema::OrderedTypeNotation {
+        private :
+            std::string m_name;
+            std::vector<std::string> m_fields;
+
+        public :
+            Type (std::string name_, std::vector<std::string> fields_)
+                : m_name (std::move (name_))
+                , m_fields (std::move (fields_))
+            { }
+
+            const std::string & name() const override { return m_name; }
+
+            void dependencies (
+                const std::function<void (const std::string &)> & f_
+            ) const override {
+                for (const auto & field : m_fields) f_ (field);
+            }
+    };
+
+    /*
+     * Something shaped like a schema full of CorDapp states, each type
+     * has a handful of fields, a few primitive, the rest referring to
+     * types from further down the graph. Inserted in a random order,
+     * as they would be when read from a blob.
+     */
+    std::vector<std::pair<std::string, std::vector<std::string>>>
+    schema (size_t types_) {
+        std::mt19937 rng (types_);
+        std::vector<std::pair<std::string, std::vector<std::string>>> rtn;
+
+        for (size_t i { 0 } ; i < types_ ; ++i) {
+            std::vector<std::string> fields { "int", "string" };
+
+            for (int j { 0 } ; i > 0 && j < 4 ; ++j) {
+                fields.emplace_back ("net.corda.Type" + std::to_string (rng() % i));
+            }
+
+            rtn.emplace_back ("net.corda.Type" + std::to_string (i), std::move (fields));
+        }
+
+        std::shuffle (rtn.begin(), rtn.end(), rng);
+
+        return rtn;
+    }
+
+    /*
+     * Make sure nothing comes before something it depends on
+     */
+    void
+    check (const amqp::internal::schema::OrderedTypeNotations<Type> & otn_) {
+        std::unordered_map<std::string, size_t> position;
+
+        for (const auto & level : otn_) {
+            for (const auto & type : level) {
+                position.emplace (type->name(), position.size());
+            }
+        }
+
+        for (const auto & level : otn_) {
+            for (const auto & type : level) {
+                type->dependencies ([&](const std::string & dep_) {
+                    auto it = position.find (dep_);
+                    if (it != position.end() && it->second > position[type->name()]) {
+                        throw std::runtime_error ("Bad ordering of " + type->name());
+                    }
+                });
+            }
+        }
+    }
+
+}
+
+/******************************************************************************/
+
+void
+orderedTypeNotations() {
+    for (size_t types : { 100, 1000, 5000, 20000 }) {
+        auto source = schema (types);
+
+        amqp::bench::run (
+            "OrderedTypeNotations " + std::to_string (types) + " types",
+            5,
+            [&source]() {
+                amqp::internal::schema::OrderedTypeNotations<Type> otn;
+
+                for (const auto & type : source) {
+                    otn.insert (std::make_unique<Type> (type.first, type.second));
+                }
+
+                size_t levels { 0 };
+                for (auto i = otn.begin() ; i != otn.end() ; ++i) ++levels;
+
+                return levels;
+            });
+
+        amqp::internal::schema::OrderedTypeNotations<Type> otn;
+        for (const auto & type : source) {
+            otn.insert (std::make_unique<Type> (type.first, type.second));
+        }
+        check (otn);
+    }
+}
+
+/******************************************************************************/
@@ -0,0 +1,128 @@
+#include <string>
+#include <vector>
+
+#include "Bench.h"
+
+#include "codec/Cursor.h"
+#include "codec/codec_wrapper.h"
+
+#include "amqp/schema/Schema.h"
+#include "amqp/reader/Projection.h"
+#include "amqp/reader/PropertyReader.h"
+#include "amqp/reader/CompositeReader.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace amqp::internal::reader;
+    using namespace amqp::bench;
+
+    /*
+     * Every fourth field is something like a party, a composite of its own
+     */
+    std::string
+    field (size_t i_) {
+        switch (i_ % 4) {
+            case 3 : {
+                std::vector<std::string> nested;
+                for (int j { 0 } ; j < 8 ; ++j) {
+                    nested.emplace_back (string ("nested value " + std::to_string (j)));
+                }
+
+                return described ("net.corda:nested", list (nested));
+            }
+            case 1 : return std::string ("\x71", 1) + be32 (i_);
+            default : return string ("value of field " + std::to_string (i_));
+        }
+    }
+
+}
+
+/******************************************************************************/
+
+/**
+ * A state with 40 fields, strings, ints and nested composites, of which a
+ * report only wants three
+ */
+void
+projection() {
+    const size_t fields { 40 };
+    const size_t instances { 10000 };
+
+    auto integer = PropertyReader::make ("int");
+    auto string = PropertyReader::make ("string");
+
+    std::vector<CompositeReader::Field> nestedFields;
+    for (int j { 0 } ; j < 8 ; ++j) {
+        nestedFields.push_back ({ "n" + std::to_string (j), string });
+    }
+
+    auto nested = std::make_shared<CompositeReader> (
+        "net.corda.Nested", "net.corda:nested", nestedFields);
+    nested->freeze();
+
+    std::vector<CompositeReader::Field> readers;
+    std::vector<std::string> encoded;
+
+    for (size_t i { 0 } ; i < fields ; ++i) {
+        std::shared_ptr<Reader> r;
+
+        switch (i % 4) {
+            case 3 : r = nested; break;
+            case 1 : r = integer; break;
+            default : r = string;
+        }
+
+        readers.push_back ({ "f" + std::to_string (i), r });
+        encoded.emplace_back (field (i));
+    }
+
+    CompositeReader reader ("net.corda.State", "net.corda:state", readers);
+    reader.freeze();
+
+    auto state = described ("net.corda:state", list (encoded));
+    std::string blob;
+    for (size_t i { 0 } ; i < instances ; ++i) blob += state;
+
+    amqp::internal::schema::Schema schema {
+        amqp::internal::schema::OrderedTypeNotations<
+                amqp::internal::schema::AMQPTypeNotation> { } };
+
+    auto each = [&](const auto & f_) {
+        codec::Cursor cursor (blob.data(), blob.size());
+        cursor.next();
+
+        Counter counter;
+        for (size_t i { 0 } ; i < instances ; ++i) {
+            f_ (&cursor, counter);
+        }
+
+        return counter.values;
+    };
+
+    amqp::bench::run ("visit every field", 20, [&]() {
+        return each ([&](codec::Cursor * c_, Counter & v_) {
+            reader.visit (c_, schema, v_);
+        });
+    });
+
+    Projection leading (reader, { "f0", "f1", "f2" });
+
+    amqp::bench::run ("project the first 3 of 40", 20, [&]() {
+        return each ([&](codec::Cursor * c_, Counter & v_) {
+            leading.visit (c_, schema, v_);
+        });
+    });
+
+    Projection scattered (reader, { "f2", "f20", "f37" });
+
+    amqp::bench::run ("project 3 scattered fields of 40", 20, [&]() {
+        return each ([&](codec::Cursor * c_, Counter & v_) {
+            scattered.visit (c_, schema, v_);
+        });
+    });
+}
+
+/******************************************************************************/
+
@@ -0,0 +1,91 @@
+#include <string>
+#include <vector>
+
+#include "Bench.h"
+
+#include "serialiser/Serialiser.h"
+
+/******************************************************************************/
+
+namespace {
+
+    struct Payment {
+        std::string reference;
+        int64_t     quantity;
+        std::string currency;
+        double      rate;
+    };
+
+    struct Batch {
+        int32_t              id;
+        std::vector<Payment> payments;
+    };
+
+}
+
+/******************************************************************************/
+
+namespace amqp::binding {
+
+    template<>
+    struct Binding<Payment> {
+        static constexpr std::string_view type { "net.corda.Payment" };
+
+        static constexpr auto fields = std::make_tuple (
+            field ("reference", &Payment::reference),
+            field ("quantity", &Payment::quantity),
+            field ("currency", &Payment::currency),
+            field ("rate", &Payment::rate));
+    };
+
+    template<>
+    struct Binding<Batch> {
+        static constexpr std::string_view type { "net.corda.Batch" };
+
+        static constexpr auto fields = std::make_tuple (
+            field ("id", &Batch::id),
+            field ("payments", &Batch::payments));
+    };
+
+}
+
+/******************************************************************************/
+
+/**
+ * Whole blobs, schema and all, of a small state and of one holding a
+ * list of them, written into a reused buffer
+ */
+void
+serialise() {
+    const size_t instances { 100000 };
+
+    std::vector<Payment> payments;
+    for (size_t i { 0 } ; i < instances ; ++i) {
+        payments.push_back ({
+            "PAYMENT-" + std::to_string (i), static_cast<int64_t>(i * 100), "GBP", 1.0 });
+    }
+
+    serialiser::Serialiser s;
+
+    amqp::bench::run ("serialise small blobs", 20, [&]() {
+        size_t rtn { 0 };
+        for (const auto & payment : payments) {
+            rtn += s.serialise (payment).size();
+        }
+
+        return rtn;
+    });
+
+    Batch batch { 1, { payments.begin(), payments.begin() + 100 } };
+
+    amqp::bench::run ("serialise blobs of 100", 20, [&]() {
+        size_t rtn { 0 };
+        for (size_t i { 0 } ; i < instances / 100 ; ++i) {
+            rtn += s.serialise (batch).size();
+        }
+
+        return rtn;
+    });
+}
+
+/******************************************************************************/
@@ -0,0 +1,26 @@
+#include <cstdlib>
+
+/******************************************************************************/
+
+void orderedTypeNotations();
+void projection();
+void binding();
+void serialise();
+void bulk();
+void escaping();
+
+/******************************************************************************/
+
+int
+main (int, char **) {
+    orderedTypeNotations();
+    projection();
+    binding();
+    serialise();
+    bulk();
+    escaping();
+
+    return EXIT_SUCCESS;
+}
+
+/******************************************************************************/
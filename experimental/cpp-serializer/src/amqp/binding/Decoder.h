@@ -0,0 +1,810 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <array>
+#include <tuple>
+#include <algorithm>
+#include <mutex>
+#include <limits>
+#include <string>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <optional>
+#include <stdexcept>
+#include <typeindex>
+#include <type_traits>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "types.h"
+
+#include "codec/Bulk.h"
+#include "codec/Cursor.h"
+#include "codec/codec_wrapper.h"
+
+#include "amqp/SchemaCache.h"
+#include "amqp/reader/Binary.h"
+#include "amqp/binding/Binding.h"
+#include "amqp/schema/Envelope.h"
+#include "amqp/schema/Transforms.h"
+#include "amqp/reader/PropertyReader.h"
+#include "amqp/reader/CompositeReader.h"
+#include "amqp/reader/restricted-readers/EnumReader.h"
+#include "amqp/reader/restricted-readers/ListReader.h"
+#include "amqp/descriptors/AMQPDescriptorRegistory.h"
+
+/******************************************************************************
+ *
+ * Forward declarations
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::binding {
+
+    template<typename T>
+    struct Plan;
+
+    class Plans;
+
+    template<typename T>
+    void decode (codec::Cursor *, T &, const Plan<T> &);
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::binding::Member
+ *
+ ******************************************************************************/
+
+/**
+ * How to check a reader can be bound to a member of type M, and then how
+ * to decode into one. What checking finds out that decoding needs to
+ * know is kept as a Plan, nothing for a primitive.
+ */
+namespace amqp::internal::binding {
+
+    struct None { };
+
+    template<typename M>
+    struct is_optional : std::false_type { };
+
+    template<typename M>
+    struct is_optional<std::optional<M>> : std::true_type { };
+
+    template<typename M>
+    struct unbindable : std::false_type { };
+
+    template<typename M, typename = void>
+    struct Member {
+        static_assert (unbindable<M>::value,
+            "Only int32_t, int64_t, double, bool, std::string, bound structs "
+            "and enums, and vectors and optionals of them can be bound");
+    };
+
+    inline std::runtime_error
+    cannotBind (const std::string & what_, const std::string & is_, const std::string & bound_) {
+        return std::runtime_error (
+            "Cannot bind " + what_ + ", it's a " + is_ + " not a " + bound_);
+    }
+
+    /**
+     * Primitives need the property reader for exactly the type bound
+     */
+    template<typename M>
+    struct Primitive {
+        using Plan = None;
+
+        static Plan
+        plan (const reader::Reader & reader_, Plans &, const std::string & what_) {
+            if (!dynamic_cast<const reader::PropertyReader *>(&reader_)
+                || reader_.type() != Member<M>::type
+            ) {
+                throw cannotBind (what_, reader_.type(), Member<M>::type);
+            }
+
+            return { };
+        }
+    };
+
+    template<>
+    struct Member<int32_t> : Primitive<int32_t> {
+        static constexpr const char * type { "int" };
+
+        static void
+        decode (codec::Cursor * data_, int32_t & member_, None) {
+            member_ = codec::readAndNext<int32_t> (data_);
+        }
+    };
+
+    template<>
+    struct Member<int64_t> : Primitive<int64_t> {
+        static constexpr const char * type { "long" };
+
+        static void
+        decode (codec::Cursor * data_, int64_t & member_, None) {
+            member_ = codec::readAndNext<long> (data_);
+        }
+    };
+
+    template<>
+    struct Member<double> : Primitive<double> {
+        static constexpr const char * type { "double" };
+
+        static void
+        decode (codec::Cursor * data_, double & member_, None) {
+            member_ = codec::readAndNext<double> (data_);
+        }
+    };
+
+    template<>
+    struct Member<bool> : Primitive<bool> {
+        static constexpr const char * type { "boolean" };
+
+        static void
+        decode (codec::Cursor * data_, bool & member_, None) {
+            member_ = codec::readAndNext<bool> (data_);
+        }
+    };
+
+    template<>
+    struct Member<std::string> : Primitive<std::string> {
+        static constexpr const char * type { "string" };
+
+        /**
+         * Assigned from a view of the blob so decoding into the same
+         * struct again reuses the string's storage
+         */
+        static void
+        decode (codec::Cursor * data_, std::string & member_, None) {
+            if (codec::auto_resolve ref (data_); ref) {
+                decode (ref.object(), member_, None { });
+                return;
+            }
+
+            member_.assign (codec::readAndNext<std::string_view> (data_));
+        }
+    };
+
+    /**
+     * A view of the blob, nothing is copied, so it's only good for as long
+     * as the blob is
+     */
+    template<>
+    struct Member<amqp::reader::Binary> : Primitive<amqp::reader::Binary> {
+        static constexpr const char * type { "binary" };
+
+        static void
+        decode (codec::Cursor * data_, amqp::reader::Binary & member_, None) {
+            codec::auto_next an (data_);
+            member_.bytes = data_->getBinary();
+        }
+    };
+
+    template<typename E>
+    inline constexpr bool is_bulk_v =
+        std::is_same_v<E, int32_t> || std::is_same_v<E, int64_t> || std::is_same_v<E, double>;
+
+    /**
+     * Walked as ListReader::visit does
+     */
+    template<typename E>
+    struct Member<std::vector<E>> {
+        using Plan = typename Member<E>::Plan;
+
+        static Plan
+        plan (const reader::Reader & reader_, Plans & plans_, const std::string & what_) {
+            auto list = dynamic_cast<const reader::ListReader *>(&reader_);
+
+            if (!list) {
+                throw cannotBind (what_, reader_.type(), "list");
+            }
+
+            if (!list->element()) {
+                throw std::runtime_error ("Reader used before being frozen");
+            }
+
+            return Member<E>::plan (*list->element(), plans_, what_ + "[*]");
+        }
+
+        static void
+        decode (codec::Cursor * data_, std::vector<E> & member_, const Plan & plan_) {
+            if (codec::auto_resolve ref (data_); ref) {
+                decode (ref.object(), member_, plan_);
+                return;
+            }
+
+            codec::auto_next an (data_);
+            codec::is_described (data_);
+
+            codec::auto_enter ae (data_, true);
+
+            /*
+             * Numbers are converted all at once, see codec::readAll,
+             * unless there's a null amongst them
+             */
+            if constexpr (is_bulk_v<E>) {
+                if (codec::readAll (data_, member_)) {
+                    return;
+                }
+            }
+
+            codec::auto_list_enter ale (data_, true);
+
+            member_.clear();
+            member_.reserve (ale.elements());
+
+            for (size_t i { 0 } ; i < ale.elements() ; ++i) {
+                E element { };
+                Member<E>::decode (data_, element, plan_);
+                member_.push_back (std::move (element));
+            }
+        }
+    };
+
+    /**
+     * Empty when the field is null, or the blob's version of the type
+     * doesn't have it, see Plans::field
+     */
+    template<typename M>
+    struct Member<std::optional<M>> {
+        using Plan = typename Member<M>::Plan;
+
+        static Plan
+        plan (const reader::Reader & reader_, Plans & plans_, const std::string & what_) {
+            return Member<M>::plan (reader_, plans_, what_);
+        }
+
+        static void
+        decode (codec::Cursor * data_, std::optional<M> & member_, const Plan & plan_) {
+            if (data_->type() == codec::AMQP_NULL) {
+                member_.reset();
+                data_->next();
+                return;
+            }
+
+            if (!member_) member_.emplace();
+
+            Member<M>::decode (data_, *member_, plan_);
+        }
+    };
+
+    /**
+     * What each of the constants the blob's schema gives the enum, by
+     * ordinal, is bound to, evolved through the blob's transforms where
+     * the binding doesn't list it. Decoding is then just the lookup.
+     */
+    template<typename E>
+    struct EnumPlan {
+        std::string    type;
+        std::vector<E> byOrdinal;
+    };
+
+    template<typename E>
+    struct Member<E, std::enable_if_t<amqp::binding::is_bound_enum_v<E>>> {
+        using Plan = EnumPlan<E>;
+
+        static Plan
+        plan (const reader::Reader &, Plans &, const std::string &);
+
+        static void
+        decode (codec::Cursor * data_, E & member_, const Plan & plan_) {
+            if (codec::auto_resolve ref (data_); ref) {
+                decode (ref.object(), member_, plan_);
+                return;
+            }
+
+            member_ = plan_.byOrdinal[reader::EnumReader::ordinal (
+                data_, plan_.type, plan_.byOrdinal.size())];
+        }
+    };
+
+    template<typename T>
+    struct Member<T, std::enable_if_t<amqp::binding::is_bound_struct_v<T>>> {
+        using Plan = const binding::Plan<T> *;
+
+        static Plan
+        plan (const reader::Reader &, Plans &, const std::string &);
+
+        static void
+        decode (codec::Cursor * data_, T & member_, Plan plan_) {
+            binding::decode (data_, member_, *plan_);
+        }
+    };
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::binding::Plan
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::binding {
+
+    template<typename Fields, typename = std::make_index_sequence<std::tuple_size_v<Fields>>>
+    struct NestedPlans;
+
+    template<typename Fields, size_t... I>
+    struct NestedPlans<Fields, std::index_sequence<I...>> {
+        using type = std::tuple<
+            typename Member<typename std::tuple_element_t<I, Fields>::Type>::Plan...>;
+    };
+
+    /**
+     * Everything about binding T to one schema's version of its type,
+     * worked out once and then used for every instance of it
+     */
+    template<typename T>
+    struct Plan {
+        using Fields = std::decay_t<decltype (amqp::binding::Binding<T>::fields)>;
+
+        static constexpr size_t size { std::tuple_size_v<Fields> };
+
+        using Decode = void (*)(codec::Cursor *, T &, const Plan &);
+
+        /**
+         * The position of an optional member whose field the blob's
+         * version of the type doesn't have
+         */
+        static constexpr size_t absent { std::numeric_limits<size_t>::max() };
+
+        std::string descriptor;
+
+        /**
+         * What the type is read with should a blob's objects need
+         * numbering, see codec::Cursor::root, as fields we skip still are
+         */
+        const reader::CompositeReader * reader { nullptr };
+
+        /**
+         * Where in the encoded list each bound member's field is, the
+         * permutation taking this version of the type to the binding
+         */
+        std::array<size_t, size> position { };
+
+        /**
+         * Whether the members were listed in the same order as the type's
+         * fields, the usual case, letting them be decoded by a single run
+         * of inlined code. Otherwise each field is decoded through a
+         * table, indexed by position, with nulls for those to skip.
+         */
+        bool                ordered { true };
+        std::vector<Decode> byPosition;
+
+        /**
+         * Clears each absent member
+         */
+        std::vector<Decode> missing;
+
+        typename NestedPlans<Fields>::type nested;
+    };
+
+    template<typename T, size_t I>
+    void
+    decodeField (codec::Cursor * data_, T & out_, const Plan<T> & plan_) {
+        const auto & field = std::get<I> (amqp::binding::Binding<T>::fields);
+        using M = typename std::decay_t<decltype (field)>::Type;
+
+        Member<M>::decode (data_, out_.*field.member, std::get<I> (plan_.nested));
+    }
+
+    template<typename T, size_t I>
+    void
+    clearField (codec::Cursor *, T & out_, const Plan<T> &) {
+        (out_.*std::get<I> (amqp::binding::Binding<T>::fields).member).reset();
+    }
+
+    /**
+     * Skips to member I's field and decodes it, at_ being where the
+     * cursor is in the list
+     */
+    template<typename T, size_t I>
+    void
+    decodeAt (codec::Cursor * data_, T & out_, const Plan<T> & plan_, size_t & at_) {
+        if (plan_.position[I] == Plan<T>::absent) return;
+
+        for ( ; at_ < plan_.position[I] ; ++at_) data_->next();
+
+        decodeField<T, I> (data_, out_, plan_);
+        ++at_;
+    }
+
+    template<typename T, size_t... I>
+    void
+    decodeOrdered (
+        codec::Cursor * data_,
+        T & out_,
+        const Plan<T> & plan_,
+        std::index_sequence<I...>
+    ) {
+        size_t at { 0 };
+
+        (decodeAt<T, I> (data_, out_, plan_, at), ...);
+    }
+
+    /**
+     * Walked as CompositeReader::visit does. Anything after the last
+     * field we want is left where it is, leaving the list moves us past it.
+     */
+    template<typename T>
+    void
+    decode (codec::Cursor * data_, T & out_, const Plan<T> & plan_) {
+        plan_.reader->root (data_);
+
+        if (codec::auto_resolve ref (data_); ref) {
+            decode (ref.object(), out_, plan_);
+            return;
+        }
+
+        codec::auto_next an (data_);
+        codec::is_described (data_);
+        codec::auto_enter ae (data_);
+
+        auto descriptor = codec::get_symbol<std::string_view>(data_);
+
+        if (descriptor != plan_.descriptor) {
+            throw std::runtime_error (
+                "Expected an instance of " + std::string (amqp::binding::Binding<T>::type)
+                + " (" + plan_.descriptor + ") but found " + std::string (descriptor));
+        }
+
+        data_->next();
+
+        codec::is_list (data_);
+        codec::auto_enter le (data_);
+
+        if (plan_.ordered) {
+            decodeOrdered (data_, out_, plan_, std::make_index_sequence<Plan<T>::size>());
+        } else {
+            for (auto f : plan_.byPosition) {
+                if (f) {
+                    f (data_, out_, plan_);
+                } else {
+                    data_->next();
+                }
+            }
+        }
+
+        for (auto f : plan_.missing) {
+            f (data_, out_, plan_);
+        }
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::binding::Plans
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::binding {
+
+    /**
+     * The plans for every bound type reached from one root within one
+     * schema. A type reachable from itself finds its own, partly built,
+     * plan rather than building another.
+     */
+    class Plans {
+        private :
+            std::unordered_map<std::type_index, sPtr<void>> m_plans;
+
+            const schema::Transforms & m_transforms;
+
+            static const schema::Transforms &
+            none() {
+                static const schema::Transforms none;
+                return none;
+            }
+
+        public :
+            Plans() : m_transforms (none()) { }
+
+            /**
+             * Given the transforms that came with the schema
+             */
+            explicit Plans (const schema::Transforms & transforms_)
+                : m_transforms (transforms_)
+            { }
+
+            const schema::Transforms &
+            transforms() const {
+                return m_transforms;
+            }
+
+            template<typename T>
+            const Plan<T> &
+            get (const reader::Reader & reader_, const std::string & what_) {
+                using amqp::binding::Binding;
+
+                auto it = m_plans.find (typeid (T));
+
+                if (it != m_plans.end()) {
+                    return *static_cast<const Plan<T> *>(it->second.get());
+                }
+
+                auto composite = dynamic_cast<const reader::CompositeReader *>(&reader_);
+
+                if (!composite || composite->type() != Binding<T>::type) {
+                    throw cannotBind (what_, reader_.type(), std::string (Binding<T>::type));
+                }
+
+                auto plan = std::make_shared<Plan<T>>();
+                m_plans.emplace (typeid (T), plan);
+
+                plan->descriptor = composite->descriptor();
+                plan->reader = composite;
+
+                fill (*composite, *plan, std::make_index_sequence<Plan<T>::size>());
+
+                return *plan;
+            }
+
+        private :
+            template<typename T, size_t... I>
+            void
+            fill (
+                const reader::CompositeReader & composite_,
+                Plan<T> & plan_,
+                std::index_sequence<I...>
+            ) {
+                (field<T, I> (composite_, plan_), ...);
+
+                std::vector<bool> bound (composite_.fields().size(), false);
+                size_t next { 0 };
+
+                for (auto p : plan_.position) {
+                    if (p == Plan<T>::absent) continue;
+
+                    if (bound[p]) {
+                        throw std::runtime_error (
+                            "Field " + composite_.fields()[p].name
+                            + " of " + composite_.type() + " is bound twice");
+                    }
+
+                    bound[p] = true;
+                    plan_.ordered &= p >= next;
+                    next = p + 1;
+                }
+
+                if (!plan_.ordered) {
+                    size_t last { 0 };
+                    for (auto p : plan_.position) {
+                        if (p != Plan<T>::absent) last = std::max (last, p + 1);
+                    }
+
+                    plan_.byPosition.assign (last, nullptr);
+                    ((plan_.position[I] != Plan<T>::absent
+                        ? void (plan_.byPosition[plan_.position[I]] = &decodeField<T, I>)
+                        : void()), ...);
+                }
+
+                (missing<T, I> (plan_), ...);
+            }
+
+            template<typename T, size_t I>
+            static void
+            missing (Plan<T> & plan_) {
+                using M = typename std::tuple_element_t<I, typename Plan<T>::Fields>::Type;
+
+                if constexpr (is_optional<M>::value) {
+                    if (plan_.position[I] == Plan<T>::absent) {
+                        plan_.missing.push_back (&clearField<T, I>);
+                    }
+                }
+            }
+
+            template<typename T, size_t I>
+            void
+            field (const reader::CompositeReader & composite_, Plan<T> & plan_) {
+                const auto & bound = std::get<I> (amqp::binding::Binding<T>::fields);
+                using M = typename std::decay_t<decltype (bound)>::Type;
+
+                const auto & fields = composite_.fields();
+
+                auto it = std::find_if (fields.begin(), fields.end(),
+                    [&bound](const reader::CompositeReader::Field & field_) {
+                        return field_.name == bound.name;
+                    });
+
+                if (it == fields.end()) {
+                    if constexpr (is_optional<M>::value) {
+                        plan_.position[I] = Plan<T>::absent;
+                        return;
+                    } else {
+                        throw std::runtime_error (
+                            composite_.type() + " has no field " + std::string (bound.name));
+                    }
+                }
+
+                if (!it->resolved) {
+                    throw std::runtime_error ("Reader used before being frozen");
+                }
+
+                plan_.position[I] = static_cast<size_t> (it - fields.begin());
+
+                std::get<I> (plan_.nested) = Member<M>::plan (
+                    *it->resolved, *this, composite_.type() + "." + it->name);
+            }
+    };
+
+    template<typename T>
+    typename Member<T, std::enable_if_t<amqp::binding::is_bound_struct_v<T>>>::Plan
+    Member<T, std::enable_if_t<amqp::binding::is_bound_struct_v<T>>>::plan (
+        const reader::Reader & reader_,
+        Plans & plans_,
+        const std::string & what_
+    ) {
+        return &plans_.get<T> (reader_, what_);
+    }
+
+    template<typename E>
+    typename Member<E, std::enable_if_t<amqp::binding::is_bound_enum_v<E>>>::Plan
+    Member<E, std::enable_if_t<amqp::binding::is_bound_enum_v<E>>>::plan (
+        const reader::Reader & reader_,
+        Plans & plans_,
+        const std::string & what_
+    ) {
+        using amqp::binding::Binding;
+
+        auto reader = dynamic_cast<const reader::EnumReader *>(&reader_);
+
+        if (!reader || reader->type() != Binding<E>::type) {
+            throw cannotBind (what_, reader_.type(), std::string (Binding<E>::type));
+        }
+
+        std::vector<std::string_view> local;
+        for (const auto & constant : Binding<E>::constants) {
+            local.push_back (constant.name);
+        }
+
+        Plan plan { reader->type(), { } };
+        plan.byOrdinal.reserve (reader->choices().size());
+
+        for (const auto & choice : reader->choices()) {
+            plan.byOrdinal.push_back (Binding<E>::constants[
+                plans_.transforms().evolve (reader->type(), choice, local)].value);
+        }
+
+        return plan;
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::binding::Decoder
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::binding {
+
+    /**
+     * Decodes blobs straight into a bound struct T, see amqp/binding/Binding.h
+     *
+     * The first time we see a schema its readers are checked against the
+     * binding and the result, a plan or the reason there can't be one,
+     * kept for as long as we are. Every blob after that decodes with no
+     * reader, and so no virtual call, involved, each member's decode being
+     * inlined into its struct's.
+     *
+     * Safe to share between threads, as with SchemaCache lookups only
+     * take a shared lock.
+     */
+    template<typename T>
+    class Decoder {
+        private :
+            struct Entry {
+                uPtr<Plans>     plans;
+                const Plan<T> * plan { nullptr };
+                std::string     error;
+            };
+
+            std::unordered_map<const CompiledSchema *, Entry> m_plans;
+
+            mutable std::shared_mutex m_lock;
+
+        public :
+            const Plan<T> &
+            plan (CompiledSchema & schema_) {
+                {
+                    std::shared_lock<std::shared_mutex> lock (m_lock);
+
+                    auto it = m_plans.find (&schema_);
+                    if (it != m_plans.end()) return check (it->second);
+                }
+
+                std::unique_lock<std::shared_mutex> lock (m_lock);
+
+                auto it = m_plans.find (&schema_);
+                if (it != m_plans.end()) return check (it->second);
+
+                Entry entry;
+
+                try {
+                    std::string type { amqp::binding::Binding<T>::type };
+
+                    auto reader = dynamic_cast<const reader::Reader *> (
+                        schema_.factory().byType (type).get());
+
+                    if (!reader) {
+                        throw std::runtime_error ("Schema has no type " + type);
+                    }
+
+                    entry.plans = std::make_unique<Plans> (schema_.transforms());
+                    entry.plan = &entry.plans->template get<T> (*reader, type);
+                } catch (const std::runtime_error & e) {
+                    entry.plans.reset();
+                    entry.plan = nullptr;
+                    entry.error = e.what();
+                }
+
+                return check (m_plans.emplace (&schema_, std::move (entry)).first->second);
+            }
+
+            /**
+             * Decode the object at the cursor, leaving the cursor after it
+             */
+            void
+            decode (codec::Cursor * data_, CompiledSchema & schema_, T & out_) {
+                binding::decode (data_, out_, plan (schema_));
+            }
+
+            /**
+             * Decode the payload of a DATA_AND_STOP blob, see MappedBlob
+             */
+            T
+            decode (const char * blob_, size_t size_, SchemaCache & cache_) {
+                codec::Cursor d (blob_, size_);
+                d.next();
+
+                uPtr<schema::Envelope> envelope;
+
+                if (d.isDescribed()) {
+                    codec::auto_enter p (&d);
+
+                    auto a = d.getULong();
+
+                    envelope.reset (
+                        dynamic_cast<schema::Envelope *> (
+                            amqp::descriptor (a).build (&d).release()));
+                }
+
+                if (!envelope) {
+                    throw std::runtime_error ("Blob doesn't contain an envelope");
+                }
+
+                auto & compiled = cache_.compile (*envelope);
+                const auto & plan = this->plan (compiled);
+
+                T rtn { };
+
+                // the object is the first element of the envelope's list
+                codec::auto_enter p (&d);
+                d.next();
+                codec::is_list (&d);
+                {
+                    codec::auto_enter p (&d);
+                    binding::decode (&d, rtn, plan);
+                }
+
+                return rtn;
+            }
+
+        private :
+            static const Plan<T> &
+            check (const Entry & entry_) {
+                if (!entry_.plan) {
+                    throw std::runtime_error (entry_.error);
+                }
+
+                return *entry_.plan;
+            }
+    };
+
+}
+
+/******************************************************************************/
@@ -20,7 +20,7 @@ namespace amqp::internal {
 
 /******************************************************************************/
 
-const std::string &
+const char *
 amqp::internal::
 AMQPDescriptor::symbol() const {
     return m_symbol;
@@ -36,7 +36,15 @@ AMQPDescriptor::build (pn_data_t *) const {
 
 /******************************************************************************/
 
-inline void
+std::unique_ptr<amqp::AMQPDescribed>
+amqp::internal::
+AMQPDescriptor::build (codec::Cursor *) const {
+    throw std::runtime_error ("Should never be called");
+}
+
+/******************************************************************************/
+
+void
 amqp::internal::
 AMQPDescriptor::read (
         pn_data_t * data_,
@@ -76,7 +84,7 @@ AMQPDescriptor::read (
                             << pn_data_get_list(data_)
                             << std::endl;
 
-                        AMQPDescriptorRegistory[key]->read (data_, ss_, ai);
+                        amqp::descriptor (key).read (data_, ss_, ai);
                         break;
                     }
                     case PN_SYMBOL : {
@@ -16,6 +16,12 @@
 
 struct pn_data_t;
 
+namespace codec {
+
+    class Cursor;
+
+}
+
 /******************************************************************************
  *
  * amqp::internal::AMQPDescribed
@@ -48,30 +54,42 @@ namespace amqp::internal {
 
 namespace amqp::internal {
 
+    /**
+     * Descriptors are stateless and only ever exist as the constants in
+     * the registry, they're built at compile time and never destroyed
+     * through a base pointer, hence the non virtual, trivial, destructor.
+     */
     class AMQPDescriptor {
         protected :
-            std::string m_symbol;
+            const char * m_symbol;
             int32_t m_val;
 
         public :
-            AMQPDescriptor()
+            constexpr AMQPDescriptor()
                 : m_symbol ("ERROR")
                 , m_val (-1)
             { }
 
-            AMQPDescriptor (std::string symbol_, int val_)
-                : m_symbol (std::move (symbol_))
+            constexpr AMQPDescriptor (const char * symbol_, int val_)
+                : m_symbol (symbol_)
                 , m_val (val_)
             { }
 
-            virtual ~AMQPDescriptor() = default;
+            ~AMQPDescriptor() = default;
 
-            const std::string & symbol() const;
+            const char * symbol() const;
 
             void validateAndNext (pn_data_t *) const;
+            void validateAndNext (codec::Cursor *) const;
 
             virtual std::unique_ptr<AMQPDescribed> build (pn_data_t * data_) const;
 
+            /**
+             * Build directly from the native cursor rather than a proton
+             * tree. Only the top level types we find in a blob need this
+             */
+            virtual std::unique_ptr<AMQPDescribed> build (codec::Cursor * data_) const;
+
             virtual void read (
                 pn_data_t *,
                 std::stringstream &) const;
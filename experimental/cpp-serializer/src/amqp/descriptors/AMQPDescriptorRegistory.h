@@ -2,8 +2,8 @@
 
 /******************************************************************************/
 
-#include <map>
-#include <memory>
+#include <string>
+#include <cstdint>
 
 /******************************************************************************/
 
@@ -21,7 +21,7 @@
  */
 namespace amqp::internal {
 
-    extern const uint64_t DESCRIPTOR_TOP_32BITS;
+    constexpr uint64_t DESCRIPTOR_TOP_32BITS = 0xc562UL << (unsigned int)(32 + 16);
 
 }
 
@@ -29,28 +29,66 @@ namespace amqp::internal {
 
 namespace amqp::internal {
 
-    extern const int ENVELOPE;
-    extern const int SCHEMA;
-    extern const int OBJECT_DESCRIPTOR;
-    extern const int FIELD;
-    extern const int COMPOSITE_TYPE;
-    extern const int RESTRICTED_TYPE;
-    extern const int CHOICE;
-    extern const int REFERENCED_OBJECT;
-    extern const int TRANSFORM_SCHEMA;
-    extern const int TRANSFORM_ELEMENT;
-    extern const int TRANSFORM_ELEMENT_KEY;
+    constexpr int ENVELOPE              =  1;
+    constexpr int SCHEMA                =  2;
+    constexpr int OBJECT_DESCRIPTOR     =  3;
+    constexpr int FIELD                 =  4;
+    constexpr int COMPOSITE_TYPE        =  5;
+    constexpr int RESTRICTED_TYPE       =  6;
+    constexpr int CHOICE                =  7;
+    constexpr int REFERENCED_OBJECT     =  8;
+    constexpr int TRANSFORM_SCHEMA      =  9;
+    constexpr int TRANSFORM_ELEMENT     = 10;
+    constexpr int TRANSFORM_ELEMENT_KEY = 11;
 
 }
 
 /******************************************************************************/
 
 /**
- *
+ * The registry itself, a table of every Corda described type indexed by
+ * its id with the Corda prefix stripped. Entries are compile time
+ * constants so there's nothing to initialise at startup and nothing
+ * that can change underneath concurrent readers.
  */
+namespace amqp::internal {
+
+    constexpr size_t DESCRIPTOR_COUNT = TRANSFORM_ELEMENT_KEY + 1;
+
+    extern const AMQPDescriptor * const AMQPDescriptorRegistory[DESCRIPTOR_COUNT];
+
+}
+
+/******************************************************************************/
+
 namespace amqp {
 
-    extern std::map<uint64_t, std::shared_ptr<internal::AMQPDescriptor>> AMQPDescriptorRegistory;
+    /**
+     * Returns nullptr for anything that isn't one of ours.
+     *
+     * Xor'ing off the prefix leaves a small index for our ids and a huge
+     * one for anything else, so the prefix check and the range check are
+     * the same comparison.
+     */
+    inline const internal::AMQPDescriptor *
+    findDescriptor (uint64_t id_) {
+        auto index = id_ ^ internal::DESCRIPTOR_TOP_32BITS;
+
+        return index < internal::DESCRIPTOR_COUNT
+            ? internal::AMQPDescriptorRegistory[index]
+            : nullptr;
+    }
+
+    /**
+     * As findDescriptor but throws std::runtime_error for an unknown id
+     */
+    const internal::AMQPDescriptor & descriptor (uint64_t);
+
+    /**
+     * The descriptor for a described node whose id we've not yet read,
+     * it reads the id and dispatches to the descriptor for it.
+     */
+    const internal::AMQPDescriptor & describedDescriptor();
 
 }
 
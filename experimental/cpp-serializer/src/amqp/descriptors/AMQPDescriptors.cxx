@@ -11,12 +11,15 @@
 #include "Field.h"
 #include "Schema.h"
 #include "Envelope.h"
+#include "Choice.h"
+#include "Transforms.h"
 #include "Composite.h"
 #include "amqp/schema/restricted-types/Restricted.h"
 #include "amqp/schema/OrderedTypeNotations.h"
 #include "amqp/AMQPDescribed.h"
 
 #include "proton/proton_wrapper.h"
+#include "codec/Cursor.h"
 #include "AMQPDescriptorRegistory.h"
 
 /******************************************************************************
@@ -41,9 +44,30 @@ AMQPDescriptor::validateAndNext (pn_data_t * const data_) const {
     pn_data_next (data_);
 }
 
+/******************************************************************************/
+
+void
+amqp::internal::
+AMQPDescriptor::validateAndNext (codec::Cursor * const data_) const {
+    if (data_->type() != codec::AMQP_ULONG) {
+        throw std::runtime_error ("Bad type for a descriptor");
+    }
+
+    if (   (m_val == -1)
+        || (data_->getULong() != (static_cast<uint32_t>(m_val) | amqp::internal::DESCRIPTOR_TOP_32BITS)))
+    {
+        throw std::runtime_error ("Invalid Type");
+    }
+
+    data_->next();
+}
+
 /******************************************************************************
  *
- * Essentially, an enum.
+ * Essentially, an enum. Or rather one constant of one
+ *
+ *      name : String
+ *      value : String
  *
  ******************************************************************************/
 
@@ -54,7 +78,12 @@ ChoiceDescriptor::build (pn_data_t * data_) const {
 
     DBG ("CHOICE " << data_ << std::endl); // NOLINT
 
-    return uPtr<amqp::AMQPDescribed> (nullptr);
+    proton::auto_enter ae (data_);
+
+    auto name = proton::readAndNext<std::string> (data_);
+    auto value = proton::readAndNext<std::string> (data_);
+
+    return std::make_unique<schema::Choice> (name, value);
 }
 
 /******************************************************************************/
@@ -69,7 +98,16 @@ ReferencedObjectDescriptor::build (pn_data_t * data_) const {
     return uPtr<amqp::AMQPDescribed> (nullptr);
 }
 
-/******************************************************************************/
+/******************************************************************************
+ *
+ * The transforms of every type that has any
+ *
+ *      map : type name -> map : TRANSFORM_ELEMENT_KEY -> list : TRANSFORM_ELEMENT
+ *
+ * The keys group the elements by their kind, something each element
+ * also names itself, so they're skipped.
+ *
+ ******************************************************************************/
 
 uPtr<amqp::AMQPDescribed>
 amqp::internal::
@@ -78,10 +116,46 @@ TransformSchemaDescriptor::build (pn_data_t * data_) const {
 
     DBG ("TRANSFORM SCHEMA " << data_ << std::endl); // NOLINT
 
-    return uPtr<amqp::AMQPDescribed> (nullptr);
+    std::map<std::string, std::vector<schema::Transform>> types;
+
+    proton::is_map (data_);
+    ::pn_data_enter (data_);
+
+    while (pn_data_next (data_)) {
+        auto & transforms = types[proton::readAndNext<std::string> (data_)];
+
+        proton::is_map (data_);
+        ::pn_data_enter (data_);
+
+        while (pn_data_next (data_)) {
+            pn_data_next (data_);
+
+            proton::auto_list_enter ale (data_);
+
+            while (pn_data_next (data_)) {
+                transforms.push_back (
+                    *descriptors::dispatchDescribed<schema::Transform> (data_));
+            }
+        }
+
+        pn_data_exit (data_);
+    }
+
+    pn_data_exit (data_);
+
+    return std::make_unique<schema::Transforms> (std::move (types));
 }
 
-/******************************************************************************/
+/******************************************************************************
+ *
+ * One transform, its kind's name followed by, for those we understand,
+ * the two constant names it relates
+ *
+ *      name : String
+ *      from : String
+ *      to   : String
+ *
+ ******************************************************************************/
 
 uPtr<amqp::AMQPDescribed>
 amqp::internal::
@@ -90,11 +164,28 @@ TransformElementDescriptor::build (pn_data_t * data_) const {
 
     DBG ("TRANSFORM ELEMENT " << data_ << std::endl); // NOLINT
 
-    return uPtr<amqp::AMQPDescribed> (nullptr);
+    proton::auto_list_enter ale (data_, true);
+
+    auto kind = ale.elements() < 3
+        ? schema::Transform::Kind::Unknown
+        : schema::Transform::kind (proton::readAndNext<std::string> (data_));
+
+    if (kind == schema::Transform::Kind::Unknown) {
+        return std::make_unique<schema::Transform> (
+            schema::Transform::Kind::Unknown, "", "");
+    }
+
+    auto from = proton::readAndNext<std::string> (data_);
+    auto to = proton::readAndNext<std::string> (data_);
+
+    return std::make_unique<schema::Transform> (kind, from, to);
 }
 
 /******************************************************************************/
 
+/**
+ * Never dispatched to, see TransformSchemaDescriptor::build
+ */
 uPtr<amqp::AMQPDescribed>
 amqp::internal::
 TransformElementKeyDescriptor::build (pn_data_t * data_) const {
@@ -25,9 +25,8 @@ namespace amqp::internal::descriptors {
 
     /**
      * Look up a described type by its ID in the AMQPDescriptorRegistry and
-     * return the corresponding schema type. Specialised below to avoid
-     * the cast and re-owning of the unigue pointer when we're happy
-     * with a simple uPtr<AMQPDescribed>
+     * return the corresponding schema type. Throws if the ID isn't one
+     * of ours.
      */
     template<class T>
     uPtr <T>
@@ -39,7 +38,7 @@ namespace amqp::internal::descriptors {
         auto id = pn_data_get_ulong(data_);
 
         return uPtr<T>(
-                static_cast<T *>(amqp::AMQPDescriptorRegistory[id]->build(data_).release()));
+                static_cast<T *>(amqp::descriptor (id).build(data_).release()));
     }
 }
 
@@ -49,14 +48,12 @@ namespace amqp::internal {
 
     class ChoiceDescriptor : public AMQPDescriptor {
         public :
-            ChoiceDescriptor() : AMQPDescriptor() { }
+            constexpr ChoiceDescriptor() : AMQPDescriptor() { }
 
-            ChoiceDescriptor(const std::string & symbol_, int val_)
-                : AMQPDescriptor(symbol_, val_)
+            constexpr ChoiceDescriptor (const char * symbol_, int val_)
+                : AMQPDescriptor (symbol_, val_)
             { }
 
-            ~ChoiceDescriptor() final = default;
-
             std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
     };
 
@@ -68,14 +65,12 @@ namespace amqp::internal {
 
     class ReferencedObjectDescriptor : public AMQPDescriptor {
         public :
-            ReferencedObjectDescriptor() : AMQPDescriptor() { }
+            constexpr ReferencedObjectDescriptor() : AMQPDescriptor() { }
 
-            ReferencedObjectDescriptor(const std::string & symbol_, int val_)
-                : AMQPDescriptor(symbol_, val_)
+            constexpr ReferencedObjectDescriptor (const char * symbol_, int val_)
+                : AMQPDescriptor (symbol_, val_)
             { }
 
-            ~ReferencedObjectDescriptor() final = default;
-
             std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
     };
 
@@ -87,14 +82,12 @@ namespace amqp::internal {
 
     class TransformSchemaDescriptor : public AMQPDescriptor {
         public :
-            TransformSchemaDescriptor() : AMQPDescriptor() { }
+            constexpr TransformSchemaDescriptor() : AMQPDescriptor() { }
 
-            TransformSchemaDescriptor(const std::string & symbol_, int val_)
-                : AMQPDescriptor(symbol_, val_)
+            constexpr TransformSchemaDescriptor (const char * symbol_, int val_)
+                : AMQPDescriptor (symbol_, val_)
             { }
 
-            ~TransformSchemaDescriptor() final = default;
-
             std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
     };
 
@@ -106,14 +99,12 @@ namespace amqp::internal {
 
     class TransformElementDescriptor : public AMQPDescriptor {
         public :
-            TransformElementDescriptor() : AMQPDescriptor() { }
+            constexpr TransformElementDescriptor() : AMQPDescriptor() { }
 
-            TransformElementDescriptor(const std::string & symbol_, int val_)
-                : AMQPDescriptor(symbol_, val_)
+            constexpr TransformElementDescriptor (const char * symbol_, int val_)
+                : AMQPDescriptor (symbol_, val_)
             { }
 
-            ~TransformElementDescriptor() final = default;
-
             std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
     };
 
@@ -125,14 +116,12 @@ namespace amqp::internal {
 
     class TransformElementKeyDescriptor : public AMQPDescriptor {
         public :
-            TransformElementKeyDescriptor() : AMQPDescriptor() { }
+            constexpr TransformElementKeyDescriptor() : AMQPDescriptor() { }
 
-            TransformElementKeyDescriptor(const std::string & symbol_, int val_)
-                : AMQPDescriptor(symbol_, val_)
+            constexpr TransformElementKeyDescriptor (const char * symbol_, int val_)
+                : AMQPDescriptor (symbol_, val_)
             { }
 
-            ~TransformElementKeyDescriptor() final = default;
-
             std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
     };
 
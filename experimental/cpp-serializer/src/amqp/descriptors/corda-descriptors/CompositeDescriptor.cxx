@@ -21,16 +21,6 @@
  *
  ******************************************************************************/
 
-amqp::internal::
-CompositeDescriptor::CompositeDescriptor (
-    const std::string & symbol_,
-    int val_
-) : AMQPDescriptor (symbol_, val_) {
-
-}
-
-/******************************************************************************/
-
 uPtr<amqp::AMQPDescribed>
 amqp::internal::
 CompositeDescriptor::build (pn_data_t * data_) const {
@@ -123,7 +113,7 @@ CompositeDescriptor::read (
 
         ss_ << ai << "4] Descriptor:" << std::endl;
 
-        AMQPDescriptorRegistory[pn_data_type(data_)]->read (
+        describedDescriptor().read (
             (pn_data_t *)proton::auto_next(data_), ss_, AutoIndent { ai });
 
         ss_ << ai << "5] List: Fields: " << std::endl;
@@ -136,7 +126,7 @@ CompositeDescriptor::read (
                     << ale.elements() << "]"
                     << std::endl;
 
-                AMQPDescriptorRegistory[pn_data_type(data_)]->read (
+                describedDescriptor().read (
                         data_, ss_, AutoIndent { ai2 });
             }
         }
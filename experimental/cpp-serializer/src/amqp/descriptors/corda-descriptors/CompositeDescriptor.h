@@ -8,10 +8,11 @@ namespace amqp::internal {
 
     class CompositeDescriptor : public AMQPDescriptor {
         public :
-            CompositeDescriptor() : AMQPDescriptor() { }
-            CompositeDescriptor (const std::string &, int);
+            constexpr CompositeDescriptor() : AMQPDescriptor() { }
 
-            ~CompositeDescriptor() final = default;
+            constexpr CompositeDescriptor (const char * symbol_, int val_)
+                : AMQPDescriptor (symbol_, val_)
+            { }
 
             std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
 
@@ -2,12 +2,17 @@
 
 #include "amqp/schema/Schema.h"
 #include "amqp/schema/Envelope.h"
+#include "amqp/schema/Transforms.h"
 #include "proton/proton_wrapper.h"
+#include "codec/codec_wrapper.h"
 
 #include "types.h"
 #include "debug.h"
 
 #include <sstream>
+#include <stdexcept>
+
+#include <proton/codec.h>
 
 /******************************************************************************/
 
@@ -20,6 +25,13 @@ namespace {
         return proton::get_symbol<std::string> (data_);
     }
 
+    const std::string
+    consumeBlob (codec::Cursor * data_) {
+        codec::is_described (data_);
+        codec::auto_enter p (data_);
+        return codec::get_symbol<std::string> (data_);
+    }
+
 }
 
 /******************************************************************************
@@ -47,12 +59,12 @@ EnvelopeDescriptor::read (
         proton::auto_enter p (data_);
 
         ss_ << ai << "1]" << std::endl;
-        AMQPDescriptorRegistory[pn_data_type(data_)]->read (
+        describedDescriptor().read (
                 (pn_data_t *)proton::auto_next (data_), ss_, AutoIndent { ai });
 
 
         ss_ << ai << "2]" << std::endl;
-        AMQPDescriptorRegistory[pn_data_type(data_)]->read (
+        describedDescriptor().read (
                 (pn_data_t *)proton::auto_next(data_), ss_, AutoIndent { ai });
 
     }
@@ -60,21 +72,6 @@ EnvelopeDescriptor::read (
 
 /******************************************************************************/
 
-amqp::internal::
-EnvelopeDescriptor::EnvelopeDescriptor() : AMQPDescriptor() { }
-
-/******************************************************************************/
-
-amqp::internal::
-EnvelopeDescriptor::EnvelopeDescriptor (
-    const std::string & symbol_,
-    int val_
-) : AMQPDescriptor (symbol_, val_) {
-
-}
-
-/******************************************************************************/
-
 uPtr<amqp::AMQPDescribed>
 amqp::internal::
 EnvelopeDescriptor::build (pn_data_t * data_) const {
@@ -99,16 +96,99 @@ EnvelopeDescriptor::build (pn_data_t * data_) const {
      */
     auto schema = descriptors::dispatchDescribed<schema::Schema> (data_);
 
-    pn_data_next(data_);
+    /*
+     * The transforms schema, which blobs from before the JVM tracked
+     * transforms go without
+     */
+    auto transforms = pn_data_next (data_)
+        ? descriptors::dispatchDescribed<schema::Transforms> (data_)
+        : std::make_unique<schema::Transforms>();
+
+    return std::make_unique<schema::Envelope> (
+            schema::Envelope (schema, transforms, outerType));
+}
+
+/******************************************************************************/
+
+
+/**
+ * Build the envelope straight from the native cursor. The schema section
+ * isn't decoded here, the envelope just records where it is so that
+ * the SchemaCache can decide whether it needs decoding at all. That
+ * way we never build a proton tree for the (potentially very large)
+ * payload, or for a schema we've already seen.
+ */
+uPtr<amqp::AMQPDescribed>
+amqp::internal::
+EnvelopeDescriptor::build (codec::Cursor * data_) const {
+    DBG ("ENVELOPE" << std::endl); // NOLINT
+
+    validateAndNext (data_);
+
+    codec::auto_enter p (data_);
+
+    std::string outerType = consumeBlob (data_);
+
+    data_->next();
 
     /*
-     * The transforms schema
+     * The schema and, when there is one, the transforms schema after it,
+     * as one run of bytes since between them they decide how the
+     * payload is read
      */
-    // Skip for now
-    // dispatchDescribed (data_);
+    auto bytes = data_->bytes();
+
+    if (data_->next()) {
+        auto transforms = data_->bytes();
+        bytes = std::string_view (
+                bytes.data(),
+                static_cast<size_t>(transforms.data() + transforms.size() - bytes.data()));
+    }
+
+    return std::make_unique<schema::Envelope> (
+            schema::Envelope (outerType, bytes));
+}
+
+/******************************************************************************/
+
+uPtr<amqp::internal::schema::Schema>
+amqp::internal::
+EnvelopeDescriptor::buildSchema (std::string_view bytes_) {
+    std::unique_ptr<pn_data_t, decltype (&pn_data_free)> data (
+            pn_data (0), &pn_data_free);
+
+    if (pn_data_decode (data.get(), bytes_.data(), bytes_.size()) < 0) {
+        throw std::runtime_error ("Failed to decode the schema section");
+    }
 
-    return std::make_unique<schema::Envelope> (schema::Envelope (schema, outerType));
+    return descriptors::dispatchDescribed<schema::Schema> (data.get());
 }
 
 /******************************************************************************/
 
+uPtr<amqp::internal::schema::Transforms>
+amqp::internal::
+EnvelopeDescriptor::buildTransforms (std::string_view bytes_) {
+    /*
+     * Step over the schema with a cursor rather than decoding it
+     */
+    codec::Cursor cursor (bytes_.data(), bytes_.size());
+    cursor.next();
+
+    if (!cursor.next()) {
+        return std::make_unique<schema::Transforms>();
+    }
+
+    auto transforms = cursor.bytes();
+
+    std::unique_ptr<pn_data_t, decltype (&pn_data_free)> data (
+            pn_data (0), &pn_data_free);
+
+    if (pn_data_decode (data.get(), transforms.data(), transforms.size()) < 0) {
+        throw std::runtime_error ("Failed to decode the transforms schema section");
+    }
+
+    return descriptors::dispatchDescribed<schema::Transforms> (data.get());
+}
+
+/******************************************************************************/
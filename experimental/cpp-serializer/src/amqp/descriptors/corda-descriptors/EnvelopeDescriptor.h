@@ -2,6 +2,7 @@
 
 
 #include <string>
+#include <string_view>
 
 #include "AMQPDescriptors.h"
 
@@ -13,6 +14,13 @@
 
 struct pn_data_t;
 
+namespace amqp::internal::schema {
+
+    class Schema;
+    class Transforms;
+
+}
+
 /******************************************************************************
  *
  * class amqp::internal::EnvelopeDescriptor
@@ -23,12 +31,27 @@ namespace amqp::internal {
 
     class EnvelopeDescriptor : public AMQPDescriptor {
         public :
-            EnvelopeDescriptor();
-            EnvelopeDescriptor (const std::string &, int);
+            constexpr EnvelopeDescriptor() : AMQPDescriptor() { }
 
-            ~EnvelopeDescriptor() final = default;
+            constexpr EnvelopeDescriptor (const char * symbol_, int val_)
+                : AMQPDescriptor (symbol_, val_)
+            { }
 
             std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
+            std::unique_ptr<AMQPDescribed> build (codec::Cursor *) const override;
+
+            /**
+             * Decode a schema section from its raw encoded bytes, anything
+             * after it is ignored
+             */
+            static uPtr<schema::Schema> buildSchema (std::string_view);
+
+            /**
+             * Decode the transforms schema section that follows the
+             * schema section in bytes_, see Envelope::schemaBytes. Blobs
+             * without one have no transforms.
+             */
+            static uPtr<schema::Transforms> buildTransforms (std::string_view bytes_);
 
             void read (
                     pn_data_t *,
@@ -15,21 +15,6 @@
  *
  ******************************************************************************/
 
-amqp::internal::
-FieldDescriptor::FieldDescriptor() : AMQPDescriptor() { }
-
-/******************************************************************************/
-
-amqp::internal::
-FieldDescriptor::FieldDescriptor (
-    const std::string & symbol_,
-    int val_
-) : AMQPDescriptor(symbol_, val_) {
-
-}
-
-/******************************************************************************/
-
 uPtr<amqp::AMQPDescribed>
 amqp::internal::
 FieldDescriptor::build(pn_data_t * data_) const {
@@ -12,10 +12,11 @@ namespace amqp::internal {
 
     class FieldDescriptor : public AMQPDescriptor {
         public :
-            FieldDescriptor();
-            FieldDescriptor (const std::string &, int);
+            constexpr FieldDescriptor() : AMQPDescriptor() { }
 
-            ~FieldDescriptor() final = default;
+            constexpr FieldDescriptor (const char * symbol_, int val_)
+                : AMQPDescriptor (symbol_, val_)
+            { }
 
             std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
 
@@ -14,14 +14,12 @@ namespace amqp::internal {
 
     class ObjectDescriptor : public AMQPDescriptor {
     public :
-        ObjectDescriptor() : AMQPDescriptor() { }
+        constexpr ObjectDescriptor() : AMQPDescriptor() { }
 
-        ObjectDescriptor(const std::string & symbol_, int val_)
-                : AMQPDescriptor(symbol_, val_)
+        constexpr ObjectDescriptor (const char * symbol_, int val_)
+            : AMQPDescriptor (symbol_, val_)
         { }
 
-        ~ObjectDescriptor() final = default;
-
         std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
 
         void read (
@@ -3,14 +3,18 @@
 #include "types.h"
 #include "debug.h"
 
+#include "amqp/schema/Choice.h"
 #include "amqp/schema/restricted-types/Restricted.h"
 #include "amqp/descriptors/AMQPDescriptors.h"
 
+#include <limits>
+#include <algorithm>
 #include <sstream>
+#include <stdexcept>
 
 /******************************************************************************
  *
- * Restricted types represent lists and maps
+ * Restricted types represent lists, maps and enums
  *
  * NOTE: The Corda serialization scheme doesn't support all container classes
  * as it has the requiremnt that iteration order be deterministic for purposes
@@ -49,10 +53,55 @@ RestrictedDescriptor::build (pn_data_t * data_) const {
     auto source = proton::readAndNext<std::string> (data_);
     auto descriptor = descriptors::dispatchDescribed<schema::Descriptor> (data_);
 
-    // SKIP the choices section **FOR NOW**
+    pn_data_next (data_);
+
+    /*
+     * Only enums have choices, placed here by their ordinal so they can
+     * be found by it. Each ordinal from 0 must be used exactly once, n
+     * choices in range with none repeated can't leave a gap.
+     */
+    std::vector<std::string> choices;
+    {
+        proton::auto_list_enter ae2 (data_);
+        std::vector<bool> filled (ae2.elements(), false);
+
+        while (pn_data_next (data_)) {
+            auto choice = descriptors::dispatchDescribed<schema::Choice> (data_);
+
+            size_t used { 0 };
+            unsigned long ordinal { std::numeric_limits<unsigned long>::max() };
+
+            try {
+                ordinal = std::stoul (choice->value(), &used);
+            } catch (const std::logic_error &) {
+            }
+
+            if (used != choice->value().size()
+                || ordinal >= ae2.elements()
+                || filled[ordinal]
+            ) {
+                throw std::runtime_error (
+                    "Choice " + choice->name() + " of " + name
+                    + " has a bad ordinal \"" + choice->value() + "\"");
+            }
+
+            if (ordinal >= choices.size()) {
+                choices.resize (ordinal + 1);
+            }
+
+            choices[ordinal] = choice->name();
+            filled[ordinal] = true;
+        }
+
+        if (auto gap = std::find (filled.begin(), filled.end(), false); gap != filled.end()) {
+            throw std::runtime_error (
+                name + " has a bad ordinal, no choice has "
+                + std::to_string (gap - filled.begin()));
+        }
+    }
 
     return schema::Restricted::make (descriptor, name,
-                                     label, provides, source);
+                                     label, provides, source, choices);
 }
 
 /******************************************************************************/
@@ -91,7 +140,7 @@ RestrictedDescriptor::read (
 
     ss_ << ai << "5] Descriptor:" << std::endl;
 
-    AMQPDescriptorRegistory[pn_data_type(data_)]->read (
+    describedDescriptor().read (
             (pn_data_t *)proton::auto_next(data_), ss_, AutoIndent { ai });
 }
 
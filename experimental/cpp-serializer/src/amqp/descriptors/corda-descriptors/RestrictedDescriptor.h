@@ -12,14 +12,12 @@ namespace amqp::internal {
 
     class RestrictedDescriptor : public AMQPDescriptor {
     public :
-        RestrictedDescriptor() : AMQPDescriptor() { }
+        constexpr RestrictedDescriptor() : AMQPDescriptor() { }
 
-        RestrictedDescriptor(const std::string & symbol_, int val_)
-                : AMQPDescriptor(symbol_, val_)
+        constexpr RestrictedDescriptor (const char * symbol_, int val_)
+            : AMQPDescriptor (symbol_, val_)
         { }
 
-        ~RestrictedDescriptor() final = default;
-
         std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
 
         void read (
@@ -16,15 +16,6 @@
 
 /******************************************************************************/
 
-amqp::internal::
-SchemaDescriptor::SchemaDescriptor (
-    const std::string & symbol_,
-    int val_
-) : AMQPDescriptor(symbol_, val_) {
-}
-
-/******************************************************************************/
-
 uPtr<amqp::AMQPDescribed>
 amqp::internal::
 SchemaDescriptor::build (pn_data_t * data_) const {
@@ -82,7 +73,7 @@ SchemaDescriptor::read (
                 ss_ << ai2 << i << ":" << j << "/" << ale2.elements()
                         << "] " << std::endl;
 
-                AMQPDescriptorRegistory[pn_data_type(data_)]->read (
+                describedDescriptor().read (
                         data_, ss_,
                         AutoIndent { ai2 });
             }
@@ -12,9 +12,11 @@ namespace amqp::internal {
 
     class SchemaDescriptor : public AMQPDescriptor {
     public :
-        SchemaDescriptor() = default;
-        SchemaDescriptor (const std::string &, int);
-        ~SchemaDescriptor() final = default;
+        constexpr SchemaDescriptor() : AMQPDescriptor() { }
+
+        constexpr SchemaDescriptor (const char * symbol_, int val_)
+            : AMQPDescriptor (symbol_, val_)
+        { }
 
         std::unique_ptr<AMQPDescribed> build (pn_data_t *) const override;
 
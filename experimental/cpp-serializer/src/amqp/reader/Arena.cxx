@@ -0,0 +1,84 @@
+#include "Arena.h"
+
+#include <cstdint>
+#include <cstring>
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::Arena
+ *
+ ******************************************************************************/
+
+amqp::internal::reader::
+Arena::Arena (size_t initialSize_)
+    : m_used (0)
+    , m_initialSize (initialSize_ ? initialSize_ : 1)
+{ }
+
+/******************************************************************************/
+
+void *
+amqp::internal::reader::
+Arena::allocate (size_t sz_, size_t align_) {
+    if (!m_blocks.empty()) {
+        auto & block = m_blocks.back();
+        auto base = reinterpret_cast<uintptr_t> (block.data.get());
+        auto offset = ((base + m_used + align_ - 1) & ~(align_ - 1)) - base;
+
+        if (offset + sz_ <= block.size) {
+            m_used = offset + sz_;
+            return block.data.get() + offset;
+        }
+    }
+
+    /*
+     * new[] gives us memory aligned for anything so the start of a fresh
+     * block never needs padding
+     */
+    size_t size = m_blocks.empty() ? m_initialSize : m_blocks.back().size * 2;
+    if (size < sz_) size = sz_;
+
+    m_blocks.push_back (Block { std::unique_ptr<char[]> (new char[size]), size });
+    m_used = sz_;
+
+    return m_blocks.back().data.get();
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::reader::
+Arena::copy (std::string_view s_) {
+    if (s_.empty()) return { };
+
+    auto * p = array<char> (s_.size());
+    memcpy (p, s_.data(), s_.size());
+
+    return { p, s_.size() };
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Arena::reset() {
+    if (m_blocks.size() > 1) {
+        auto last = std::move (m_blocks.back());
+        m_blocks.clear();
+        m_blocks.push_back (std::move (last));
+    }
+
+    m_used = 0;
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::reader::
+Arena::capacity() const {
+    size_t rtn { 0 };
+    for (const auto & block : m_blocks) rtn += block.size;
+    return rtn;
+}
+
+/******************************************************************************/
@@ -0,0 +1,80 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <new>
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <utility>
+#include <string_view>
+
+/******************************************************************************
+ *
+ * class amqp::internal::reader::Arena
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * A bump allocator for trees of values. Memory is handed out from
+     * a chain of blocks, each twice the size of the last, and is never
+     * freed individually, the whole lot goes in one go when the arena is
+     * reset or destroyed.
+     *
+     * Objects made in an arena never have their destructors run so must
+     * not own anything that lives outside of it.
+     *
+     * Reset keeps the largest block so an arena reused across decodes
+     * of similarly sized blobs settles down to not allocating at all.
+     */
+    class Arena {
+        private :
+            struct Block {
+                std::unique_ptr<char[]> data;
+                size_t                  size;
+            };
+
+            std::vector<Block> m_blocks;
+
+            /**
+             * Bytes handed out from the last block
+             */
+            size_t m_used;
+
+            size_t m_initialSize;
+
+        public :
+            explicit Arena (size_t initialSize_ = 16 * 1024);
+            Arena (const Arena &) = delete;
+
+            void * allocate (size_t, size_t);
+
+            template<typename T, typename ... Args>
+            T *
+            make (Args && ... args_) {
+                return new (allocate (sizeof (T), alignof (T)))
+                    T (std::forward<Args> (args_) ...);
+            }
+
+            /**
+             * Returns an array of sz_ uninitialised T's
+             */
+            template<typename T>
+            T *
+            array (size_t sz_) {
+                return static_cast<T *> (allocate (sizeof (T) * sz_, alignof (T)));
+            }
+
+            std::string_view copy (std::string_view);
+
+            void reset();
+
+            size_t capacity() const;
+    };
+
+}
+
+/******************************************************************************/
+
@@ -4,12 +4,13 @@
 #include <iostream>
 #include <assert.h>
 
-#include <proton/codec.h>
 #include <sstream>
+#include <stdexcept>
 #include "debug.h"
 #include "Reader.h"
+#include "PropertyReader.h"
 #include "amqp/reader/IReader.h"
-#include "proton/proton_wrapper.h"
+#include "codec/codec_wrapper.h"
 
 /******************************************************************************/
 
@@ -27,15 +28,17 @@ CompositeReader::m_name { // NOLINT
 amqp::internal::reader::
 CompositeReader::CompositeReader (
         std::string type_,
-        sVec<std::weak_ptr<Reader>> & readers_
-) : m_readers (readers_)
+        std::string descriptor_,
+        sVec<Field> fields_
+) : m_fields (std::move (fields_))
   , m_type (std::move (type_))
+  , m_descriptor (std::move (descriptor_))
 {
-    DBG ("MAKE CompositeReader: " << m_type << ": " << m_readers.size() << std::endl); // NOLINT
-    for (auto const reader : m_readers) {
-        assert (reader.lock());
-        if (auto r = reader.lock()) {
-            DBG ("  prop: " << r->name() << " " << r->type() << std::endl); // NOLINT
+    DBG ("MAKE CompositeReader: " << m_type << ": " << m_fields.size() << std::endl); // NOLINT
+    for (auto const & field : m_fields) {
+        assert (field.reader.lock());
+        if (auto r = field.reader.lock()) {
+            DBG ("  prop: " << field.name << " " << r->type() << std::endl); // NOLINT
         }
     }
 }
@@ -58,94 +61,162 @@ CompositeReader::type() const  {
 
 /******************************************************************************/
 
-std::any
+const std::string &
 amqp::internal::reader::
-CompositeReader::read (pn_data_t * data_) const {
-    return std::any(1);
+CompositeReader::descriptor() const  {
+    return m_descriptor;
 }
 
 /******************************************************************************/
 
-std::string
+const std::vector<amqp::internal::reader::CompositeReader::Field> &
 amqp::internal::reader::
-CompositeReader::readString (pn_data_t * data_) const {
-    pn_data_next (data_);
-    proton::auto_enter ae (data_);
-
-    return "Composite";
+CompositeReader::fields() const {
+    return m_fields;
 }
 
 /******************************************************************************/
 
-
-sVec<uPtr<amqp::reader::IValue>>
+/**
+ * Walks the blob exactly as visit does, see below, but collecting the
+ * fields rather than reporting them
+ */
+amqp::reader::Variant
 amqp::internal::reader::
-CompositeReader::_dump (
-        pn_data_t * data_,
-        const SchemaType & schema_
-) const {
-    DBG ("Read Composite: " << m_name << " : " << type() << std::endl); // NOLINT
-    proton::is_described (data_);
-    proton::auto_enter ae (data_);
+CompositeReader::read (codec::Cursor * data_) const {
+    root (data_);
+
+    if (codec::auto_resolve ref (data_); ref) {
+        return read (ref.object());
+    }
 
-    const auto & it = schema_.fromDescriptor (proton::get_symbol<std::string>(data_));
-    auto & fields = dynamic_cast<schema::Composite &>(*(it->second.get())).fields();
+    codec::auto_next an (data_);
+    codec::is_described (data_);
+    codec::auto_enter ae (data_);
 
-    assert (fields.size() == m_readers.size());
+    check (codec::get_symbol<std::string_view>(data_));
 
-    pn_data_next (data_);
+    data_->next();
 
-    sVec<uPtr<amqp::reader::IValue>> read;
-    read.reserve (fields.size());
+    codec::is_list (data_);
 
-    proton::is_list (data_);
+    amqp::reader::Record record;
+    record.fields.reserve (m_fields.size());
     {
-        proton::auto_enter ae (data_);
-
-        for (int i (0) ; i < m_readers.size() ; ++i) {
-            if (auto l =  m_readers[i].lock()) {
-                DBG (fields[i]->name() << " " << (l ? "true" : "false") << std::endl); // NOLINT
+        codec::auto_enter ae (data_);
 
-                read.emplace_back(l->dump(fields[i]->name(), data_, schema_));
-            } else {
-                std::stringstream s;
-                s << "null field reader: " << fields[i]->name();
-                throw std::runtime_error(s.str());
+        for (const auto & field : m_fields) {
+            if (!field.resolved) {
+                throw std::runtime_error ("Reader used before being frozen");
             }
+
+            codec::auto_number n (data_, field.numbered);
+            record.fields.emplace_back (field.resolved->read (data_));
         }
     }
 
-    return read;
+    return amqp::reader::Variant (std::move (record));
 }
 
 /******************************************************************************/
 
-uPtr<amqp::reader::IValue>
+std::string
 amqp::internal::reader::
-CompositeReader::dump (
-    const std::string & name_,
-    pn_data_t * data_,
-    const SchemaType & schema_) const
-{
-    return std::make_unique<TypedPair<sVec<uPtr<amqp::reader::IValue>>>> (
-        name_,
-        _dump(data_, schema_));
+CompositeReader::readString (codec::Cursor * data_) const {
+    data_->next();
+    codec::auto_enter ae (data_);
+
+    return "Composite";
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+CompositeReader::freeze() {
+    for (auto & field : m_fields) {
+        if (auto l = field.reader.lock()) {
+            field.resolved = l.get();
+            field.numbered = !dynamic_cast<const PropertyReader *>(field.resolved);
+        } else {
+            std::stringstream s;
+            s << "null field reader: " << field.name;
+            throw std::runtime_error (s.str());
+        }
+    }
 }
 
 /******************************************************************************/
 
 /**
- *
+ * A full compare, not of an id resolved once, as there is nothing to
+ * resolve against. Every instance carries its descriptor as a symbol
+ * inline, at a different place in the blob each time, so interning it
+ * would mean hashing, reading every byte of it, just to then compare an
+ * integer. As it is the lengths are compared first and, when they match,
+ * a single memcmp of some forty bytes straight out of the blob.
  */
-uPtr<amqp::reader::IValue>
+void
 amqp::internal::reader::
-CompositeReader::dump (
-    pn_data_t * data_,
-    const SchemaType & schema_) const
-{
-    return std::make_unique<TypedSingle<sVec<uPtr<amqp::reader::IValue>>>> (
-        _dump (data_, schema_));
+CompositeReader::check (std::string_view descriptor_) const {
+    if (descriptor_ != m_descriptor) {
+        std::stringstream s;
+        s << "Expected an instance of " << m_type << " (" << m_descriptor
+          << ") but found " << descriptor_;
+        throw std::runtime_error (s.str());
+    }
 }
 
 /******************************************************************************/
 
+/**
+ * Everything about the layout of the type was resolved when we were built
+ * so all we need from the stream is confirmation that what's in front of
+ * us is what we expect. That's a comparison against a view straight into
+ * the blob, no lookup and no allocation.
+ */
+void
+amqp::internal::reader::
+CompositeReader::visit (
+        codec::Cursor * data_,
+        const SchemaType & schema_,
+        amqp::reader::IVisitor & visitor_
+) const {
+    DBG ("Read Composite: " << m_name << " : " << type() << std::endl); // NOLINT
+    root (data_);
+
+    if (codec::auto_resolve ref (data_); ref) {
+        if (!visitor_.reference (ref.index())) {
+            visit (ref.object(), schema_, visitor_);
+        }
+
+        return;
+    }
+
+    codec::auto_next an (data_);
+    codec::is_described (data_);
+    codec::auto_enter ae (data_);
+
+    check (codec::get_symbol<std::string_view>(data_));
+
+    data_->next();
+
+    codec::is_list (data_);
+
+    visitor_.beginComposite (m_type);
+    {
+        codec::auto_enter ae (data_);
+
+        for (const auto & field : m_fields) {
+            if (!field.resolved) {
+                throw std::runtime_error ("Reader used before being frozen");
+            }
+
+            visitor_.field (field.name);
+            field.resolved->visit (data_, schema_, visitor_);
+        }
+    }
+    visitor_.endComposite();
+}
+
+/******************************************************************************/
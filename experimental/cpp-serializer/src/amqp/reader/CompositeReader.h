@@ -4,7 +4,6 @@
 
 #include "Reader.h"
 
-#include <any>
 #include <vector>
 #include <iostream>
 #include <amqp/schema/Schema.h>
@@ -14,41 +13,73 @@
 namespace amqp::internal::reader {
 
     class CompositeReader : public Reader {
+        public :
+            /**
+             * Everything we need to read one property of the composite,
+             * resolved once when the factory builds us rather than for
+             * every instance we read
+             */
+            struct Field {
+                std::string           name;
+                std::weak_ptr<Reader> reader;
+
+                /**
+                 * set when we're frozen
+                 */
+                const Reader *        resolved { nullptr };
+
+                /**
+                 * Whether the JVM wrote it with writeObject, so may have
+                 * numbered it, see codec::References. Not if its declared
+                 * type is a primitive, String included, which are put in
+                 * place.
+                 */
+                bool                  numbered { false };
+            };
+
         private :
-            std::vector<std::weak_ptr<Reader>> m_readers;
+            std::vector<Field> m_fields;
 
             static const std::string m_name;
 
             std::string m_type;
 
+            /**
+             * The symbol every instance of this type will be described by
+             */
+            std::string m_descriptor;
+
+            /**
+             * Throws if the descriptor read isn't ours
+             */
+            void check (std::string_view) const;
+
         public :
             CompositeReader (
                 std::string type_,
-                std::vector<std::weak_ptr<Reader>> & readers_
+                std::string descriptor_,
+                std::vector<Field> fields_
             );
 
             ~CompositeReader() override = default;
 
-            std::any read (pn_data_t *) const override;
+            amqp::reader::Variant read (codec::Cursor *) const override;
 
-            std::string readString (pn_data_t *) const override;
+            std::string readString (codec::Cursor *) const override;
 
-            std::unique_ptr<amqp::reader::IValue> dump(
-                const std::string &,
-                pn_data_t *,
-                const SchemaType &) const override;
-
-            std::unique_ptr<amqp::reader::IValue> dump(
-                pn_data_t *,
-                const SchemaType &) const override;
+            void visit (
+                codec::Cursor *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
 
             const std::string & name() const override;
             const std::string & type() const override;
 
-        private :
-            std::vector<std::unique_ptr<amqp::reader::IValue>> _dump (
-                pn_data_t * data_,
-                const SchemaType & schema_) const;
+            const std::string & descriptor() const;
+
+            const std::vector<Field> & fields() const;
+
+            void freeze() override;
     };
 
 }
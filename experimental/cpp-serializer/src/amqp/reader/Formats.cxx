@@ -0,0 +1,134 @@
+#include "Formats.h"
+
+#include <cstdio>
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::format::
+base64 (std::string_view bytes_) {
+    static const char alphabet[] {
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/" };
+
+    auto byte = [&bytes_](size_t i_) -> uint32_t {
+        return static_cast<uint8_t>(bytes_[i_]);
+    };
+
+    std::string rtn;
+    rtn.reserve ((bytes_.size() + 2) / 3 * 4);
+
+    size_t i { 0 };
+
+    for ( ; i + 3 <= bytes_.size() ; i += 3) {
+        auto n = byte (i) << 16U | byte (i + 1) << 8U | byte (i + 2);
+
+        rtn += alphabet[n >> 18U & 0x3fU];
+        rtn += alphabet[n >> 12U & 0x3fU];
+        rtn += alphabet[n >> 6U & 0x3fU];
+        rtn += alphabet[n & 0x3fU];
+    }
+
+    if (i < bytes_.size()) {
+        auto n = byte (i) << 16U;
+        if (i + 1 < bytes_.size()) n |= byte (i + 1) << 8U;
+
+        rtn += alphabet[n >> 18U & 0x3fU];
+        rtn += alphabet[n >> 12U & 0x3fU];
+        rtn += i + 1 < bytes_.size() ? alphabet[n >> 6U & 0x3fU] : '=';
+        rtn += '=';
+    }
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+/**
+ * Worked out directly rather than with gmtime so negative, pre 1970,
+ * values work everywhere and nothing depends on the C library's locking
+ */
+std::string
+amqp::internal::reader::format::
+timestamp (int64_t millis_) {
+    auto floorDiv = [](int64_t a_, int64_t b_) {
+        return a_ / b_ - (a_ % b_ < 0 ? 1 : 0);
+    };
+
+    int64_t days = floorDiv (millis_, 86400000);
+    int64_t rest = millis_ - days * 86400000;
+
+    /*
+     * Days since the epoch to a civil date, see
+     * http://howardhinnant.github.io/date_algorithms.html
+     */
+    days += 719468;
+    int64_t era = floorDiv (days, 146097);
+    int64_t doe = days - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+    int64_t day = doy - (153 * mp + 2) / 5 + 1;
+    int64_t month = mp < 10 ? mp + 3 : mp - 9;
+    int64_t year = yoe + era * 400 + (month <= 2 ? 1 : 0);
+
+    char buf[40];
+    auto sz = snprintf (buf, sizeof (buf), "%04lld-%02lld-%02lldT%02lld:%02lld:%02lld.%03lldZ",
+        static_cast<long long>(year), static_cast<long long>(month),
+        static_cast<long long>(day), static_cast<long long>(rest / 3600000),
+        static_cast<long long>(rest / 60000 % 60), static_cast<long long>(rest / 1000 % 60),
+        static_cast<long long>(rest % 1000));
+
+    return std::string (buf, sz);
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::reader::format::
+uuid (std::string_view bytes_, char (&out_)[36]) {
+    static const char hex[] { "0123456789abcdef" };
+
+    size_t at { 0 };
+
+    for (size_t i { 0 } ; i < 16 && i < bytes_.size() ; ++i) {
+        if (i == 4 || i == 6 || i == 8 || i == 10) out_[at++] = '-';
+
+        auto b = static_cast<uint8_t>(bytes_[i]);
+        out_[at++] = hex[b >> 4U];
+        out_[at++] = hex[b & 0xfU];
+    }
+
+    return std::string_view (out_, at);
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::reader::format::
+utf8 (uint32_t c_, char (&out_)[4]) {
+    if (c_ < 0x80) {
+        out_[0] = static_cast<char>(c_);
+        return std::string_view (out_, 1);
+    }
+
+    if (c_ < 0x800) {
+        out_[0] = static_cast<char>(0xc0U | c_ >> 6U);
+        out_[1] = static_cast<char>(0x80U | (c_ & 0x3fU));
+        return std::string_view (out_, 2);
+    }
+
+    if (c_ < 0x10000) {
+        out_[0] = static_cast<char>(0xe0U | c_ >> 12U);
+        out_[1] = static_cast<char>(0x80U | (c_ >> 6U & 0x3fU));
+        out_[2] = static_cast<char>(0x80U | (c_ & 0x3fU));
+        return std::string_view (out_, 3);
+    }
+
+    out_[0] = static_cast<char>(0xf0U | (c_ >> 18U & 0x07U));
+    out_[1] = static_cast<char>(0x80U | (c_ >> 12U & 0x3fU));
+    out_[2] = static_cast<char>(0x80U | (c_ >> 6U & 0x3fU));
+    out_[3] = static_cast<char>(0x80U | (c_ & 0x3fU));
+    return std::string_view (out_, 4);
+}
+
+/******************************************************************************/
@@ -0,0 +1,40 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <cstdint>
+#include <string_view>
+
+/******************************************************************************
+ *
+ * Text forms of the values that don't have an obvious one, shared by
+ * the readers and the visitors that print what they're shown
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::reader::format {
+
+    /**
+     * Standard, padded, base64, how the JVM prints a byte array
+     */
+    std::string base64 (std::string_view);
+
+    /**
+     * ISO 8601, in UTC to the millisecond, 2019-01-31T12:00:00.000Z
+     */
+    std::string timestamp (int64_t millis_);
+
+    /**
+     * The usual 8-4-4-4-12 hex digits of a 16 byte uuid, written to out_
+     */
+    std::string_view uuid (std::string_view, char (&out_)[36]);
+
+    /**
+     * A char, a UTF-32 code point, as UTF-8, written to out_
+     */
+    std::string_view utf8 (uint32_t, char (&out_)[4]);
+
+}
+
+/******************************************************************************/
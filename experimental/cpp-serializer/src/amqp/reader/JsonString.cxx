@@ -0,0 +1,235 @@
+#include "JsonString.h"
+
+#if (defined (__x86_64__) || defined (__i386__)) && (defined (__GNUC__) || defined (__clang__))
+#define AMQP_JSON_X86
+#include <immintrin.h>
+#endif
+
+/******************************************************************************/
+
+namespace {
+
+    inline bool
+    special (uint8_t c_) {
+        return c_ < 0x20 || c_ >= 0x80 || c_ == '"' || c_ == '\\';
+    }
+
+    size_t
+    scalar (const uint8_t * s_, size_t n_) {
+        size_t i { 0 };
+        while (i < n_ && !special (s_[i])) ++i;
+
+        return i;
+    }
+
+#ifdef AMQP_JSON_X86
+
+    /*
+     * Compared as signed bytes everything from 0x80 up is negative, so
+     * the one less than 0x20 finds both control characters and the
+     * start of every multi byte sequence
+     */
+    __attribute__ ((target ("sse2")))
+    size_t
+    sse2 (const uint8_t * s_, size_t n_) {
+        const auto space = _mm_set1_epi8 (0x20);
+        const auto quote = _mm_set1_epi8 ('"');
+        const auto slash = _mm_set1_epi8 ('\\');
+
+        size_t i { 0 };
+
+        for ( ; i + 16 <= n_ ; i += 16) {
+            auto v = _mm_loadu_si128 (reinterpret_cast<const __m128i *>(s_ + i));
+            auto hit = _mm_or_si128 (
+                _mm_cmplt_epi8 (v, space),
+                _mm_or_si128 (_mm_cmpeq_epi8 (v, quote), _mm_cmpeq_epi8 (v, slash)));
+
+            if (auto mask = static_cast<unsigned>(_mm_movemask_epi8 (hit)); mask) {
+                return i + __builtin_ctz (mask);
+            }
+        }
+
+        return i + scalar (s_ + i, n_ - i);
+    }
+
+    __attribute__ ((target ("avx2")))
+    size_t
+    avx2 (const uint8_t * s_, size_t n_) {
+        const auto space = _mm256_set1_epi8 (0x20);
+        const auto quote = _mm256_set1_epi8 ('"');
+        const auto slash = _mm256_set1_epi8 ('\\');
+
+        size_t i { 0 };
+
+        for ( ; i + 32 <= n_ ; i += 32) {
+            auto v = _mm256_loadu_si256 (reinterpret_cast<const __m256i *>(s_ + i));
+            auto hit = _mm256_or_si256 (
+                _mm256_cmpgt_epi8 (space, v),
+                _mm256_or_si256 (_mm256_cmpeq_epi8 (v, quote), _mm256_cmpeq_epi8 (v, slash)));
+
+            if (auto mask = static_cast<unsigned>(_mm256_movemask_epi8 (hit)); mask) {
+                return i + __builtin_ctz (mask);
+            }
+        }
+
+        return i + sse2 (s_ + i, n_ - i);
+    }
+
+#endif
+
+    using Kernel = size_t (*)(const uint8_t *, size_t);
+
+    struct Scan {
+        const char * name;
+        Kernel       kernel;
+    };
+
+    /*
+     * Chosen once, the first time anything is escaped
+     */
+    const Scan &
+    scan() {
+        static const Scan rtn = []() {
+#ifdef AMQP_JSON_X86
+            __builtin_cpu_init();
+
+            if (__builtin_cpu_supports ("avx2")) {
+                return Scan { "avx2", &avx2 };
+            }
+
+            if (__builtin_cpu_supports ("sse2")) {
+                return Scan { "sse2", &sse2 };
+            }
+#endif
+            return Scan { "scalar", &scalar };
+        }();
+
+        return rtn;
+    }
+
+    inline bool
+    continuation (uint8_t c_, uint8_t lo_ = 0x80, uint8_t hi_ = 0xbf) {
+        return c_ >= lo_ && c_ <= hi_;
+    }
+
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::reader::format::
+plain (std::string_view s_) {
+    return scan().kernel (reinterpret_cast<const uint8_t *>(s_.data()), s_.size());
+}
+
+/******************************************************************************/
+
+/**
+ * Table 3-7 of the Unicode standard, the ranges of the second byte
+ * following from the first being what rules out overlongs, surrogates
+ * and values past U+10FFFF
+ */
+size_t
+amqp::internal::reader::format::
+sequence (std::string_view s_, bool & valid_) {
+    auto byte = [&s_](size_t i_) { return static_cast<uint8_t>(s_[i_]); };
+
+    valid_ = false;
+
+    auto lead = byte (0);
+
+    size_t length;
+    uint8_t lo { 0x80 };
+    uint8_t hi { 0xbf };
+
+    if (lead >= 0xc2 && lead <= 0xdf) {
+        length = 2;
+    } else if (lead >= 0xe0 && lead <= 0xef) {
+        length = 3;
+        if (lead == 0xe0) lo = 0xa0;
+        if (lead == 0xed) hi = 0x9f;
+    } else if (lead >= 0xf0 && lead <= 0xf4) {
+        length = 4;
+        if (lead == 0xf0) lo = 0x90;
+        if (lead == 0xf4) hi = 0x8f;
+    } else {
+        return 1;
+    }
+
+    if (s_.size() < 2 || !continuation (byte (1), lo, hi)) {
+        return 1;
+    }
+
+    for (size_t i { 2 } ; i < length ; ++i) {
+        if (i >= s_.size() || !continuation (byte (i))) {
+            return i;
+        }
+    }
+
+    valid_ = true;
+
+    return length;
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::reader::format::
+escape (uint8_t c_, char (&out_)[6]) {
+    static const char hex[] = "0123456789abcdef";
+
+    out_[0] = '\\';
+
+    switch (c_) {
+        case '"'  : out_[1] = '"'; break;
+        case '\\' : out_[1] = '\\'; break;
+        case '\b' : out_[1] = 'b'; break;
+        case '\f' : out_[1] = 'f'; break;
+        case '\n' : out_[1] = 'n'; break;
+        case '\r' : out_[1] = 'r'; break;
+        case '\t' : out_[1] = 't'; break;
+        default : {
+            out_[1] = 'u';
+            out_[2] = '0';
+            out_[3] = '0';
+            out_[4] = hex[c_ >> 4U];
+            out_[5] = hex[c_ & 0xfU];
+
+            return std::string_view (out_, 6);
+        }
+    }
+
+    return std::string_view (out_, 2);
+}
+
+/******************************************************************************/
+
+const char *
+amqp::internal::reader::format::
+escapeKernel() {
+    return scan().name;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::format::
+quote (std::string_view s_, std::string & out_) {
+    out_.reserve (out_.size() + s_.size() + 2);
+    out_ += '"';
+    escape (s_, [&out_](std::string_view run_) { out_.append (run_); });
+    out_ += '"';
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::format::
+quote (std::string_view s_) {
+    std::string rtn;
+    quote (s_, rtn);
+
+    return rtn;
+}
+
+/******************************************************************************/
@@ -0,0 +1,92 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <cstdint>
+#include <string_view>
+
+/******************************************************************************
+ *
+ * JSON string escaping, RFC 8259
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::reader::format {
+
+    /**
+     * How many bytes at the start of s_ can go into a JSON string as they
+     * are, printable ASCII other than " and \. Scanned a vector register
+     * at a time, see escapeKernel.
+     */
+    size_t plain (std::string_view);
+
+    /**
+     * Of the multi byte UTF-8 sequence s_ starts with, how many bytes
+     * there are to pass over and whether they're well formed. Overlong
+     * encodings, surrogates and anything past U+10FFFF are not. When
+     * they aren't what's passed over is the longest prefix that could
+     * have started a valid sequence, at least one byte, so each broken
+     * sequence becomes a single replacement character.
+     */
+    size_t sequence (std::string_view, bool & valid_);
+
+    /**
+     * A control character, or quote or backslash, escaped, written to out_
+     */
+    std::string_view escape (uint8_t, char (&out_)[6]);
+
+    /**
+     * Which scan plain uses, "avx2", "sse2" or "scalar"
+     */
+    const char * escapeKernel();
+
+    /**
+     * Hand the body of s_ as a JSON string, without the enclosing quotes,
+     * to sink_ a piece at a time. Well formed UTF-8 is passed through as
+     * is and anything else replaced with U+FFFD so whatever the input the
+     * output is valid JSON. Runs needing no escaping are handed over whole.
+     */
+    template<typename Sink>
+    void
+    escape (std::string_view s_, Sink && sink_) {
+        char buf[6];
+
+        size_t run { 0 };
+        size_t i { 0 };
+
+        while ((i += plain (s_.substr (i))) < s_.size()) {
+            auto c = static_cast<uint8_t>(s_[i]);
+
+            if (c < 0x80) {
+                sink_ (s_.substr (run, i - run));
+                sink_ (escape (c, buf));
+                run = ++i;
+                continue;
+            }
+
+            bool valid;
+            auto n = sequence (s_.substr (i), valid);
+
+            if (!valid) {
+                sink_ (s_.substr (run, i - run));
+                sink_ (std::string_view ("\\ufffd"));
+                run = i + n;
+            }
+
+            i += n;
+        }
+
+        sink_ (s_.substr (run));
+    }
+
+    /**
+     * s_ as a quoted JSON string appended to out_
+     */
+    void quote (std::string_view, std::string & out_);
+
+    std::string quote (std::string_view);
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,370 @@
+#include "JsonWriter.h"
+#include "Formats.h"
+#include "JsonString.h"
+
+#include <cmath>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <charconv>
+#include <stdexcept>
+
+#include <unistd.h>
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::JsonWriter
+ *
+ ******************************************************************************/
+
+amqp::internal::reader::
+JsonWriter::JsonWriter (int fd_, size_t bufferSize_)
+    : m_fd (fd_)
+    , m_buffer (bufferSize_ ? bufferSize_ : 1)
+    , m_used (0)
+    , m_complete (0)
+    , m_spilled (false)
+    , m_field (false)
+    , m_references (false)
+{ }
+
+/******************************************************************************/
+
+amqp::internal::reader::
+JsonWriter::JsonWriter()
+    : JsonWriter (-1, 4 * 1024)
+{ }
+
+/******************************************************************************/
+
+/**
+ * If we're being destroyed because reading a blob failed half way through
+ * there's no point emitting the truncated document. Can't throw from
+ * here, anyone who cares about write errors should flush themselves.
+ */
+amqp::internal::reader::
+JsonWriter::~JsonWriter() {
+    m_used = m_complete;
+
+    try {
+        flush();
+    } catch (const std::runtime_error &) {
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::beginComposite (const std::string &) {
+    separator();
+    write ("{ ");
+    m_first.push_back (true);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::endComposite() {
+    write (m_first.back() ? "}" : " }");
+    m_first.pop_back();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::beginList() {
+    separator();
+    write ("[ ");
+    m_first.push_back (true);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::endList() {
+    write (m_first.back() ? "]" : " ]");
+    m_first.pop_back();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::field (const std::string & name_) {
+    separator();
+    string (name_);
+    write (" : ");
+    m_field = true;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::value (int32_t val_) {
+    value (static_cast<int64_t>(val_));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::value (int64_t val_) {
+    separator();
+
+    char buf[24];
+    auto res = std::to_chars (buf, buf + sizeof (buf), val_);
+    write (std::string_view (buf, res.ptr - buf));
+}
+
+/******************************************************************************/
+
+/**
+ * JSON has no representation of NaN or infinity. For everything else use
+ * the shortest representation that survives the round trip.
+ */
+void
+amqp::internal::reader::
+JsonWriter::value (double val_) {
+    separator();
+
+    if (!std::isfinite (val_)) {
+        write ("null");
+        return;
+    }
+
+    char buf[32];
+    int sz = snprintf (buf, sizeof (buf), "%.15g", val_);
+
+    if (strtod (buf, nullptr) != val_) {
+        sz = snprintf (buf, sizeof (buf), "%.17g", val_);
+    }
+
+    write (std::string_view (buf, sz));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::value (bool val_) {
+    separator();
+    write (val_ ? "true" : "false");
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::value (std::string_view val_) {
+    separator();
+    string (val_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::value (uint64_t val_) {
+    separator();
+
+    char buf[24];
+    auto res = std::to_chars (buf, buf + sizeof (buf), val_);
+    write (std::string_view (buf, res.ptr - buf));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::binary (std::string_view bytes_) {
+    separator();
+    string (format::base64 (bytes_));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::timestamp (int64_t millis_) {
+    separator();
+    string (format::timestamp (millis_));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::null() {
+    separator();
+    write ("null");
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::reader::
+JsonWriter::reference (size_t index_) {
+    if (!m_references) {
+        return false;
+    }
+
+    separator();
+    write ("{ \"@ref\" : ");
+
+    char buf[24];
+    auto res = std::to_chars (buf, buf + sizeof (buf), index_);
+    write (std::string_view (buf, res.ptr - buf));
+
+    write (" }");
+
+    return true;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::references (bool references_) {
+    m_references = references_;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::reader::
+JsonWriter::references() const {
+    return m_references;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::endDocument() {
+    write ("\n");
+
+    m_complete = m_used;
+    m_spilled = false;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::reader::
+JsonWriter::rollback() {
+    auto rtn = !m_spilled;
+
+    m_used = m_complete;
+    m_spilled = false;
+    m_first.clear();
+    m_field = false;
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::flush() {
+    if (m_fd < 0) return;
+
+    const char * p = m_buffer.data();
+
+    m_spilled = m_spilled || m_used > m_complete;
+
+    while (m_used > 0) {
+        auto rtn = ::write (m_fd, p, m_used);
+
+        if (rtn < 0) {
+            if (errno == EINTR) continue;
+            m_used = m_complete = 0;
+            throw std::runtime_error (
+                    std::string ("Failed to write JSON: ") + strerror (errno));
+        }
+
+        p += rtn;
+        m_used -= rtn;
+    }
+
+    m_complete = 0;
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+JsonWriter::take() {
+    std::string rtn (m_buffer.data(), m_complete);
+
+    memmove (m_buffer.data(), m_buffer.data() + m_complete, m_used - m_complete);
+    m_used -= m_complete;
+    m_complete = 0;
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+/**
+ * Values inside a composite are preceded by their name, which has already
+ * taken care of separating them from their predecessor
+ */
+void
+amqp::internal::reader::
+JsonWriter::separator() {
+    if (m_field) {
+        m_field = false;
+        return;
+    }
+
+    if (m_first.empty()) return;
+
+    if (m_first.back()) {
+        m_first.back() = false;
+    } else {
+        write (", ");
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+JsonWriter::write (std::string_view s_) {
+    while (!s_.empty()) {
+        if (m_used == m_buffer.size()) {
+            if (m_fd < 0) {
+                m_buffer.resize (m_buffer.size() * 2);
+            } else {
+                flush();
+            }
+        }
+
+        auto n = std::min (s_.size(), m_buffer.size() - m_used);
+        memcpy (m_buffer.data() + m_used, s_.data(), n);
+        m_used += n;
+        s_.remove_prefix (n);
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Runs of characters that need no escaping are copied as is, see
+ * format::escape
+ */
+void
+amqp::internal::reader::
+JsonWriter::string (std::string_view s_) {
+    write ("\"");
+    format::escape (s_, [this](std::string_view run_) { write (run_); });
+    write ("\"");
+}
+
+/******************************************************************************/
@@ -0,0 +1,143 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <string_view>
+
+#include "amqp/reader/IVisitor.h"
+
+/******************************************************************************
+ *
+ * class amqp::internal::reader::JsonWriter
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * A visitor that writes what it's shown as JSON straight to a file
+     * descriptor through a fixed size buffer. Nothing is retained beyond
+     * a flag per level of nesting so memory use is bounded by the depth
+     * of the object graph, not the size of the output.
+     *
+     * Any number of documents may be written, one per line. The buffer
+     * is only written out when it fills, on flush, or when the writer is
+     * destroyed, in which case only complete documents are kept. A
+     * document that fails half way through can be rolled back so long
+     * as none of it has already had to be written out.
+     *
+     * Objects the blob refers back to are written out again in full
+     * unless asked to write the reference instead, as { "@ref" : n } with
+     * n the object's number, see codec::References.
+     *
+     * Constructed without a descriptor the buffer grows instead, complete
+     * documents being handed over with take, for when several threads
+     * each render their own and something else decides where they go.
+     *
+     * Throws std::runtime_error if the descriptor can't be written to.
+     */
+    class JsonWriter : public amqp::reader::IVisitor {
+        private :
+            int m_fd;
+
+            std::vector<char> m_buffer;
+            size_t            m_used;
+
+            /**
+             * How much of the buffer is complete documents
+             */
+            size_t            m_complete;
+
+            /**
+             * Set if the buffer filled part way through the current
+             * document and the start of it has already gone out
+             */
+            bool              m_spilled;
+
+            /**
+             * One entry per open object or array, true until its first
+             * member has been written
+             */
+            std::vector<bool> m_first;
+
+            /**
+             * Set between writing a property name and its value
+             */
+            bool m_field;
+
+            bool m_references;
+
+        public :
+            explicit JsonWriter (int, size_t bufferSize_ = 64 * 1024);
+            JsonWriter();
+            JsonWriter (const JsonWriter &) = delete;
+
+            ~JsonWriter() override;
+
+            void beginComposite (const std::string &) override;
+            void endComposite() override;
+
+            void beginList() override;
+            void endList() override;
+
+            void field (const std::string &) override;
+
+            void value (int32_t) override;
+            void value (int64_t) override;
+            void value (double) override;
+            void value (bool) override;
+            void value (std::string_view) override;
+            void value (uint64_t) override;
+
+            /**
+             * As base64 strings and ISO 8601 UTC strings respectively
+             */
+            void binary (std::string_view) override;
+            void timestamp (int64_t) override;
+
+            void null() override;
+
+            bool reference (size_t) override;
+
+            /**
+             * Write back references as they are rather than repeating
+             * what they refer to
+             */
+            void references (bool);
+            bool references() const;
+
+            /**
+             * Finish the current document with a new line
+             */
+            void endDocument();
+
+            /**
+             * Drop the current, unfinished, document. Returns false if
+             * some of it had already been written out.
+             */
+            bool rollback();
+
+            /**
+             * Write out everything, including any unfinished document.
+             * Does nothing without a descriptor.
+             */
+            void flush();
+
+            /**
+             * Hand over the complete documents, only useful without a
+             * descriptor
+             */
+            std::string take();
+
+        private :
+            void separator();
+            void write (std::string_view);
+            void string (std::string_view);
+    };
+
+}
+
+/******************************************************************************/
+
@@ -0,0 +1,235 @@
+#include "Projection.h"
+
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+
+#include "debug.h"
+
+#include "CompositeReader.h"
+#include "restricted-readers/ListReader.h"
+
+#include "codec/codec_wrapper.h"
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::Projection
+ *
+ ******************************************************************************/
+
+amqp::internal::reader::
+Projection::Projection (
+    const Reader & reader_,
+    const std::vector<std::string> & paths_
+) {
+    std::vector<std::vector<std::string>> split;
+    split.reserve (paths_.size());
+
+    for (const auto & path : paths_) {
+        std::vector<std::string> segments;
+
+        for (size_t start { 0 } ;; ) {
+            auto dot = path.find ('.', start);
+            auto segment = path.substr (start, dot - start);
+
+            if (segment.empty()) {
+                throw std::runtime_error ("Bad field path \"" + path + "\"");
+            }
+
+            segments.emplace_back (std::move (segment));
+
+            if (dot == std::string::npos) break;
+            start = dot + 1;
+        }
+
+        split.emplace_back (std::move (segments));
+    }
+
+    Paths paths;
+    for (const auto & segments : split) {
+        paths.emplace_back (&segments, 0);
+    }
+
+    m_root = compile (reader_, paths);
+}
+
+/******************************************************************************/
+
+/**
+ * A path that ends here means we want everything beneath us and can just
+ * use the reader as is, otherwise what comes next in each path must be
+ * one of our fields, or of our elements' fields if we're a list
+ */
+const amqp::internal::reader::Projection::Node *
+amqp::internal::reader::
+Projection::compile (const Reader & reader_, const Paths & paths_) {
+    m_nodes.emplace_back (std::make_unique<Node>());
+    auto & node = *m_nodes.back();
+
+    node.reader = &reader_;
+
+    for (const auto & path : paths_) {
+        if (path.second == path.first->size()) {
+            return &node;
+        }
+    }
+
+    if (auto composite = dynamic_cast<const CompositeReader *>(&reader_)) {
+        const auto & fields = composite->fields();
+
+        std::vector<Paths> wanted (fields.size());
+        size_t last { 0 };
+
+        for (const auto & path : paths_) {
+            const auto & name = (*path.first)[path.second];
+
+            auto it = std::find_if (fields.begin(), fields.end(),
+                [&name](const CompositeReader::Field & field_) {
+                    return field_.name == name;
+                });
+
+            if (it == fields.end()) {
+                throw std::runtime_error (
+                    "No field \"" + name + "\" in " + composite->type());
+            }
+
+            auto idx = static_cast<size_t>(it - fields.begin());
+
+            wanted[idx].emplace_back (path.first, path.second + 1);
+            last = std::max (last, idx + 1);
+        }
+
+        node.composite = composite;
+        node.fields.resize (last, nullptr);
+
+        for (size_t i { 0 } ; i < last ; ++i) {
+            if (wanted[i].empty()) continue;
+
+            if (!fields[i].resolved) {
+                throw std::runtime_error ("Reader used before being frozen");
+            }
+
+            node.fields[i] = compile (*fields[i].resolved, wanted[i]);
+        }
+
+        DBG ("Projection: " << composite->type() << " " << last << " of "
+            << fields.size() << " fields" << std::endl); // NOLINT
+    } else if (auto list = dynamic_cast<const ListReader *>(&reader_)) {
+        if (!list->element()) {
+            throw std::runtime_error ("Reader used before being frozen");
+        }
+
+        node.list = list;
+        node.element = compile (*list->element(), paths_);
+    } else if (!paths_.empty()) {
+        throw std::runtime_error (
+            "Cannot select \"" + (*paths_.front().first)[paths_.front().second]
+            + "\" from " + reader_.type() + ", it has no fields");
+    }
+
+    return &node;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Projection::visit (
+    codec::Cursor * data_,
+    const amqp::internal::reader::IReader::SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_
+) const {
+    // numbered by the full reader, not us, so nothing skipped is missed
+    m_root->reader->root (data_);
+
+    visit (*m_root, data_, schema_, visitor_);
+}
+
+/******************************************************************************/
+
+/**
+ * Composites and lists are walked exactly as their readers would, see
+ * CompositeReader::visit and ListReader::visit, other than skipping what
+ * we don't want. Anything skipped is still numbered should something
+ * after it refer back to it, the root being read again in full by its
+ * own reader to number them, see codec::References.
+ */
+void
+amqp::internal::reader::
+Projection::visit (
+    const Node & node_,
+    codec::Cursor * data_,
+    const amqp::internal::reader::IReader::SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_
+) const {
+    if (node_.composite || node_.list) {
+        if (codec::auto_resolve ref (data_); ref) {
+            if (!visitor_.reference (ref.index())) {
+                visit (node_, ref.object(), schema_, visitor_);
+            }
+
+            return;
+        }
+    }
+
+    if (node_.composite) {
+        const auto & composite = *node_.composite;
+
+        codec::auto_next an (data_);
+        codec::is_described (data_);
+        codec::auto_enter ae (data_);
+
+        auto descriptor = codec::get_symbol<std::string_view>(data_);
+
+        if (descriptor != composite.descriptor()) {
+            std::stringstream s;
+            s << "Expected an instance of " << composite.type() << " ("
+              << composite.descriptor() << ") but found " << descriptor;
+            throw std::runtime_error (s.str());
+        }
+
+        data_->next();
+
+        codec::is_list (data_);
+
+        visitor_.beginComposite (composite.type());
+        {
+            codec::auto_enter ae (data_);
+
+            const auto & fields = composite.fields();
+
+            // anything after the last field we want is left where it is,
+            // leaving the list moves us past it
+            for (size_t i { 0 } ; i < node_.fields.size() ; ++i) {
+                if (!node_.fields[i]) {
+                    data_->next();
+                    continue;
+                }
+
+                visitor_.field (fields[i].name);
+                visit (*node_.fields[i], data_, schema_, visitor_);
+            }
+        }
+        visitor_.endComposite();
+    } else if (node_.list) {
+        codec::auto_next an (data_);
+        codec::is_described (data_);
+
+        {
+            codec::auto_enter ae (data_, true);
+
+            codec::auto_list_enter ale (data_, true);
+
+            visitor_.beginList();
+            for (size_t i { 0 } ; i < ale.elements() ; ++i) {
+                visit (*node_.element, data_, schema_, visitor_);
+            }
+            visitor_.endList();
+        }
+    } else {
+        node_.reader->visit (data_, schema_, visitor_);
+    }
+}
+
+/******************************************************************************/
+
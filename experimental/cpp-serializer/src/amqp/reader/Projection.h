@@ -0,0 +1,99 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+
+#include "types.h"
+#include "Reader.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    class ListReader;
+    class CompositeReader;
+
+}
+
+/******************************************************************************
+ *
+ * class amqp::internal::reader::Projection
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * A reader graph cut down to a handful of field paths, "amount" or
+     * "amount.quantity", so only those values are ever decoded.
+     *
+     * The paths are resolved against the (frozen) readers once, up front,
+     * into a tree that mirrors just the parts of the graph they touch.
+     * Reading a blob with it, a field nobody asked for is stepped over in
+     * a single move using the size the encoding carries for it, however
+     * much is nested beneath it, and once the last wanted field of a
+     * composite has been read the rest of it is never looked at.
+     *
+     * A path passes straight through lists, selecting from each element,
+     * so "legs.amount" picks the amount out of every one of the legs.
+     *
+     * What's produced is the original object graph with everything not
+     * asked for left out, fields appearing in the order the schema has
+     * them rather than the order they were asked for.
+     *
+     * Only valid for as long as the readers it was built from.
+     */
+    class Projection {
+        private :
+            struct Node {
+                const Reader *          reader    { nullptr };
+
+                /**
+                 * Set if only some of a composite's fields are wanted,
+                 * one entry per field up to the last of them with the
+                 * rest null
+                 */
+                const CompositeReader * composite { nullptr };
+                std::vector<const Node *> fields;
+
+                /**
+                 * Set if we want something from each element of a list
+                 */
+                const ListReader *      list      { nullptr };
+                const Node *            element   { nullptr };
+            };
+
+            using Paths = std::vector<std::pair<const std::vector<std::string> *, size_t>>;
+
+            std::vector<uPtr<Node>> m_nodes;
+            const Node *            m_root;
+
+        public :
+            /**
+             * Throws std::runtime_error if a path names a field that
+             * doesn't exist
+             */
+            Projection (const Reader &, const std::vector<std::string> &);
+            Projection (const Projection &) = delete;
+
+            void visit (
+                codec::Cursor *,
+                const amqp::internal::reader::IReader::SchemaType &,
+                amqp::reader::IVisitor &) const;
+
+        private :
+            const Node * compile (const Reader &, const Paths &);
+
+            void visit (
+                const Node &,
+                codec::Cursor *,
+                const amqp::internal::reader::IReader::SchemaType &,
+                amqp::reader::IVisitor &) const;
+    };
+
+}
+
+/******************************************************************************/
+
@@ -5,55 +5,98 @@
 #include "amqp/reader/property-readers/LongPropertyReader.h"
 #include "amqp/reader/property-readers/StringPropertyReader.h"
 #include "amqp/reader/property-readers/DoublePropertyReader.h"
+#include "amqp/reader/property-readers/PrimitivePropertyReader.h"
 
-#include <map>
+#include <array>
 #include <string>
 #include <iostream>
 #include <functional>
+#include <stdexcept>
 
-#include <proton/codec.h>
-
-#include "proton/proton_wrapper.h"
+#include "codec/codec_wrapper.h"
 
 /******************************************************************************/
 
 namespace {
 
-    std::map<
-            std::string,
-            std::shared_ptr<amqp::internal::reader::PropertyReader>(*)()
-    > propertyMap = { // NOLINT
-        {
-            "int", []() -> std::shared_ptr<amqp::internal::reader::PropertyReader> {
-                return std::make_shared<amqp::internal::reader::IntPropertyReader> ();
-            }
-        },
-        {
-            "string", []() -> std::shared_ptr<amqp::internal::reader::PropertyReader> {
-                return std::make_shared<amqp::internal::reader::StringPropertyReader> (
-                        amqp::internal::reader::StringPropertyReader());
-            }
-        },
-        {
-            "boolean", []() -> std::shared_ptr<amqp::internal::reader::PropertyReader> {
-                return std::make_shared<amqp::internal::reader::BoolPropertyReader> (
-                        amqp::internal::reader::BoolPropertyReader());
-            }
-        },
-        {
-            "long", []() -> std::shared_ptr<amqp::internal::reader::PropertyReader> {
-                return std::make_shared<amqp::internal::reader::LongPropertyReader> (
-                        amqp::internal::reader::LongPropertyReader());
-            }
-        },
-        {
-            "double", []() -> std::shared_ptr<amqp::internal::reader::PropertyReader> {
-                return std::make_shared<amqp::internal::reader::DoublePropertyReader> (
-                        amqp::internal::reader::DoublePropertyReader());
-            }
-        }
+    using Factory = std::shared_ptr<amqp::internal::reader::PropertyReader> (*)();
+
+    template<codec::type_t C>
+    void
+    primitive (std::array<Factory, codec::AMQP_MAP + 1> & factories_) {
+        factories_[C] = []() -> std::shared_ptr<amqp::internal::reader::PropertyReader> {
+            return std::make_shared<amqp::internal::reader::PrimitivePropertyReader> (C);
+        };
+    }
+
+    /*
+     * Indexed by type code, see codec::type_t, with a null for anything
+     * that isn't a primitive. Anything without a reader of its own is
+     * handled by a PrimitivePropertyReader, which picks up the code from
+     * the table rather than from a string.
+     *
+     * Never modified after static initialisation so any number of threads
+     * can look things up in it.
+     */
+    const std::array<Factory, codec::AMQP_MAP + 1> factories { // NOLINT
+        []() {
+            using namespace amqp::internal::reader;
+
+            std::array<Factory, codec::AMQP_MAP + 1> rtn { };
+
+            rtn[codec::AMQP_INT] = []() -> std::shared_ptr<PropertyReader> {
+                return std::make_shared<IntPropertyReader>();
+            };
+
+            rtn[codec::AMQP_STRING] = []() -> std::shared_ptr<PropertyReader> {
+                return std::make_shared<StringPropertyReader>();
+            };
+
+            rtn[codec::AMQP_BOOL] = []() -> std::shared_ptr<PropertyReader> {
+                return std::make_shared<BoolPropertyReader>();
+            };
+
+            rtn[codec::AMQP_LONG] = []() -> std::shared_ptr<PropertyReader> {
+                return std::make_shared<LongPropertyReader>();
+            };
+
+            rtn[codec::AMQP_DOUBLE] = []() -> std::shared_ptr<PropertyReader> {
+                return std::make_shared<DoublePropertyReader>();
+            };
+
+            primitive<codec::AMQP_UBYTE> (rtn);
+            primitive<codec::AMQP_BYTE> (rtn);
+            primitive<codec::AMQP_USHORT> (rtn);
+            primitive<codec::AMQP_SHORT> (rtn);
+            primitive<codec::AMQP_UINT> (rtn);
+            primitive<codec::AMQP_CHAR> (rtn);
+            primitive<codec::AMQP_ULONG> (rtn);
+            primitive<codec::AMQP_TIMESTAMP> (rtn);
+            primitive<codec::AMQP_FLOAT> (rtn);
+            primitive<codec::AMQP_DECIMAL32> (rtn);
+            primitive<codec::AMQP_DECIMAL64> (rtn);
+            primitive<codec::AMQP_DECIMAL128> (rtn);
+            primitive<codec::AMQP_UUID> (rtn);
+            primitive<codec::AMQP_BINARY> (rtn);
+            primitive<codec::AMQP_SYMBOL> (rtn);
+
+            return rtn;
+        }()
     };
 
+    /******************************************************************************/
+
+    std::shared_ptr<amqp::internal::reader::PropertyReader>
+    makeProperty (const std::string & type_) {
+        auto code = codec::type_code (type_);
+
+        if (!amqp::internal::reader::PropertyReader::isPrimitive (code)) {
+            throw std::runtime_error ("No property reader for type " + type_);
+        }
+
+        return factories[code]();
+    }
+
 }
 
 /******************************************************************************/
@@ -64,7 +107,7 @@ namespace {
 std::shared_ptr<amqp::internal::reader::PropertyReader>
 amqp::internal::reader::
 PropertyReader::make (const FieldPtr & field_) {
-    return propertyMap[field_->type()]();
+    return makeProperty (field_->type());
 }
 
 /******************************************************************************/
@@ -72,9 +115,17 @@ PropertyReader::make (const FieldPtr & field_) {
 std::shared_ptr<amqp::internal::reader::PropertyReader>
 amqp::internal::reader::
 PropertyReader::make (const std::string & type_) {
-    return propertyMap[type_]();
+    return makeProperty (type_);
 }
 
 /******************************************************************************/
 
+bool
+amqp::internal::reader::
+PropertyReader::isPrimitive (codec::type_t code_) {
+    return code_ > 0
+        && code_ < static_cast<int>(factories.size())
+        && factories[code_] != nullptr;
+}
 
+/******************************************************************************/
@@ -4,6 +4,7 @@
 
 #include "Reader.h"
 
+#include "codec/Cursor.h"
 #include "amqp/schema/Field.h"
 
 /******************************************************************************/
@@ -21,22 +22,22 @@ namespace amqp::internal::reader {
             static std::shared_ptr<PropertyReader> make (const FieldPtr &);
             static std::shared_ptr<PropertyReader> make (const std::string &);
 
+            /**
+             * Whether there's a reader for values of the type code
+             */
+            static bool isPrimitive (codec::type_t);
+
             PropertyReader() = default;
             ~PropertyReader() override = default;
 
-            std::string readString(pn_data_t *) const override = 0;
+            std::string readString(codec::Cursor *) const override = 0;
 
-            std::any read (pn_data_t *) const override = 0;
-
-            std::unique_ptr<amqp::reader::IValue> dump(
-                const std::string &,
-                pn_data_t *,
-                const SchemaType &
-            ) const override = 0;
+            amqp::reader::Variant read (codec::Cursor *) const override = 0;
 
-            std::unique_ptr<amqp::reader::IValue> dump(
-                pn_data_t *,
-                const SchemaType &
+            void visit (
+                codec::Cursor *,
+                const SchemaType &,
+                amqp::reader::IVisitor &
             ) const override = 0;
 
             const std::string & name() const override = 0;
@@ -0,0 +1,565 @@
+#include "Query.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <algorithm>
+#include <stdexcept>
+
+#include "PropertyReader.h"
+#include "CompositeReader.h"
+#include "restricted-readers/ListReader.h"
+
+#include "codec/Cursor.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using amqp::internal::reader::Query;
+
+    std::string
+    trim (const std::string & s_) {
+        auto first = s_.find_first_not_of (" \t");
+        if (first == std::string::npos) return "";
+
+        return s_.substr (first, s_.find_last_not_of (" \t") - first + 1);
+    }
+
+    /**************************************************************************/
+
+    Query::Literal
+    literal (const std::string & text_) {
+        Query::Literal rtn { Query::Literal::String };
+
+        if (text_.size() >= 2
+            && (text_.front() == '"' || text_.front() == '\'')
+            && text_.back() == text_.front()
+        ) {
+            rtn.text = text_.substr (1, text_.size() - 2);
+            return rtn;
+        }
+
+        rtn.text = text_;
+
+        if (text_ == "null") {
+            rtn.kind = Query::Literal::Null;
+        } else if (text_ == "true" || text_ == "false") {
+            rtn.kind = Query::Literal::Bool;
+            rtn.boolean = text_ == "true";
+        } else if (!text_.empty()) {
+            char * end;
+
+            errno = 0;
+            auto d = strtod (text_.c_str(), &end);
+
+            if (*end == '\0' && errno == 0) {
+                rtn.kind = Query::Literal::Number;
+                rtn.number = d;
+
+                auto i = strtoll (text_.c_str(), &end, 10);
+                rtn.integral = *end == '\0' && errno == 0;
+                rtn.integer = i;
+            }
+        }
+
+        return rtn;
+    }
+
+    /**************************************************************************/
+
+    /**
+     * Reduces what a single path Projection produces to just the values
+     * at the end of the path. The composites along the way are dropped,
+     * the lists kept so a path through them yields an array.
+     */
+    class Selector : public amqp::reader::IVisitor {
+        private :
+            amqp::reader::IVisitor & m_out;
+
+            /**
+             * Fields named in the path, and how many of them we've seen
+             * on the way to where we are
+             */
+            size_t m_fields;
+            size_t m_at;
+
+            /**
+             * The next thing we see is what was selected
+             */
+            bool m_target;
+
+            /**
+             * How deep we are in what was selected, everything in it is
+             * passed on untouched
+             */
+            size_t m_inside;
+
+            std::vector<size_t> m_saved;
+
+            bool
+            begin() {
+                if (m_inside) {
+                    ++m_inside;
+                    return true;
+                }
+
+                if (m_target) {
+                    m_target = false;
+                    m_inside = 1;
+                    return true;
+                }
+
+                m_saved.push_back (m_at);
+                return false;
+            }
+
+            bool
+            end() {
+                if (m_inside) {
+                    --m_inside;
+                    return true;
+                }
+
+                m_at = m_saved.back();
+                m_saved.pop_back();
+                return false;
+            }
+
+            bool
+            scalar() {
+                if (m_inside) return true;
+                if (!m_target) return false;
+
+                m_target = false;
+                return true;
+            }
+
+        public :
+            Selector (amqp::reader::IVisitor & out_, size_t fields_)
+                : m_out (out_)
+                , m_fields (fields_)
+                , m_at (0)
+                , m_target (false)
+                , m_inside (0)
+            { }
+
+            void
+            beginComposite (const std::string & type_) override {
+                if (begin()) m_out.beginComposite (type_);
+            }
+
+            void
+            endComposite() override {
+                if (end()) m_out.endComposite();
+            }
+
+            void
+            beginList() override {
+                begin();
+                m_out.beginList();
+            }
+
+            void
+            endList() override {
+                end();
+                m_out.endList();
+            }
+
+            void
+            field (const std::string & name_) override {
+                if (m_inside) {
+                    m_out.field (name_);
+                } else if (++m_at == m_fields) {
+                    m_target = true;
+                }
+            }
+
+            void value (int32_t v_) override { if (scalar()) m_out.value (v_); }
+            void value (int64_t v_) override { if (scalar()) m_out.value (v_); }
+            void value (double v_) override { if (scalar()) m_out.value (v_); }
+            void value (bool v_) override { if (scalar()) m_out.value (v_); }
+            void value (std::string_view v_) override { if (scalar()) m_out.value (v_); }
+            void value (uint64_t v_) override { if (scalar()) m_out.value (v_); }
+            void binary (std::string_view v_) override { if (scalar()) m_out.binary (v_); }
+            void timestamp (int64_t v_) override { if (scalar()) m_out.timestamp (v_); }
+            void null() override { if (scalar()) m_out.null(); }
+    };
+
+    /**************************************************************************/
+
+    /**
+     * Tests every value it's shown against a condition, remembering if
+     * any passed
+     */
+    class Comparison : public amqp::reader::IVisitor {
+        private :
+            const Query::Condition & m_condition;
+            bool                     m_matched;
+
+            template<typename T>
+            void
+            compare (const T & value_, const T & literal_) {
+                switch (m_condition.op) {
+                    case Query::EQ : m_matched |= value_ == literal_; break;
+                    case Query::NE : m_matched |= value_ != literal_; break;
+                    case Query::LT : m_matched |= value_ <  literal_; break;
+                    case Query::LE : m_matched |= value_ <= literal_; break;
+                    case Query::GT : m_matched |= value_ >  literal_; break;
+                    case Query::GE : m_matched |= value_ >= literal_; break;
+                }
+            }
+
+            void
+            mismatch() {
+                m_matched |= m_condition.op == Query::NE;
+            }
+
+            void
+            integer (int64_t value_) {
+                const auto & literal = m_condition.value;
+
+                if (literal.kind != Query::Literal::Number) {
+                    mismatch();
+                } else if (literal.integral) {
+                    compare (value_, literal.integer);
+                } else {
+                    compare (static_cast<double>(value_), literal.number);
+                }
+            }
+
+        public :
+            explicit Comparison (const Query::Condition & condition_)
+                : m_condition (condition_)
+                , m_matched (false)
+            { }
+
+            bool matched() const { return m_matched; }
+
+            void beginComposite (const std::string &) override { }
+            void endComposite() override { }
+            void beginList() override { }
+            void endList() override { }
+            void field (const std::string &) override { }
+
+            void value (int32_t v_) override { integer (v_); }
+            void value (int64_t v_) override { integer (v_); }
+
+            void
+            value (double v_) override {
+                if (m_condition.value.kind == Query::Literal::Number) {
+                    compare (v_, m_condition.value.number);
+                } else {
+                    mismatch();
+                }
+            }
+
+            void
+            value (bool v_) override {
+                if (m_condition.value.kind == Query::Literal::Bool) {
+                    compare (v_, m_condition.value.boolean);
+                } else {
+                    mismatch();
+                }
+            }
+
+            /**
+             * Strings compare against the literal as written, so an
+             * unquoted 123 still matches the string "123"
+             */
+            void
+            value (std::string_view v_) override {
+                if (m_condition.value.kind != Query::Literal::Null) {
+                    compare (v_, std::string_view (m_condition.value.text));
+                } else {
+                    mismatch();
+                }
+            }
+
+            void
+            null() override {
+                if (m_condition.value.kind == Query::Literal::Null) {
+                    compare (0, 0);
+                } else {
+                    mismatch();
+                }
+            }
+    };
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::Query
+ *
+ ******************************************************************************/
+
+amqp::internal::reader::Query::Condition
+amqp::internal::reader::
+Query::condition (const std::string & condition_) {
+    auto at = condition_.find_first_of ("=!<>");
+
+    if (at == std::string::npos) {
+        throw std::runtime_error (
+            "Expected a comparison in \"" + condition_ + "\"");
+    }
+
+    Condition rtn;
+    rtn.path = trim (condition_.substr (0, at));
+
+    auto second = at + 1 < condition_.size() ? condition_[at + 1] : '\0';
+    size_t len { 1 };
+
+    switch (condition_[at]) {
+        case '=' :
+            rtn.op = EQ;
+            len += second == '=';
+            break;
+        case '!' :
+            if (second != '=') {
+                throw std::runtime_error ("Bad comparison in \"" + condition_ + "\"");
+            }
+            rtn.op = NE;
+            len = 2;
+            break;
+        case '<' :
+            rtn.op = second == '=' ? LE : LT;
+            len += second == '=';
+            break;
+        default :
+            rtn.op = second == '=' ? GE : GT;
+            len += second == '=';
+            break;
+    }
+
+    auto text = trim (condition_.substr (at + len));
+
+    if (rtn.path.empty() || text.empty()) {
+        throw std::runtime_error ("Bad condition \"" + condition_ + "\"");
+    }
+
+    rtn.value = literal (text);
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+amqp::internal::reader::
+Query::Query (
+    const Reader & reader_,
+    const std::vector<std::string> & select_,
+    const std::vector<Condition> & where_
+) {
+    for (const auto & expression : select_) {
+        m_select.emplace_back (compile (reader_, expression, false));
+    }
+
+    for (const auto & condition : where_) {
+        m_where.emplace_back (compile (reader_, condition.path, true), condition);
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Walk the readers the same way the Projection will, but checking each
+ * [*] really is a list and no list is stepped over without one
+ */
+amqp::internal::reader::Query::Path
+amqp::internal::reader::
+Query::compile (
+    const Reader & reader_,
+    const std::string & expression_,
+    bool primitive_
+) {
+    Path rtn;
+    rtn.expression = expression_;
+
+    std::string path;
+    const Reader * reader = &reader_;
+
+    auto bad = [&expression_](const std::string & why_) {
+        return std::runtime_error ("Cannot use \"" + expression_ + "\", " + why_);
+    };
+
+    for (size_t start { 0 } ;; ) {
+        auto dot = expression_.find ('.', start);
+        auto segment = expression_.substr (start, dot - start);
+
+        auto bracket = std::min (segment.find ('['), segment.size());
+        auto name = segment.substr (0, bracket);
+
+        if (name.empty()) {
+            throw bad ("it has an empty field name");
+        }
+
+        if (dynamic_cast<const ListReader *>(reader)) {
+            throw bad (path + " is a list, use " + path + "[*]");
+        }
+
+        auto composite = dynamic_cast<const CompositeReader *>(reader);
+
+        if (!composite) {
+            throw bad (reader->type() + " has no field " + name);
+        }
+
+        const auto & fields = composite->fields();
+
+        auto it = std::find_if (fields.begin(), fields.end(),
+            [&name](const CompositeReader::Field & field_) {
+                return field_.name == name;
+            });
+
+        if (it == fields.end()) {
+            throw bad (composite->type() + " has no field " + name);
+        }
+
+        if (!it->resolved) {
+            throw std::runtime_error ("Reader used before being frozen");
+        }
+
+        reader = it->resolved;
+        path += (path.empty() ? "" : ".") + name;
+        ++rtn.fields;
+
+        for (auto rest = segment.substr (bracket) ; !rest.empty() ; rest = rest.substr (3)) {
+            if (rest.compare (0, 3, "[*]") != 0) {
+                throw bad ("only [*] can follow a field name");
+            }
+
+            auto list = dynamic_cast<const ListReader *>(reader);
+
+            if (!list) {
+                throw bad (path + " isn't a list");
+            }
+
+            if (!list->element()) {
+                throw std::runtime_error ("Reader used before being frozen");
+            }
+
+            reader = list->element();
+        }
+
+        if (dot == std::string::npos) break;
+        start = dot + 1;
+    }
+
+    if (primitive_ && !dynamic_cast<const PropertyReader *>(reader)) {
+        throw bad (dynamic_cast<const ListReader *>(reader)
+            ? path + " is a list, use " + path + "[*]"
+            : "it doesn't lead to a primitive value");
+    }
+
+    rtn.projection = std::make_unique<Projection> (
+            reader_, std::vector<std::string> { path });
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::reader::
+Query::selects() const {
+    return !m_select.empty();
+}
+
+/******************************************************************************/
+
+/**
+ * Each path is read with a cursor of its own over just the object's bytes
+ * so the caller's never moves and the conditions can be tested in turn,
+ * the first to fail meaning the rest needn't be looked at
+ */
+bool
+amqp::internal::reader::
+Query::matches (
+    codec::Cursor * data_,
+    const IReader::SchemaType & schema_
+) const {
+    auto bytes = data_->bytes();
+
+    for (const auto & where : m_where) {
+        codec::Cursor cursor (bytes.data(), bytes.size());
+        cursor.next();
+
+        Comparison comparison (where.second);
+        Selector selector (comparison, where.first.fields);
+
+        where.first.projection->visit (&cursor, schema_, selector);
+
+        if (!comparison.matched()) return false;
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Query::select (
+    codec::Cursor * data_,
+    const IReader::SchemaType & schema_,
+    amqp::reader::IVisitor & visitor_
+) const {
+    auto bytes = data_->bytes();
+
+    for (const auto & select : m_select) {
+        codec::Cursor cursor (bytes.data(), bytes.size());
+        cursor.next();
+
+        Selector selector (visitor_, select.fields);
+
+        visitor_.field (select.expression);
+        select.projection->visit (&cursor, schema_, selector);
+    }
+}
+
+/******************************************************************************/
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::Queries
+ *
+ ******************************************************************************/
+
+amqp::internal::reader::
+Queries::Queries (
+        std::vector<std::string> select_,
+        std::vector<Query::Condition> where_
+) : m_select (std::move (select_))
+  , m_where (std::move (where_))
+{ }
+
+/******************************************************************************/
+
+const amqp::internal::reader::Query *
+amqp::internal::reader::
+Queries::compile (const Reader & reader_, std::string * why_) {
+    std::lock_guard<std::mutex> lock (m_lock);
+
+    auto it = m_compiled.find (&reader_);
+
+    if (it == m_compiled.end()) {
+        uPtr<Query> query;
+        std::string error;
+
+        try {
+            query = std::make_unique<Query> (reader_, m_select, m_where);
+        } catch (const std::runtime_error & e) {
+            error = e.what();
+        }
+
+        it = m_compiled.emplace (
+                &reader_, std::make_pair (std::move (query), error)).first;
+    }
+
+    if (!it->second.first && why_) {
+        *why_ = it->second.second;
+    }
+
+    return it->second.first.get();
+}
+
+/******************************************************************************/
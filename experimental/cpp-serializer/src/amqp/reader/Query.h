@@ -0,0 +1,176 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include "types.h"
+#include "Reader.h"
+#include "Projection.h"
+
+/******************************************************************************
+ *
+ * class amqp::internal::reader::Query
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Pulls values out of, and tests conditions against, an object without
+     * reading any more of it than that takes.
+     *
+     * Expressions are field paths, with lists stepped into with [*]
+     *
+     *   state.data.participants[*].name
+     *
+     * A selection yields the value at the end of the path, or if it went
+     * through any lists, an array of every value it reached.
+     *
+     * A condition compares the primitive at the end of a path with a
+     * literal, a number, true, false, null or a string, quoted if it would
+     * otherwise be taken as one of the others
+     *
+     *   amount.quantity > 1000
+     *   legs[*].currency == "GBP"
+     *
+     * Going through a list, a condition holds if it holds for any element.
+     * Comparing values of different types only ever satisfies !=.
+     *
+     * Each expression is compiled against a reader graph, checking every
+     * field exists, into a Projection of just that path so evaluating it
+     * never decodes anything else. Compile once per schema, not per blob.
+     */
+    class Query {
+        public :
+            enum Op { EQ, NE, LT, LE, GT, GE };
+
+            struct Literal {
+                enum Kind { Null, Bool, Number, String };
+
+                Kind        kind;
+                bool        boolean { false };
+                double      number { 0 };
+                int64_t     integer { 0 };
+                bool        integral { false };
+
+                /**
+                 * As written, less any quotes
+                 */
+                std::string text;
+            };
+
+            struct Condition {
+                std::string path;
+                Op          op;
+                Literal     value;
+            };
+
+            /**
+             * Parse "path op literal", throws std::runtime_error if it
+             * isn't one
+             */
+            static Condition condition (const std::string &);
+
+        private :
+            struct Path {
+                std::string expression;
+
+                /**
+                 * How many fields the path names
+                 */
+                size_t fields { 0 };
+
+                uPtr<Projection> projection;
+            };
+
+            std::vector<Path> m_select;
+            std::vector<std::pair<Path, Condition>> m_where;
+
+        public :
+            /**
+             * Throws std::runtime_error if any path doesn't fit the type
+             * read by the reader
+             */
+            Query (
+                const Reader &,
+                const std::vector<std::string> &,
+                const std::vector<Condition> &);
+
+            Query (const Query &) = delete;
+
+            bool selects() const;
+
+            /**
+             * Whether the object at the cursor satisfies every condition,
+             * the cursor is left where it is
+             */
+            bool matches (codec::Cursor *, const IReader::SchemaType &) const;
+
+            /**
+             * Each selection as a field named for its expression, to be
+             * called with a composite open on the visitor. The cursor is
+             * left where it is.
+             */
+            void select (
+                codec::Cursor *,
+                const IReader::SchemaType &,
+                amqp::reader::IVisitor &) const;
+
+        private :
+            static Path compile (const Reader &, const std::string &, bool);
+    };
+
+}
+
+/******************************************************************************
+ *
+ * class amqp::internal::reader::Queries
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * The same selections and conditions compiled once for each type
+     * found at the root of a blob rather than once per blob. Readers live
+     * as long as the schema cache so their address is as good a key as
+     * any. Safe to share between threads.
+     */
+    class Queries {
+        private :
+            std::vector<std::string>       m_select;
+            std::vector<Query::Condition>  m_where;
+
+            std::mutex m_lock;
+
+            /**
+             * A type the expressions don't fit is remembered with the
+             * reason so we don't try again for every blob of it
+             */
+            std::unordered_map<
+                const Reader *,
+                std::pair<uPtr<Query>, std::string>
+            > m_compiled;
+
+        public :
+            Queries (
+                std::vector<std::string>,
+                std::vector<Query::Condition>);
+
+            /**
+             * The query for objects read by the reader, or nullptr if
+             * the expressions don't fit their type, in which case no
+             * object of it can match. Why not is left in why_ if given.
+             */
+            const Query * compile (const Reader &, std::string * why_ = nullptr);
+    };
+
+}
+
+/******************************************************************************/
+
@@ -3,6 +3,11 @@
 #include <memory>
 #include <sstream>
 
+#include "JsonString.h"
+#include "ValueBuilder.h"
+
+#include "codec/Cursor.h"
+
 /******************************************************************************/
 
 namespace {
@@ -14,7 +19,7 @@ namespace {
                 const std::string & s,
                 std::stringstream & stream_
         ) : m_stream (stream_) {
-            m_stream << s << " : { ";
+            m_stream << amqp::internal::reader::format::quote (s) << " : { ";
         }
 
         explicit AutoMap (std::stringstream & stream_)
@@ -35,7 +40,7 @@ namespace {
                 const std::string & s,
                 std::stringstream & stream_
         ) : m_stream (stream_) {
-            m_stream << s << " : [ ";
+            m_stream << amqp::internal::reader::format::quote (s) << " : [ ";
         }
 
         explicit AutoList (std::stringstream & stream_)
@@ -56,9 +61,9 @@ namespace {
         {
             Auto am (name_, rtn);
 
-            rtn << (*(begin_))->dump();
-            for (auto it(std::next(begin_)) ; it != end_; ++it) {
-                rtn << ", " << (*it)->dump();
+            for (auto it (begin_) ; it != end_ ; ++it) {
+                if (it != begin_) rtn << ", ";
+                rtn << (*it)->dump();
             }
         }
 
@@ -72,9 +77,9 @@ namespace {
         {
             Auto am (rtn);
 
-            rtn << (*(begin_))->dump();
-            for (auto it (std::next(begin_)) ; it != end_; ++it) {
-                rtn << ", " << (*it)->dump();
+            for (auto it (begin_) ; it != end_ ; ++it) {
+                if (it != begin_) rtn << ", ";
+                rtn << (*it)->dump();
             }
         }
 
@@ -152,3 +157,137 @@ TypedSingle<sVec<uPtr<amqp::internal::reader::Single>>>::dump() const {
 }
 
 /******************************************************************************/
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::ArenaScalar
+ *
+ ******************************************************************************/
+
+std::string
+amqp::internal::reader::
+ArenaScalar::dump() const {
+    if (m_named) {
+        std::string rtn;
+        rtn.reserve (m_name.size() + 5 + m_value.size());
+        format::quote (m_name, rtn);
+        rtn.append (" : ").append (m_value);
+        return rtn;
+    }
+
+    return std::string (m_value);
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::ArenaCompound
+ *
+ ******************************************************************************/
+
+std::string
+amqp::internal::reader::
+ArenaCompound::dump() const {
+    auto end = m_values + m_size;
+
+    if (m_named) {
+        std::string name (m_name);
+
+        return m_list
+            ? ::dumpPair<AutoList> (name, m_values, end)
+            : ::dumpPair<AutoMap> (name, m_values, end);
+    }
+
+    return m_list
+        ? ::dumpSingle<AutoList> (m_values, end)
+        : ::dumpSingle<AutoMap> (m_values, end);
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::ValueTree
+ *
+ ******************************************************************************/
+
+std::string
+amqp::internal::reader::
+ValueTree::dump() const {
+    return m_root ? m_root->dump() : std::string();
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::Reader
+ *
+ ******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+Reader::dump (
+    const std::string & name_,
+    codec::Cursor * data_,
+    const SchemaType & schema_
+) const {
+    auto tree = std::make_unique<ValueTree>();
+
+    tree->root (dump (name_, data_, schema_, tree->arena()));
+
+    return tree;
+}
+
+/******************************************************************************/
+
+uPtr<amqp::reader::IValue>
+amqp::internal::reader::
+Reader::dump (
+    codec::Cursor * data_,
+    const SchemaType & schema_
+) const {
+    auto tree = std::make_unique<ValueTree>();
+
+    tree->root (dump (data_, schema_, tree->arena()));
+
+    return tree;
+}
+
+/******************************************************************************/
+
+const amqp::reader::IValue *
+amqp::internal::reader::
+Reader::dump (
+    const std::string & name_,
+    codec::Cursor * data_,
+    const SchemaType & schema_,
+    Arena & arena_
+) const {
+    ValueBuilder builder (arena_, name_);
+
+    visit (data_, schema_, builder);
+
+    return builder.result();
+}
+
+/******************************************************************************/
+
+const amqp::reader::IValue *
+amqp::internal::reader::
+Reader::dump (
+    codec::Cursor * data_,
+    const SchemaType & schema_,
+    Arena & arena_
+) const {
+    ValueBuilder builder (arena_);
+
+    visit (data_, schema_, builder);
+
+    return builder.result();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+Reader::root (codec::Cursor * data_) const {
+    data_->root ([this](codec::Cursor * c_) { read (c_); });
+}
+
+/******************************************************************************/
@@ -2,12 +2,14 @@
 
 /******************************************************************************/
 
-#include <any>
 #include <list>
 #include <string>
 #include <vector>
 #include <memory>
 
+#include "Arena.h"
+#include "JsonString.h"
+
 #include "amqp/schema/Schema.h"
 #include "amqp/reader/IReader.h"
 
@@ -123,7 +125,7 @@ template<>
 inline std::string
 amqp::internal::reader::
 TypedSingle<std::string>::dump() const {
-    return m_value;
+    return format::quote (m_value);
 }
 
 template<>
@@ -156,14 +158,18 @@ template<typename T>
 inline std::string
 amqp::internal::reader::
 TypedPair<T>::dump() const {
-    return m_property + " : " + std::to_string (m_value);
+    return format::quote (m_property) + " : " + std::to_string (m_value);
 }
 
 template<>
 inline std::string
 amqp::internal::reader::
 TypedPair<std::string>::dump() const {
-    return m_property + " : " + m_value;
+    auto rtn = format::quote (m_property);
+    rtn += " : ";
+    format::quote (m_value, rtn);
+
+    return rtn;
 }
 
 template<>
@@ -187,6 +193,102 @@ std::string
 amqp::internal::reader::
 TypedPair<sList<uPtr<amqp::internal::reader::Pair>>>::dump() const;
 
+/******************************************************************************
+ *
+ * Arena allocated values
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * The nodes of a tree of values built by a decode. Unlike the typed
+     * values above everything they reference, names, formatted values and
+     * their children, lives in the Arena they were made in and they are
+     * never destroyed, they simply go when the arena is reset.
+     *
+     * They dump exactly as the equivalent TypedPair / TypedSingle would.
+     */
+    class ArenaScalar : public Value {
+        private :
+            bool             m_named;
+            std::string_view m_name;
+            std::string_view m_value;
+
+        public :
+            explicit ArenaScalar (std::string_view value_)
+                : m_named (false)
+                , m_value (value_)
+            { }
+
+            ArenaScalar (std::string_view name_, std::string_view value_)
+                : m_named (true)
+                , m_name (name_)
+                , m_value (value_)
+            { }
+
+            std::string dump() const override;
+    };
+
+    /**
+     * A composite, dumped as a map, or a list
+     */
+    class ArenaCompound : public Value {
+        private :
+            bool             m_named;
+            bool             m_list;
+            std::string_view m_name;
+
+            const amqp::reader::IValue * const * m_values;
+            size_t                               m_size;
+
+        public :
+            ArenaCompound (
+                bool list_,
+                const amqp::reader::IValue * const * values_,
+                size_t size_
+            ) : m_named (false)
+              , m_list (list_)
+              , m_values (values_)
+              , m_size (size_)
+            { }
+
+            ArenaCompound (
+                std::string_view name_,
+                bool list_,
+                const amqp::reader::IValue * const * values_,
+                size_t size_
+            ) : m_named (true)
+              , m_list (list_)
+              , m_name (name_)
+              , m_values (values_)
+              , m_size (size_)
+            { }
+
+            std::string dump() const override;
+    };
+
+    /**
+     * Owns the arena a tree was built in for those who want the tree
+     * handed back as a single value they can hold on to
+     */
+    class ValueTree : public amqp::reader::IValue {
+        private :
+            Arena                        m_arena;
+            const amqp::reader::IValue * m_root;
+
+        public :
+            ValueTree() : m_root (nullptr) { }
+
+            Arena & arena() { return m_arena; }
+
+            void root (const amqp::reader::IValue * root_) { m_root = root_; }
+
+            std::string dump() const override;
+    };
+
+}
+
 /******************************************************************************
  *
  *
@@ -205,17 +307,63 @@ namespace amqp::internal::reader  {
             const std::string & name() const override = 0;
             const std::string & type() const override = 0;
 
-            std::any read (struct pn_data_t *) const override = 0;
-            std::string readString (struct pn_data_t *) const override = 0;
+            amqp::reader::Variant read (codec::Cursor *) const override = 0;
+            std::string readString (codec::Cursor *) const override = 0;
 
+            /**
+             * Every reader builds its tree of values by visiting the blob
+             * with a ValueBuilder so only visit needs implementing
+             */
             uPtr<amqp::reader::IValue> dump(
                 const std::string &,
-                pn_data_t *,
-                const SchemaType &) const override = 0;
+                codec::Cursor *,
+                const SchemaType &) const override;
 
             uPtr<amqp::reader::IValue> dump(
-                pn_data_t *,
-                const SchemaType &) const override = 0;
+                codec::Cursor *,
+                const SchemaType &) const override;
+
+            /**
+             * Build the tree in a caller supplied arena, it's only valid
+             * until that's reset. Callers decoding many blobs should
+             * prefer these, resetting the arena between each, over the
+             * above which need a fresh arena every time.
+             */
+            const amqp::reader::IValue * dump(
+                const std::string &,
+                codec::Cursor *,
+                const SchemaType &,
+                Arena &) const;
+
+            const amqp::reader::IValue * dump(
+                codec::Cursor *,
+                const SchemaType &,
+                Arena &) const;
+
+            void visit (
+                codec::Cursor *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override = 0;
+
+            /**
+             * Readers are built as a graph of weak references since, until
+             * the factory has finished, they may be shared and replaced.
+             * Once it has, freezing resolves those references into plain
+             * pointers so reading never has to touch a reference count.
+             * Those pointers are only valid for as long as the factory
+             * that owns the readers.
+             *
+             * Readers that reference no others have nothing to do.
+             */
+            virtual void freeze() { }
+
+            /**
+             * Readers of anything that can hold a back reference start
+             * with this, see codec::Cursor::root, so should the value at
+             * the cursor be a blob's root it's this reader that reads it
+             * again to number the blob's objects
+             */
+            void root (codec::Cursor *) const;
     };
 
 }
@@ -2,7 +2,7 @@
 
 #include <iostream>
 
-#include "proton/proton_wrapper.h"
+#include "codec/codec_wrapper.h"
 
 #include "amqp/reader/IReader.h"
 #include "amqp/reader/Reader.h"
@@ -24,17 +24,9 @@ RestrictedReader::m_name { // NOLINT
 
 /******************************************************************************/
 
-std::any
-amqp::internal::reader::
-RestrictedReader::read (pn_data_t *) const {
-    return std::any(1);
-}
-
-/******************************************************************************/
-
 std::string
 amqp::internal::reader::
-RestrictedReader::readString (pn_data_t * data_) const {
+RestrictedReader::readString (codec::Cursor * data_) const {
     return "hello";
 }
 
@@ -4,14 +4,17 @@
 
 #include "Reader.h"
 
-#include <any>
 #include <vector>
 
 #include "amqp/schema/restricted-types/Restricted.h"
 
 /******************************************************************************/
 
-struct pn_data_t;
+namespace codec {
+
+    class Cursor;
+
+}
 
 /******************************************************************************/
 
@@ -26,14 +29,14 @@ namespace amqp::internal::reader {
             explicit RestrictedReader (std::string);
             ~RestrictedReader() override = default;
 
-            std::any read(pn_data_t *) const override ;
+            amqp::reader::Variant read (codec::Cursor *) const override = 0;
 
-            std::string readString(pn_data_t *) const override;
+            std::string readString(codec::Cursor *) const override;
 
-            std::unique_ptr<amqp::reader::IValue> dump(
-                const std::string &,
-                pn_data_t *,
-                const SchemaType &) const override = 0;
+            void visit (
+                codec::Cursor *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override = 0;
 
             const std::string & name() const override;
             const std::string & type() const override;
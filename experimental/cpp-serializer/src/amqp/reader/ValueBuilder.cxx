@@ -0,0 +1,259 @@
+#include "ValueBuilder.h"
+#include "Formats.h"
+#include "JsonString.h"
+
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
+
+/******************************************************************************
+ *
+ * amqp::internal::reader::ValueBuilder
+ *
+ ******************************************************************************/
+
+amqp::internal::reader::
+ValueBuilder::ValueBuilder (Arena & arena_)
+    : m_arena (arena_)
+    , m_named (false)
+    , m_result (nullptr)
+{ }
+
+/******************************************************************************/
+
+amqp::internal::reader::
+ValueBuilder::ValueBuilder (Arena & arena_, std::string_view name_)
+    : m_arena (arena_)
+    , m_named (true)
+    , m_name (arena_.copy (name_))
+    , m_result (nullptr)
+{ }
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+ValueBuilder::beginComposite (const std::string &) {
+    begin (false);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+ValueBuilder::endComposite() {
+    end();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+ValueBuilder::beginList() {
+    begin (true);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+ValueBuilder::endList() {
+    end();
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+ValueBuilder::field (const std::string & name_) {
+    m_named = true;
+    m_name = m_arena.copy (name_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+ValueBuilder::value (int32_t val_) {
+    value (static_cast<int64_t>(val_));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+ValueBuilder::value (int64_t val_) {
+    char buf[24];
+    auto res = std::to_chars (buf, buf + sizeof (buf), val_);
+
+    add (m_arena.copy (std::string_view (buf, res.ptr - buf)));
+}
+
+/******************************************************************************/
+
+/**
+ * Formatted as std::to_string always has, which can run to a few hundred
+ * characters for very large values
+ */
+void
+amqp::internal::reader::
+ValueBuilder::value (double val_) {
+    auto sz = snprintf (nullptr, 0, "%f", val_);
+    auto * p = m_arena.array<char> (sz + 1);
+    snprintf (p, sz + 1, "%f", val_);
+
+    add (std::string_view (p, sz));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+ValueBuilder::value (bool val_) {
+    add (val_ ? "1" : "0");
+}
+
+/******************************************************************************/
+
+/**
+ * Quoted and, should it need it, escaped, the common case of nothing
+ * to escape going straight into the arena
+ */
+void
+amqp::internal::reader::
+ValueBuilder::value (std::string_view val_) {
+    if (format::plain (val_) != val_.size()) {
+        m_scratch.clear();
+        format::quote (val_, m_scratch);
+        add (m_arena.copy (m_scratch));
+
+        return;
+    }
+
+    auto * p = m_arena.array<char> (val_.size() + 2);
+
+    p[0] = '"';
+    memcpy (p + 1, val_.data(), val_.size());
+    p[val_.size() + 1] = '"';
+
+    add (std::string_view (p, val_.size() + 2));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+ValueBuilder::value (uint64_t val_) {
+    char buf[24];
+    auto res = std::to_chars (buf, buf + sizeof (buf), val_);
+
+    add (m_arena.copy (std::string_view (buf, res.ptr - buf)));
+}
+
+/******************************************************************************/
+
+/**
+ * Quoted as strings are, as base64
+ */
+void
+amqp::internal::reader::
+ValueBuilder::binary (std::string_view bytes_) {
+    value (std::string_view (format::base64 (bytes_)));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+ValueBuilder::timestamp (int64_t millis_) {
+    value (std::string_view (format::timestamp (millis_)));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+ValueBuilder::null() {
+    add ("null");
+}
+
+/******************************************************************************/
+
+const amqp::reader::IValue *
+amqp::internal::reader::
+ValueBuilder::result() const {
+    return m_result;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+ValueBuilder::begin (bool list_) {
+    m_stack.push_back (Frame { list_, m_named, m_name, m_values.size() });
+    m_named = false;
+    m_name = { };
+}
+
+/******************************************************************************/
+
+/**
+ * Composites have always been dumped as maps of their properties and
+ * lists as lists of their elements
+ */
+void
+amqp::internal::reader::
+ValueBuilder::end() {
+    if (m_stack.empty()) {
+        throw std::runtime_error ("Unbalanced end of a composite or list");
+    }
+
+    auto frame = m_stack.back();
+    m_stack.pop_back();
+
+    auto size = m_values.size() - frame.start;
+    auto * values = m_arena.array<const amqp::reader::IValue *> (size);
+
+    std::copy (m_values.begin() + frame.start, m_values.end(), values);
+    m_values.resize (frame.start);
+
+    if (frame.named) {
+        emit (m_arena.make<ArenaCompound> (frame.name, frame.list, values, size));
+    } else {
+        emit (m_arena.make<ArenaCompound> (frame.list, values, size));
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Scalars are either string literals or have already been formatted into
+ * the arena
+ */
+void
+amqp::internal::reader::
+ValueBuilder::add (std::string_view val_) {
+    if (m_named) {
+        emit (m_arena.make<ArenaScalar> (m_name, val_));
+        m_named = false;
+        m_name = { };
+    } else {
+        emit (m_arena.make<ArenaScalar> (val_));
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+ValueBuilder::emit (const amqp::reader::IValue * val_) {
+    if (m_stack.empty()) {
+        m_result = val_;
+    } else {
+        m_values.push_back (val_);
+    }
+}
+
+/******************************************************************************/
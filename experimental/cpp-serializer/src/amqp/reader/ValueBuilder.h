@@ -0,0 +1,109 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <vector>
+#include <string_view>
+
+#include "types.h"
+#include "Arena.h"
+#include "Reader.h"
+#include "amqp/reader/IVisitor.h"
+
+/******************************************************************************
+ *
+ * class amqp::internal::reader::ValueBuilder
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Rebuilds, from the events of a visit, the tree of values the
+     * readers' dump methods have always returned. It's how dump is
+     * implemented, anyone wanting the tree can keep using that, anyone
+     * who doesn't shouldn't use this.
+     *
+     * Every node, name and formatted value is made in the given arena,
+     * the tree is only valid for as long as the arena isn't reset.
+     */
+    class ValueBuilder : public amqp::reader::IVisitor {
+        private :
+            struct Frame {
+                bool             list;
+                bool             named;
+                std::string_view name;
+
+                /**
+                 * Where this frame's values start in m_values
+                 */
+                size_t           start;
+            };
+
+            Arena & m_arena;
+
+            std::vector<Frame> m_stack;
+
+            /**
+             * The values of every open frame, innermost last. A frame's
+             * values are copied into the arena when it closes.
+             */
+            std::vector<const amqp::reader::IValue *> m_values;
+
+            /**
+             * The name given by the last call to field, to be consumed
+             * by whatever value comes next
+             */
+            bool             m_named;
+            std::string_view m_name;
+
+            const amqp::reader::IValue * m_result;
+
+            /**
+             * Where strings needing escaping are escaped before going
+             * into the arena
+             */
+            std::string m_scratch;
+
+        public :
+            explicit ValueBuilder (Arena &);
+
+            /**
+             * Build a tree whose root is a named pair
+             */
+            ValueBuilder (Arena &, std::string_view);
+
+            void beginComposite (const std::string &) override;
+            void endComposite() override;
+
+            void beginList() override;
+            void endList() override;
+
+            void field (const std::string &) override;
+
+            void value (int32_t) override;
+            void value (int64_t) override;
+            void value (double) override;
+            void value (bool) override;
+            void value (std::string_view) override;
+            void value (uint64_t) override;
+
+            void binary (std::string_view) override;
+            void timestamp (int64_t) override;
+
+            void null() override;
+
+            const amqp::reader::IValue * result() const;
+
+        private :
+            void begin (bool);
+            void end();
+            void add (std::string_view);
+            void emit (const amqp::reader::IValue *);
+    };
+
+}
+
+/******************************************************************************/
+
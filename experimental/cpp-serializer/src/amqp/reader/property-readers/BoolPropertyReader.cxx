@@ -1,6 +1,6 @@
 #include "BoolPropertyReader.h"
 
-#include "proton/proton_wrapper.h"
+#include "codec/codec_wrapper.h"
 
 /******************************************************************************
  *
@@ -19,7 +19,7 @@ const std::string
 const std::string
         amqp::internal::reader::
         BoolPropertyReader::m_type { // NOLINT
-        "bool"
+        "boolean"
 };
 
 /******************************************************************************
@@ -28,44 +28,30 @@ const std::string
  *
  ******************************************************************************/
 
-std::any
+amqp::reader::Variant
 amqp::internal::reader::
-BoolPropertyReader::read (pn_data_t * data_) const {
-    return std::any (true);
+BoolPropertyReader::read (codec::Cursor * data_) const {
+    return amqp::reader::Variant (codec::readAndNext<bool> (data_));
 }
 
 /******************************************************************************/
 
 std::string
 amqp::internal::reader::
-BoolPropertyReader::readString (pn_data_t * data_) const {
-    return std::to_string (proton::readAndNext<bool> (data_));
+BoolPropertyReader::readString (codec::Cursor * data_) const {
+    return std::to_string (codec::readAndNext<bool> (data_));
 }
 
 /******************************************************************************/
 
-uPtr<amqp::reader::IValue>
+void
 amqp::internal::reader::
-BoolPropertyReader::dump (
-        const std::string & name_,
-        pn_data_t * data_,
-        const SchemaType & schema_) const
+BoolPropertyReader::visit (
+        codec::Cursor * data_,
+        const SchemaType & schema_,
+        amqp::reader::IVisitor & visitor_) const
 {
-    return std::make_unique<TypedPair<std::string>> (
-            name_,
-            std::to_string (proton::readAndNext<bool> (data_)));
-}
-
-/******************************************************************************/
-
-uPtr<amqp::reader::IValue>
-amqp::internal::reader::
-BoolPropertyReader::dump (
-        pn_data_t * data_,
-        const SchemaType & schema_) const
-{
-    return std::make_unique<TypedSingle<std::string>> (
-            std::to_string (proton::readAndNext<bool> (data_)));
+    visitor_.value (codec::readAndNext<bool> (data_));
 }
 
 /******************************************************************************/
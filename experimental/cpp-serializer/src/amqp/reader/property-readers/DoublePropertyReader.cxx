@@ -1,6 +1,6 @@
 #include "DoublePropertyReader.h"
 
-#include "proton/proton_wrapper.h"
+#include "codec/codec_wrapper.h"
 
 /******************************************************************************
  *
@@ -26,44 +26,30 @@ DoublePropertyReader::m_type { // NOLINT
  *
  ******************************************************************************/
 
-std::any
+amqp::reader::Variant
 amqp::internal::reader::
-DoublePropertyReader::read (pn_data_t * data_) const {
-    return std::any (10.0);
+DoublePropertyReader::read (codec::Cursor * data_) const {
+    return amqp::reader::Variant (codec::readAndNext<double> (data_));
 }
 
 /******************************************************************************/
 
 std::string
 amqp::internal::reader::
-DoublePropertyReader::readString (pn_data_t * data_) const {
-    return std::to_string (proton::readAndNext<double> (data_));
+DoublePropertyReader::readString (codec::Cursor * data_) const {
+    return std::to_string (codec::readAndNext<double> (data_));
 }
 
 /******************************************************************************/
 
-uPtr<amqp::reader::IValue>
+void
 amqp::internal::reader::
-DoublePropertyReader::dump (
-        const std::string & name_,
-        pn_data_t * data_,
-        const SchemaType & schema_) const
+DoublePropertyReader::visit (
+        codec::Cursor * data_,
+        const SchemaType & schema_,
+        amqp::reader::IVisitor & visitor_) const
 {
-    return std::make_unique<TypedPair<std::string>> (
-            name_,
-            std::to_string (proton::readAndNext<double> (data_)));
-}
-
-/******************************************************************************/
-
-uPtr<amqp::reader::IValue>
-amqp::internal::reader::
-DoublePropertyReader::dump (
-        pn_data_t * data_,
-        const SchemaType & schema_) const
-{
-    return std::make_unique<TypedSingle<std::string>> (
-            std::to_string (proton::readAndNext<double> (data_)));
+    visitor_.value (codec::readAndNext<double> (data_));
 }
 
 /******************************************************************************/
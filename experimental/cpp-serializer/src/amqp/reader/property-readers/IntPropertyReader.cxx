@@ -1,11 +1,9 @@
 
 #include "IntPropertyReader.h"
 
-#include <any>
 #include <string>
-#include <proton/codec.h>
 
-#include "proton/proton_wrapper.h"
+#include "codec/codec_wrapper.h"
 #include "amqp/reader/IReader.h"
 
 /******************************************************************************
@@ -34,44 +32,30 @@ IntPropertyReader::m_type { // NOLINT
  *
  ******************************************************************************/
 
-std::any
+amqp::reader::Variant
 amqp::internal::reader::
-IntPropertyReader::read (pn_data_t * data_) const {
-    return std::any (1);
+IntPropertyReader::read (codec::Cursor * data_) const {
+    return amqp::reader::Variant (codec::readAndNext<int32_t> (data_));
 }
 
 /******************************************************************************/
 
 std::string
 amqp::internal::reader::
-IntPropertyReader::readString (pn_data_t * data_) const {
-    return std::to_string (proton::readAndNext<int> (data_));
+IntPropertyReader::readString (codec::Cursor * data_) const {
+    return std::to_string (codec::readAndNext<int> (data_));
 }
 
 /******************************************************************************/
 
-uPtr<amqp::reader::IValue>
+void
 amqp::internal::reader::
-IntPropertyReader::dump (
-        const std::string & name_,
-        pn_data_t * data_,
-        const SchemaType & schema_) const
+IntPropertyReader::visit (
+        codec::Cursor * data_,
+        const SchemaType & schema_,
+        amqp::reader::IVisitor & visitor_) const
 {
-    return std::make_unique<TypedPair<std::string>> (
-            name_,
-            std::to_string (proton::readAndNext<int> (data_)));
-}
-
-/******************************************************************************/
-
-uPtr<amqp::reader::IValue>
-amqp::internal::reader::
-IntPropertyReader::dump (
-        pn_data_t * data_,
-        const SchemaType & schema_) const
-{
-    return std::make_unique<TypedSingle<std::string>> (
-            std::to_string (proton::readAndNext<int> (data_)));
+    visitor_.value (codec::readAndNext<int32_t> (data_));
 }
 
 /******************************************************************************/
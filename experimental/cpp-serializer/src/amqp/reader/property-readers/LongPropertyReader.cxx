@@ -1,6 +1,6 @@
 #include "LongPropertyReader.h"
 
-#include "proton/proton_wrapper.h"
+#include "codec/codec_wrapper.h"
 
 /******************************************************************************
  *
@@ -28,44 +28,30 @@ const std::string
  *
  ******************************************************************************/
 
-std::any
+amqp::reader::Variant
 amqp::internal::reader::
-LongPropertyReader::read (pn_data_t * data_) const {
-    return std::any (10L);
+LongPropertyReader::read (codec::Cursor * data_) const {
+    return amqp::reader::Variant (static_cast<int64_t> (codec::readAndNext<long> (data_)));
 }
 
 /******************************************************************************/
 
 std::string
 amqp::internal::reader::
-LongPropertyReader::readString (pn_data_t * data_) const {
-    return std::to_string (proton::readAndNext<long> (data_));
+LongPropertyReader::readString (codec::Cursor * data_) const {
+    return std::to_string (codec::readAndNext<long> (data_));
 }
 
 /******************************************************************************/
 
-uPtr<amqp::reader::IValue>
+void
 amqp::internal::reader::
-LongPropertyReader::dump (
-        const std::string & name_,
-        pn_data_t * data_,
-        const SchemaType & schema_) const
+LongPropertyReader::visit (
+        codec::Cursor * data_,
+        const SchemaType & schema_,
+        amqp::reader::IVisitor & visitor_) const
 {
-    return std::make_unique<TypedPair<std::string>> (
-            name_,
-            std::to_string (proton::readAndNext<long> (data_)));
-}
-
-/******************************************************************************/
-
-uPtr<amqp::reader::IValue>
-amqp::internal::reader::
-LongPropertyReader::dump (
-        pn_data_t * data_,
-        const SchemaType & schema_) const
-{
-    return std::make_unique<TypedSingle<std::string>> (
-            std::to_string (proton::readAndNext<long> (data_)));
+    visitor_.value (static_cast<int64_t> (codec::readAndNext<long> (data_)));
 }
 
 /******************************************************************************/
@@ -14,19 +14,14 @@ namespace amqp::internal::reader {
             static const std::string m_type;
 
         public :
-            std::string readString (pn_data_t *) const override;
+            std::string readString (codec::Cursor *) const override;
 
-            std::any read (pn_data_t *) const override;
+            amqp::reader::Variant read (codec::Cursor *) const override;
 
-            uPtr<amqp::reader::IValue> dump(
-                const std::string &,
-                pn_data_t *,
-                const SchemaType &
-            ) const override;
-
-            uPtr<amqp::reader::IValue> dump(
-                pn_data_t *,
-                const SchemaType &
+            void visit (
+                codec::Cursor *,
+                const SchemaType &,
+                amqp::reader::IVisitor &
             ) const override;
 
             const std::string & name() const override;
@@ -0,0 +1,274 @@
+#include "PrimitivePropertyReader.h"
+
+#include <array>
+#include <string>
+#include <stdexcept>
+
+#include "codec/codec_wrapper.h"
+#include "amqp/reader/Formats.h"
+#include "amqp/reader/IReader.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace codec;
+
+    using amqp::reader::Binary;
+    using amqp::reader::Variant;
+    using amqp::reader::IVisitor;
+
+    using Ops = amqp::internal::reader::PrimitivePropertyReader::Ops;
+
+    namespace format = amqp::internal::reader::format;
+
+    constexpr bool
+    binary (type_t code_) {
+        return code_ == AMQP_BINARY
+            || code_ == AMQP_DECIMAL32
+            || code_ == AMQP_DECIMAL64
+            || code_ == AMQP_DECIMAL128;
+    }
+
+    /*
+     * The current value as whichever type IVisitor and Variant hold it as
+     */
+    template<type_t C>
+    auto
+    get (const Cursor & c_) {
+        if constexpr (C == AMQP_UBYTE) return static_cast<int32_t>(c_.getUByte());
+        else if constexpr (C == AMQP_BYTE) return static_cast<int32_t>(c_.getByte());
+        else if constexpr (C == AMQP_USHORT) return static_cast<int32_t>(c_.getUShort());
+        else if constexpr (C == AMQP_SHORT) return static_cast<int32_t>(c_.getShort());
+        else if constexpr (C == AMQP_UINT) return static_cast<int64_t>(c_.getUInt());
+        else if constexpr (C == AMQP_ULONG) return c_.getULong();
+        else if constexpr (C == AMQP_FLOAT) return static_cast<double>(c_.getFloat());
+        else if constexpr (C == AMQP_TIMESTAMP) return c_.getTimestamp();
+        else if constexpr (C == AMQP_CHAR) return c_.getChar();
+        else if constexpr (C == AMQP_UUID) return c_.getUuid();
+        else if constexpr (C == AMQP_SYMBOL) return c_.getSymbol();
+        else if constexpr (C == AMQP_BINARY) return Binary { c_.getBinary() };
+        else return Binary { c_.getDecimal() };
+    }
+
+    template<type_t C>
+    void
+    visit (Cursor * data_, IVisitor & visitor_) {
+        auto_next an (data_);
+
+        if (data_->type() == AMQP_NULL) {
+            visitor_.null();
+            return;
+        }
+
+        auto value = get<C> (*data_);
+
+        if constexpr (C == AMQP_TIMESTAMP) {
+            visitor_.timestamp (value);
+        } else if constexpr (C == AMQP_CHAR) {
+            char buf[4];
+            visitor_.value (format::utf8 (value, buf));
+        } else if constexpr (C == AMQP_UUID) {
+            char buf[36];
+            visitor_.value (format::uuid (value, buf));
+        } else if constexpr (binary (C)) {
+            visitor_.binary (value.bytes);
+        } else {
+            visitor_.value (value);
+        }
+    }
+
+    template<type_t C>
+    Variant
+    read (Cursor * data_) {
+        auto_next an (data_);
+
+        if (data_->type() == AMQP_NULL) {
+            return Variant();
+        }
+
+        auto value = get<C> (*data_);
+
+        if constexpr (C == AMQP_CHAR) {
+            char buf[4];
+            return Variant (std::string (format::utf8 (value, buf)));
+        } else if constexpr (C == AMQP_UUID) {
+            char buf[36];
+            return Variant (std::string (format::uuid (value, buf)));
+        } else if constexpr (C == AMQP_SYMBOL) {
+            return Variant (std::string (value));
+        } else {
+            return Variant (value);
+        }
+    }
+
+    template<type_t C>
+    std::string
+    readString (Cursor * data_) {
+        auto_next an (data_);
+
+        if (data_->type() == AMQP_NULL) {
+            return "null";
+        }
+
+        auto value = get<C> (*data_);
+
+        if constexpr (C == AMQP_TIMESTAMP) {
+            return format::timestamp (value);
+        } else if constexpr (C == AMQP_CHAR) {
+            char buf[4];
+            return std::string (format::utf8 (value, buf));
+        } else if constexpr (C == AMQP_UUID) {
+            char buf[36];
+            return std::string (format::uuid (value, buf));
+        } else if constexpr (C == AMQP_SYMBOL) {
+            return std::string (value);
+        } else if constexpr (binary (C)) {
+            return format::base64 (value.bytes);
+        } else {
+            return std::to_string (value);
+        }
+    }
+
+    template<type_t C>
+    constexpr Ops
+    ops() {
+        return Ops { &visit<C>, &read<C>, &readString<C> };
+    }
+
+    /*
+     * Indexed by type code, empty for those that aren't ours
+     */
+    const std::array<Ops, AMQP_MAP + 1> table { // NOLINT
+        []() {
+            std::array<Ops, AMQP_MAP + 1> rtn { };
+
+            rtn[AMQP_UBYTE]      = ops<AMQP_UBYTE>();
+            rtn[AMQP_BYTE]       = ops<AMQP_BYTE>();
+            rtn[AMQP_USHORT]     = ops<AMQP_USHORT>();
+            rtn[AMQP_SHORT]      = ops<AMQP_SHORT>();
+            rtn[AMQP_UINT]       = ops<AMQP_UINT>();
+            rtn[AMQP_CHAR]       = ops<AMQP_CHAR>();
+            rtn[AMQP_ULONG]      = ops<AMQP_ULONG>();
+            rtn[AMQP_TIMESTAMP]  = ops<AMQP_TIMESTAMP>();
+            rtn[AMQP_FLOAT]      = ops<AMQP_FLOAT>();
+            rtn[AMQP_DECIMAL32]  = ops<AMQP_DECIMAL32>();
+            rtn[AMQP_DECIMAL64]  = ops<AMQP_DECIMAL64>();
+            rtn[AMQP_DECIMAL128] = ops<AMQP_DECIMAL128>();
+            rtn[AMQP_UUID]       = ops<AMQP_UUID>();
+            rtn[AMQP_BINARY]     = ops<AMQP_BINARY>();
+            rtn[AMQP_SYMBOL]     = ops<AMQP_SYMBOL>();
+
+            return rtn;
+        }()
+    };
+
+    const Ops &
+    lookup (type_t code_) {
+        if (!amqp::internal::reader::PrimitivePropertyReader::handles (code_)) {
+            throw std::runtime_error (
+                std::string ("No primitive reader for type ") + type_name (code_));
+        }
+
+        return table[code_];
+    }
+
+}
+
+/******************************************************************************
+ *
+ * PrimitivePropertyReader statics
+ *
+ ******************************************************************************/
+
+const std::string
+amqp::internal::reader::
+PrimitivePropertyReader::m_name { // NOLINT
+    "Primitive Reader"
+};
+
+/******************************************************************************/
+
+bool
+amqp::internal::reader::
+PrimitivePropertyReader::handles (codec::type_t code_) {
+    return code_ > 0 && code_ < static_cast<int>(table.size()) && table[code_].visit;
+}
+
+/******************************************************************************
+ *
+ * PrimitivePropertyReader
+ *
+ ******************************************************************************/
+
+amqp::internal::reader::
+PrimitivePropertyReader::PrimitivePropertyReader (codec::type_t code_)
+    : m_type (codec::type_name (code_))
+    , m_ops (lookup (code_))
+{ }
+
+/******************************************************************************/
+
+/**
+ * Timestamps, uuids, symbols and decimals are objects as far as the JVM
+ * is concerned so may be back references, see codec::References
+ */
+amqp::reader::Variant
+amqp::internal::reader::
+PrimitivePropertyReader::read (codec::Cursor * data_) const {
+    if (codec::auto_resolve ref (data_); ref) {
+        return read (ref.object());
+    }
+
+    return m_ops.read (data_);
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+PrimitivePropertyReader::readString (codec::Cursor * data_) const {
+    if (codec::auto_resolve ref (data_); ref) {
+        return readString (ref.object());
+    }
+
+    return m_ops.readString (data_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+PrimitivePropertyReader::visit (
+        codec::Cursor * data_,
+        const SchemaType & schema_,
+        amqp::reader::IVisitor & visitor_) const
+{
+    if (codec::auto_resolve ref (data_); ref) {
+        if (!visitor_.reference (ref.index())) {
+            visit (ref.object(), schema_, visitor_);
+        }
+
+        return;
+    }
+
+    m_ops.visit (data_, visitor_);
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+PrimitivePropertyReader::name() const {
+    return m_name;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::reader::
+PrimitivePropertyReader::type() const {
+    return m_type;
+}
+
+/******************************************************************************/
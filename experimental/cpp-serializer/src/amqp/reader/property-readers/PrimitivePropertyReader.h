@@ -0,0 +1,66 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "PropertyReader.h"
+
+#include "codec/Cursor.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Every primitive without a reader of its own, binary, byte, short,
+     * char, float, the unsigned integers, timestamp, uuid, symbol and the
+     * decimals. How each is read is looked up, once, by its type code in
+     * a table, leaving nothing to decide per value.
+     *
+     * Binary, and decimals, are handed over as views of the blob, never
+     * copied. Nulls, which the JVM writes for any nullable field, are
+     * passed on as such.
+     */
+    class PrimitivePropertyReader : public PropertyReader {
+        public :
+            struct Ops {
+                void (*visit) (codec::Cursor *, amqp::reader::IVisitor &);
+                amqp::reader::Variant (*read) (codec::Cursor *);
+                std::string (*readString) (codec::Cursor *);
+            };
+
+        private :
+            static const std::string m_name;
+
+            std::string m_type;
+            const Ops & m_ops;
+
+        public :
+            /**
+             * Throws std::runtime_error for any code not in the table
+             */
+            explicit PrimitivePropertyReader (codec::type_t);
+
+            ~PrimitivePropertyReader() override = default;
+
+            /**
+             * Whether there's an entry in the table for the type
+             */
+            static bool handles (codec::type_t);
+
+            std::string readString (codec::Cursor *) const override;
+
+            amqp::reader::Variant read (codec::Cursor *) const override;
+
+            void visit (
+                    codec::Cursor *,
+                    const SchemaType &,
+                    amqp::reader::IVisitor &
+            ) const override;
+
+            const std::string & name() const override;
+            const std::string & type() const override;
+    };
+
+}
+
+/******************************************************************************/
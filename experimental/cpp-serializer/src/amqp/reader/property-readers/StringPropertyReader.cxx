@@ -1,8 +1,7 @@
 #include "StringPropertyReader.h"
 
-#include <proton/codec.h>
 
-#include "proton/proton_wrapper.h"
+#include "codec/codec_wrapper.h"
 
 /******************************************************************************
  *
@@ -30,44 +29,46 @@ const std::string
  *
  ******************************************************************************/
 
-std::any
+amqp::reader::Variant
 amqp::internal::reader::
-StringPropertyReader::read (pn_data_t * data_) const {
-    return std::any ("hello");
+StringPropertyReader::read (codec::Cursor * data_) const {
+    if (codec::auto_resolve ref (data_); ref) {
+        return read (ref.object());
+    }
+
+    return amqp::reader::Variant (codec::readAndNext<std::string> (data_));
 }
 
 /******************************************************************************/
 
 std::string
 amqp::internal::reader::
-StringPropertyReader::readString (pn_data_t * data_) const {
-    return proton::readAndNext<std::string> (data_);
+StringPropertyReader::readString (codec::Cursor * data_) const {
+    if (codec::auto_resolve ref (data_); ref) {
+        return readString (ref.object());
+    }
+
+    return codec::readAndNext<std::string> (data_);
 }
 
 /******************************************************************************/
 
-uPtr<amqp::reader::IValue>
+void
 amqp::internal::reader::
-StringPropertyReader::dump (
-        const std::string & name_,
-        pn_data_t * data_,
-        const SchemaType & schema_) const
+StringPropertyReader::visit (
+        codec::Cursor * data_,
+        const SchemaType & schema_,
+        amqp::reader::IVisitor & visitor_) const
 {
-    return std::make_unique<TypedPair<std::string>> (
-            name_,
-            "\"" + proton::readAndNext<std::string> (data_) + "\"");
-}
+    if (codec::auto_resolve ref (data_); ref) {
+        if (!visitor_.reference (ref.index())) {
+            visit (ref.object(), schema_, visitor_);
+        }
 
-/******************************************************************************/
+        return;
+    }
 
-uPtr<amqp::reader::IValue>
-amqp::internal::reader::
-StringPropertyReader::dump (
-        pn_data_t * data_,
-        const SchemaType & schema_) const
-{
-    return std::make_unique<TypedSingle<std::string>> (
-            "\"" + proton::readAndNext<std::string> (data_) + "\"");
+    visitor_.value (codec::readAndNext<std::string_view> (data_));
 }
 
 /******************************************************************************/
@@ -0,0 +1,115 @@
+#include "EnumReader.h"
+
+#include <sstream>
+#include <stdexcept>
+
+#include "codec/codec_wrapper.h"
+
+/******************************************************************************
+ *
+ * class EnumReader
+ *
+ ******************************************************************************/
+
+amqp::internal::schema::Restricted::RestrictedTypes
+amqp::internal::reader::
+EnumReader::restrictedType() const {
+    return internal::schema::Restricted::RestrictedTypes::Enum;
+}
+
+/******************************************************************************/
+
+const std::vector<std::string> &
+amqp::internal::reader::
+EnumReader::choices() const {
+    return m_choices;
+}
+
+/******************************************************************************/
+
+/**
+ * Shared with the binding's decoding of enums, see binding::Member
+ */
+uint32_t
+amqp::internal::reader::
+EnumReader::ordinal (codec::Cursor * data_, const std::string & type_, size_t count_) {
+    codec::auto_next an (data_);
+    codec::is_described (data_);
+
+    // skip the descriptor and, in the list, the constant's name
+    codec::auto_enter ae (data_, true);
+    codec::auto_list_enter ale (data_, true);
+
+    data_->next();
+
+    if (data_->type() != codec::AMQP_INT) {
+        throw std::runtime_error ("Expected the ordinal of a " + type_);
+    }
+
+    auto ordinal = static_cast<uint32_t>(data_->getInt());
+
+    if (ordinal >= count_) {
+        std::stringstream s;
+        s << type_ << " has no constant with ordinal " << data_->getInt();
+        throw std::runtime_error (s.str());
+    }
+
+    return ordinal;
+}
+
+/******************************************************************************/
+
+/**
+ * The name of the constant the cursor is on, moving past it
+ */
+const std::string &
+amqp::internal::reader::
+EnumReader::constant (codec::Cursor * data_) const {
+    return m_choices[ordinal (data_, type(), m_choices.size())];
+}
+
+/******************************************************************************/
+
+amqp::reader::Variant
+amqp::internal::reader::
+EnumReader::read (codec::Cursor * data_) const {
+    if (codec::auto_resolve ref (data_); ref) {
+        return read (ref.object());
+    }
+
+    return amqp::reader::Variant (constant (data_));
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::reader::
+EnumReader::readString (codec::Cursor * data_) const {
+    if (codec::auto_resolve ref (data_); ref) {
+        return readString (ref.object());
+    }
+
+    return constant (data_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+EnumReader::visit (
+        codec::Cursor * data_,
+        const SchemaType & schema_,
+        amqp::reader::IVisitor & visitor_
+) const {
+    if (codec::auto_resolve ref (data_); ref) {
+        if (!visitor_.reference (ref.index())) {
+            visit (ref.object(), schema_, visitor_);
+        }
+
+        return;
+    }
+
+    visitor_.value (std::string_view (constant (data_)));
+}
+
+/******************************************************************************/
@@ -0,0 +1,59 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "RestrictedReader.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Enums are reported as the name of their constant. The JVM writes
+     * an instance as that name followed by its ordinal, only the
+     * ordinal is read, it indexes the names the schema gave so there's
+     * no string to compare or copy.
+     */
+    class EnumReader : public RestrictedReader {
+        private :
+            /**
+             * Indexed by ordinal, see schema::Enum
+             */
+            std::vector<std::string> m_choices;
+
+        public :
+            EnumReader (
+                const std::string & type_,
+                std::vector<std::string> choices_
+            ) : RestrictedReader (type_)
+              , m_choices (std::move (choices_))
+            { }
+
+            ~EnumReader() final = default;
+
+            internal::schema::Restricted::RestrictedTypes restrictedType() const;
+
+            const std::vector<std::string> & choices() const;
+
+            /**
+             * The ordinal of the constant of type_ the cursor is on,
+             * moving past it. Throws std::runtime_error unless there
+             * are more than that many, count_, constants.
+             */
+            static uint32_t ordinal (codec::Cursor *, const std::string & type_, size_t count_);
+
+            amqp::reader::Variant read (codec::Cursor *) const override;
+            std::string readString (codec::Cursor *) const override;
+
+            void visit (
+                codec::Cursor *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+
+        private :
+            const std::string & constant (codec::Cursor *) const;
+    };
+
+}
+
+/******************************************************************************/
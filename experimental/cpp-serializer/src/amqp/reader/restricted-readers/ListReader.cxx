@@ -1,6 +1,78 @@
 #include "ListReader.h"
 
-#include "proton/proton_wrapper.h"
+#include <vector>
+#include <stdexcept>
+
+#include "codec/Bulk.h"
+#include "codec/codec_wrapper.h"
+
+#include "amqp/reader/Formats.h"
+#include "amqp/reader/PropertyReader.h"
+
+/******************************************************************************/
+
+namespace {
+
+    /*
+     * Hands f_ a value of the type elements of type code_ are decoded as
+     * in bulk, returning whatever it does
+     */
+    template<typename F>
+    bool
+    bulk (codec::type_t code_, F && f_) {
+        switch (code_) {
+            case codec::AMQP_BYTE   : return f_ (int8_t { });
+            case codec::AMQP_UBYTE  : return f_ (uint8_t { });
+            case codec::AMQP_SHORT  : return f_ (int16_t { });
+            case codec::AMQP_USHORT : return f_ (uint16_t { });
+            case codec::AMQP_INT    : return f_ (int32_t { });
+            case codec::AMQP_UINT   : return f_ (uint32_t { });
+            case codec::AMQP_CHAR   : return f_ (char32_t { });
+            case codec::AMQP_LONG   : return f_ (int64_t { });
+            case codec::AMQP_ULONG  : return f_ (uint64_t { });
+            case codec::AMQP_FLOAT  : return f_ (float { });
+            case codec::AMQP_DOUBLE : return f_ (double { });
+            default                 : return false;
+        }
+    }
+
+    /*
+     * The value as the property readers present one of its type, see
+     * PrimitivePropertyReader
+     */
+    template<typename T>
+    auto
+    widen (T value_) {
+        if constexpr (std::is_same_v<T, uint32_t>) return static_cast<int64_t>(value_);
+        else if constexpr (std::is_same_v<T, float>) return static_cast<double>(value_);
+        else if constexpr (sizeof (T) < sizeof (int32_t)) return static_cast<int32_t>(value_);
+        else return value_;
+    }
+
+    template<typename T>
+    void
+    visitOne (T value_, amqp::reader::IVisitor & visitor_) {
+        if constexpr (std::is_same_v<T, char32_t>) {
+            char buf[4];
+            visitor_.value (amqp::internal::reader::format::utf8 (value_, buf));
+        } else {
+            visitor_.value (widen (value_));
+        }
+    }
+
+    template<typename T>
+    amqp::reader::Variant
+    readOne (T value_) {
+        if constexpr (std::is_same_v<T, char32_t>) {
+            char buf[4];
+            return amqp::reader::Variant (
+                std::string (amqp::internal::reader::format::utf8 (value_, buf)));
+        } else {
+            return amqp::reader::Variant (widen (value_));
+        }
+    }
+
+}
 
 /******************************************************************************
  *
@@ -16,60 +88,145 @@ ListReader::restrictedType() const {
 
 /******************************************************************************/
 
-std::unique_ptr<amqp::reader::IValue>
+void
 amqp::internal::reader::
-ListReader::dump (
-    const std::string & name_,
-    pn_data_t * data_,
-    const SchemaType & schema_
-) const {
-    proton::auto_next an (data_);
+ListReader::freeze() {
+    if (auto l = m_reader.lock()) {
+        m_resolved = l.get();
 
-    return std::make_unique<TypedPair<sList<uPtr<amqp::reader::IValue>>>>(
-         name_,
-         dump_ (data_, schema_));
+        if (dynamic_cast<const PropertyReader *>(m_resolved)) {
+            auto code = codec::type_code (m_resolved->type());
+            m_bulk = codec::isBulk (code) ? code : codec::AMQP_INVALID;
+        }
+    } else {
+        throw std::runtime_error ("null list element reader: " + type());
+    }
 }
 
 /******************************************************************************/
 
-std::unique_ptr<amqp::reader::IValue>
+const amqp::internal::reader::Reader *
 amqp::internal::reader::
-ListReader::dump(
-    pn_data_t * data_,
-    const SchemaType & schema_
-) const {
-    proton::auto_next an (data_);
-
-    return std::make_unique<TypedSingle<sList<uPtr<amqp::reader::IValue>>>>(
-         dump_ (data_, schema_));
+ListReader::element() const {
+    return m_resolved;
 }
 
 /******************************************************************************/
 
-std::list<std::unique_ptr<amqp::reader::IValue>>
+amqp::reader::Variant
 amqp::internal::reader::
-ListReader::dump_(
-        pn_data_t * data_,
-        const SchemaType & schema_
-) const {
-    proton::is_described (data_);
+ListReader::read (codec::Cursor * data_) const {
+    if (!m_resolved) {
+        throw std::runtime_error ("Reader used before being frozen");
+    }
+
+    root (data_);
+
+    if (codec::auto_resolve ref (data_); ref) {
+        return read (ref.object());
+    }
 
-    std::list<std::unique_ptr<amqp::reader::IValue>> read;
+    codec::auto_next an (data_);
+    codec::is_described (data_);
 
+    amqp::reader::Variant::List elements;
     {
-        proton::auto_enter ae (data_);
-        auto it = schema_.fromDescriptor (proton::readAndNext<std::string>(data_));
+        codec::auto_enter ae (data_, true);
 
-        {
-            proton::auto_list_enter ale (data_, true);
+        bool done = bulk (m_bulk, [&](auto t_) {
+            std::vector<decltype (t_)> values;
 
-            for (size_t i { 0 } ; i < ale.elements() ; ++i) {
-                read.emplace_back (m_reader.lock()->dump (data_, schema_));
+            if (!codec::readAll (data_, values)) {
+                return false;
             }
+
+            elements.reserve (values.size());
+            for (auto value : values) {
+                elements.emplace_back (readOne (value));
+            }
+
+            return true;
+        });
+
+        if (done) {
+            return amqp::reader::Variant (std::move (elements));
+        }
+
+        codec::auto_list_enter ale (data_, true);
+
+        elements.reserve (ale.elements());
+        for (size_t i { 0 } ; i < ale.elements() ; ++i) {
+            codec::auto_number n (data_);
+            elements.emplace_back (m_resolved->read (data_));
         }
     }
 
-    return read;
+    return amqp::reader::Variant (std::move (elements));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+ListReader::visit (
+        codec::Cursor * data_,
+        const SchemaType & schema_,
+        amqp::reader::IVisitor & visitor_
+) const {
+    if (!m_resolved) {
+        throw std::runtime_error ("Reader used before being frozen");
+    }
+
+    root (data_);
+
+    if (codec::auto_resolve ref (data_); ref) {
+        if (!visitor_.reference (ref.index())) {
+            visit (ref.object(), schema_, visitor_);
+        }
+
+        return;
+    }
+
+    codec::auto_next an (data_);
+    codec::is_described (data_);
+
+    {
+        // skip the descriptor, the reader for our elements was resolved
+        // when we were built so there is nothing to look up
+        codec::auto_enter ae (data_, true);
+
+        /*
+         * Lists and arrays of numbers decode in one go, falling back on
+         * the element reader should they turn out to hold nulls
+         */
+        bool done = bulk (m_bulk, [&](auto t_) {
+            std::vector<decltype (t_)> values;
+
+            if (!codec::readAll (data_, values)) {
+                return false;
+            }
+
+            visitor_.beginList();
+            for (auto value : values) {
+                visitOne (value, visitor_);
+            }
+            visitor_.endList();
+
+            return true;
+        });
+
+        if (done) {
+            return;
+        }
+
+        codec::auto_list_enter ale (data_, true);
+
+        visitor_.beginList();
+        for (size_t i { 0 } ; i < ale.elements() ; ++i) {
+            m_resolved->visit (data_, schema_, visitor_);
+        }
+        visitor_.endList();
+    }
 }
 
 /******************************************************************************/
@@ -4,6 +4,8 @@
 
 #include "RestrictedReader.h"
 
+#include "codec/Cursor.h"
+
 /******************************************************************************/
 
 namespace amqp::internal::reader {
@@ -13,9 +15,12 @@ namespace amqp::internal::reader {
             // How to read the underlying types
             std::weak_ptr<Reader> m_reader;
 
-            std::list<uPtr<amqp::reader::IValue>> dump_(
-                pn_data_t *,
-                const SchemaType &) const;
+            // and the same once we're frozen
+            const Reader * m_resolved;
+
+            // the type of our elements if they can be decoded in bulk,
+            // see codec::readAll, AMQP_INVALID otherwise
+            codec::type_t m_bulk;
 
         public :
             ListReader (
@@ -23,20 +28,27 @@ namespace amqp::internal::reader {
                 std::weak_ptr<Reader> reader_
             ) : RestrictedReader (type_)
               , m_reader (std::move (reader_))
+              , m_resolved (nullptr)
+              , m_bulk (codec::AMQP_INVALID)
             { }
 
             ~ListReader() final = default;
 
             internal::schema::Restricted::RestrictedTypes restrictedType() const;
 
-            std::unique_ptr<amqp::reader::IValue> dump(
-                const std::string &,
-                pn_data_t *,
-                const SchemaType &) const override;
+            void freeze() override;
+
+            /**
+             * The reader for our elements, null until we're frozen
+             */
+            const Reader * element() const;
+
+            amqp::reader::Variant read (codec::Cursor *) const override;
 
-            std::unique_ptr<amqp::reader::IValue> dump(
-                pn_data_t *,
-                const SchemaType &) const override;
+            void visit (
+                codec::Cursor *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
     };
 
 }
@@ -0,0 +1,155 @@
+#include "MapReader.h"
+
+#include <stdexcept>
+
+#include "codec/codec_wrapper.h"
+
+/******************************************************************************/
+
+namespace {
+
+    const std::string entryType { "java.util.Map$Entry" }; // NOLINT
+    const std::string keyField { "key" }; // NOLINT
+    const std::string valueField { "value" }; // NOLINT
+
+}
+
+/******************************************************************************
+ *
+ * class MapReader
+ *
+ ******************************************************************************/
+
+amqp::internal::schema::Restricted::RestrictedTypes
+amqp::internal::reader::
+MapReader::restrictedType() const {
+    return internal::schema::Restricted::RestrictedTypes::Map;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+MapReader::freeze() {
+    auto k = m_keyReader.lock();
+    auto v = m_valueReader.lock();
+
+    if (!k || !v) {
+        throw std::runtime_error ("null map key or value reader: " + type());
+    }
+
+    m_key = k.get();
+    m_value = v.get();
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
+amqp::internal::reader::
+MapReader::key() const {
+    return m_key;
+}
+
+/******************************************************************************/
+
+const amqp::internal::reader::Reader *
+amqp::internal::reader::
+MapReader::value() const {
+    return m_value;
+}
+
+/******************************************************************************/
+
+amqp::reader::Variant
+amqp::internal::reader::
+MapReader::read (codec::Cursor * data_) const {
+    if (!m_key) {
+        throw std::runtime_error ("Reader used before being frozen");
+    }
+
+    root (data_);
+
+    if (codec::auto_resolve ref (data_); ref) {
+        return read (ref.object());
+    }
+
+    codec::auto_next an (data_);
+    codec::is_described (data_);
+
+    amqp::reader::Variant::List entries;
+    {
+        codec::auto_enter ae (data_, true);
+
+        codec::auto_map_enter ame (data_, true);
+
+        entries.reserve (ame.entries());
+        for (size_t i { 0 } ; i < ame.entries() ; ++i) {
+            amqp::reader::Record record;
+            record.fields.reserve (2);
+
+            {
+                codec::auto_number n (data_);
+                record.fields.emplace_back (m_key->read (data_));
+            }
+            {
+                codec::auto_number n (data_);
+                record.fields.emplace_back (m_value->read (data_));
+            }
+
+            entries.emplace_back (std::move (record));
+        }
+    }
+
+    return amqp::reader::Variant (std::move (entries));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::reader::
+MapReader::visit (
+        codec::Cursor * data_,
+        const SchemaType & schema_,
+        amqp::reader::IVisitor & visitor_
+) const {
+    if (!m_key) {
+        throw std::runtime_error ("Reader used before being frozen");
+    }
+
+    root (data_);
+
+    if (codec::auto_resolve ref (data_); ref) {
+        if (!visitor_.reference (ref.index())) {
+            visit (ref.object(), schema_, visitor_);
+        }
+
+        return;
+    }
+
+    codec::auto_next an (data_);
+    codec::is_described (data_);
+
+    {
+        // skip the descriptor, as with lists the readers for our keys
+        // and values were resolved when we were built
+        codec::auto_enter ae (data_, true);
+
+        codec::auto_map_enter ame (data_, true);
+
+        visitor_.beginList();
+        for (size_t i { 0 } ; i < ame.entries() ; ++i) {
+            visitor_.beginComposite (entryType);
+
+            visitor_.field (keyField);
+            m_key->visit (data_, schema_, visitor_);
+
+            visitor_.field (valueField);
+            m_value->visit (data_, schema_, visitor_);
+
+            visitor_.endComposite();
+        }
+        visitor_.endList();
+    }
+}
+
+/******************************************************************************/
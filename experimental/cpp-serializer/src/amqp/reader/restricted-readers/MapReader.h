@@ -0,0 +1,66 @@
+#pragma once
+
+/******************************************************************************/
+
+#include "RestrictedReader.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::reader {
+
+    /**
+     * Maps are reported as a list of their entries, in the order they
+     * were written, each a composite of a "key" and a "value" field.
+     * Keys of any type, composites included, come out the same way and
+     * nothing is collected up to be sorted or looked up, an entry is
+     * passed on as soon as it has been read.
+     *
+     *   [ { "key" : "GBP", "value" : 10 }, { "key" : "USD", "value" : 20 } ]
+     */
+    class MapReader : public RestrictedReader {
+        private :
+            std::weak_ptr<Reader> m_keyReader;
+            std::weak_ptr<Reader> m_valueReader;
+
+            // and the same once we're frozen
+            const Reader * m_key;
+            const Reader * m_value;
+
+        public :
+            MapReader (
+                const std::string & type_,
+                std::weak_ptr<Reader> key_,
+                std::weak_ptr<Reader> value_
+            ) : RestrictedReader (type_)
+              , m_keyReader (std::move (key_))
+              , m_valueReader (std::move (value_))
+              , m_key (nullptr)
+              , m_value (nullptr)
+            { }
+
+            ~MapReader() final = default;
+
+            internal::schema::Restricted::RestrictedTypes restrictedType() const;
+
+            void freeze() override;
+
+            /**
+             * The readers for our keys and values, null until we're frozen
+             */
+            const Reader * key() const;
+            const Reader * value() const;
+
+            /**
+             * A list of records, each the key followed by its value
+             */
+            amqp::reader::Variant read (codec::Cursor *) const override;
+
+            void visit (
+                codec::Cursor *,
+                const SchemaType &,
+                amqp::reader::IVisitor &) const override;
+    };
+
+}
+
+/******************************************************************************/
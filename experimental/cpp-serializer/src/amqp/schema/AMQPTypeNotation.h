@@ -51,13 +51,12 @@ namespace amqp::internal::schema {
 
             const std::string & descriptor() const;
 
-            const std::string & name() const;
+            const std::string & name() const override;
 
             virtual Type type() const = 0;
 
-            int dependsOn (const OrderedTypeNotation &) const override = 0;
-            virtual int dependsOn (const class Restricted &) const = 0;
-            virtual int dependsOn (const class Composite &) const = 0;
+            void dependencies (
+                const std::function<void (const std::string &)> &) const override = 0;
     };
 
 }
@@ -0,0 +1,31 @@
+#include "Choice.h"
+
+/******************************************************************************
+ *
+ * amqp::internal::schema::Choice
+ *
+ ******************************************************************************/
+
+amqp::internal::schema::
+Choice::Choice (std::string name_, std::string value_)
+    : m_name (std::move (name_))
+    , m_value (std::move (value_))
+{ }
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::schema::
+Choice::name() const {
+    return m_name;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::schema::
+Choice::value() const {
+    return m_value;
+}
+
+/******************************************************************************/
@@ -0,0 +1,31 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+
+#include "amqp/AMQPDescribed.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    /**
+     * One constant of an enum, see restricted-types/Enum.h. The value is
+     * the constant's ordinal, written out as a string.
+     */
+    class Choice : public AMQPDescribed {
+        private :
+            std::string m_name;
+            std::string m_value;
+
+        public :
+            Choice (std::string, std::string);
+
+            const std::string & name() const;
+            const std::string & value() const;
+    };
+
+}
+
+/******************************************************************************/
@@ -57,92 +57,38 @@ Composite::fields() const {
 
 /******************************************************************************/
 
-amqp::internal::schema::AMQPTypeNotation::Type
+const std::string &
 amqp::internal::schema::
-Composite::type() const {
-    return AMQPTypeNotation::Type::Composite;
+Composite::label() const {
+    return m_label;
 }
 
 /******************************************************************************/
 
-/**
- * Use a visitor style pattern to work out weather two types, composite or
- * restricted, are "less than" one or not. In this case we define being
- * "less than" not having a type that the other depends on. This will
- * eventually give us a set ordered in such a way we can simply create
- * each element in turn
- *
- * "...This object determines the order of the elements in the container: it is
- * a function pointer or a function object that takes two arguments of the same
- * type as the container elements, and returns true if the first argument is
- * considered to go before the second in the strict weak ordering it defines,
- * and false otherwise. ..."
-
- *
- * @param rhs
- * @return
- */
-int
+const std::list<std::string> &
 amqp::internal::schema::
-Composite::dependsOn (const OrderedTypeNotation & rhs) const {
-    return dynamic_cast<const AMQPTypeNotation &>(rhs).dependsOn(*this);
+Composite::provides() const {
+    return m_provides;
 }
 
 /******************************************************************************/
 
-int
+amqp::internal::schema::AMQPTypeNotation::Type
 amqp::internal::schema::
-Composite::dependsOn (const amqp::internal::schema::Restricted & lhs_) const {
-    // does the left hand side depend on us
-    auto rtn { 0 };
-
-    for (const auto i : lhs_) {
-        DBG ("  C/R a) " << i << " == " << name() << std::endl); // NOLINT
-        if (i == name()) {
-            rtn = 1;
-        }
-    }
-
-    // does this depend on the left hand side
-    for (auto const & field : m_fields) {
-        DBG ("  C/R b) " << field->resolvedType() << " == " << lhs_.name() << std::endl); // NOLINT
-
-        if (field->resolvedType() == lhs_.name()) {
-            rtn = 2;
-        }
-
-    }
-
-    return rtn;
+Composite::type() const {
+    return AMQPTypeNotation::Type::Composite;
 }
 
-/*********************************************************o*********************/
+/******************************************************************************/
 
-int
+void
 amqp::internal::schema::
-Composite::dependsOn (const amqp::internal::schema::Composite & lhs_) const {
-    auto rtn { 0 };
-
-    // do we depend on the lhs, i.e. is one of our fields it
-    for (auto const & field : lhs_) {
-        DBG ("  C/C a) " << field->resolvedType() << " == " << name() << std::endl); // NOLINT
-        if (field->resolvedType() == name()) {
-            rtn = 1;
-        }
-    }
-
-    // does the left hand side depend on us. i.e. is one of it's fields
-    // us
+Composite::dependencies (
+    const std::function<void (const std::string &)> & f_
+) const {
     for (const auto & field : m_fields) {
-        DBG ("  C/C b) " << field->resolvedType() << " == " << lhs_.name() << std::endl); // NOLINT
-
-        if (field->resolvedType() == lhs_.name()) {
-            rtn = 2;
-        }
+        f_ (field->resolvedType());
     }
-
-
-    return rtn;
 }
 
 /******************************************************************************/
@@ -70,11 +70,16 @@ namespace amqp::internal::schema {
 
             const std::vector<std::unique_ptr<Field>> & fields() const;
 
+            const std::string & label() const;
+            const std::list<std::string> & provides() const;
+
             Type type() const override;
 
-            int dependsOn (const OrderedTypeNotation &) const override;
-            int dependsOn (const class Restricted &) const override;
-            int dependsOn (const Composite &) const override;
+            /**
+             * The resolved type of each of our fields
+             */
+            void dependencies (
+                const std::function<void (const std::string &)> &) const override;
 
             decltype(m_fields)::const_iterator begin() const { return m_fields.cbegin();}
             decltype(m_fields)::const_iterator end() const { return m_fields.cend(); }
@@ -1,6 +1,7 @@
 #include "Envelope.h"
 
 #include <iostream>
+#include <stdexcept>
 
 #include "amqp/schema/Schema.h"
 #include "amqp/schema/ISchema.h"
@@ -14,7 +15,9 @@ operator << (
         std::ostream & stream_,
         const amqp::internal::schema::Envelope & e_
 ) {
-    stream_ << *(e_.m_schema);
+    if (e_.m_schema) {
+        stream_ << *(e_.m_schema);
+    }
     return stream_;
 }
 
@@ -29,21 +32,57 @@ operator << (
 amqp::internal::schema::
 Envelope::Envelope (
     uPtr<Schema> & schema_,
+    uPtr<Transforms> & transforms_,
     std::string descriptor_
 ) : m_schema (std::move (schema_))
+  , m_transforms (std::move (transforms_))
   , m_descriptor (std::move (descriptor_))
 { }
 
 /******************************************************************************/
 
+amqp::internal::schema::
+Envelope::Envelope (
+    std::string descriptor_,
+    std::string_view schemaBytes_
+) : m_descriptor (std::move (descriptor_))
+  , m_schemaBytes (schemaBytes_)
+{ }
+
+/******************************************************************************/
+
 const amqp::internal::schema::ISchemaType &
 amqp::internal::schema::
 Envelope::schema() const {
+    if (!m_schema) {
+        throw std::runtime_error ("Envelope schema has not been decoded");
+    }
+
     return *m_schema;
 }
 
 /******************************************************************************/
 
+const amqp::internal::schema::Transforms &
+amqp::internal::schema::
+Envelope::transforms() const {
+    if (!m_transforms) {
+        throw std::runtime_error ("Envelope transforms have not been decoded");
+    }
+
+    return *m_transforms;
+}
+
+/******************************************************************************/
+
+std::string_view
+amqp::internal::schema::
+Envelope::schemaBytes() const {
+    return m_schemaBytes;
+}
+
+/******************************************************************************/
+
 const std::string &
 amqp::internal::schema::
 Envelope::descriptor() const {
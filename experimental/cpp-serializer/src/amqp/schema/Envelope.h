@@ -5,8 +5,10 @@
 #include "amqp/AMQPDescribed.h"
 
 #include "Schema.h"
+#include "Transforms.h"
 
 #include <iosfwd>
+#include <string_view>
 
 /******************************************************************************/
 
@@ -18,17 +20,35 @@ namespace amqp::internal::schema {
 
         private :
             std::unique_ptr<Schema> m_schema;
+            std::unique_ptr<Transforms> m_transforms;
             std::string m_descriptor;
 
+            /**
+             * The still encoded schema and transforms schema sections,
+             * only set when the envelope was built from a cursor, in
+             * which case decoding them is left to the SchemaCache. A view
+             * into the blob so only valid for as long as it is.
+             */
+            std::string_view m_schemaBytes;
+
         public :
             Envelope() = delete;
 
             Envelope (
                 std::unique_ptr<Schema> & schema_,
+                std::unique_ptr<Transforms> & transforms_,
                 std::string descriptor_);
 
+            Envelope (
+                std::string descriptor_,
+                std::string_view schemaBytes_);
+
             const ISchemaType & schema() const;
 
+            const Transforms & transforms() const;
+
+            std::string_view schemaBytes() const;
+
             const std::string & descriptor() const;
     };
 
@@ -1,5 +1,7 @@
 #include "Field.h"
 
+#include "codec/Cursor.h"
+
 #include <sstream>
 #include <iostream>
 
@@ -48,14 +50,16 @@ Field::Field (
 
 /******************************************************************************/
 
+/**
+ * The JVM names primitives as AMQP does, anything that names a type
+ * that isn't compound is one
+ */
 bool
 amqp::internal::schema::
 Field::typeIsPrimitive(const std::string & type_) {
-    return (type_ == "string" ||
-            type_ == "long" ||
-            type_ == "boolean" ||
-            type_ == "int" ||
-            type_ == "double");
+    auto code = codec::type_code (type_);
+
+    return code >= codec::AMQP_BOOL && code <= codec::AMQP_SYMBOL;
 }
 
 /******************************************************************************/
@@ -100,6 +104,38 @@ Field::requires() const {
 
 /******************************************************************************/
 
+const std::string &
+amqp::internal::schema::
+Field::defaultValue() const {
+    return m_default;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::schema::
+Field::label() const {
+    return m_label;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::schema::
+Field::mandatory() const {
+    return m_mandatory;
+}
+
+/******************************************************************************/
+
+bool
+amqp::internal::schema::
+Field::multiple() const {
+    return m_multiple;
+}
+
+/******************************************************************************/
+
 bool
 amqp::internal::schema::
 Field::primitive() const {
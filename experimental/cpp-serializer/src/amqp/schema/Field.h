@@ -54,6 +54,10 @@ namespace amqp::internal::schema {
             const std::string            & resolvedType() const;
             FieldType                      fieldType() const;
             const std::list<std::string> & requires() const;
+            const std::string            & defaultValue() const;
+            const std::string            & label() const;
+            bool mandatory() const;
+            bool multiple() const;
             bool primitive() const;
     };
 
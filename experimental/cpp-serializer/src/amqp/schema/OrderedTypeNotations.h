@@ -1,8 +1,14 @@
 #pragma once
 
 #include <list>
+#include <vector>
+#include <string>
 #include <ostream>
 #include <iostream>
+#include <algorithm>
+#include <functional>
+#include <string_view>
+#include <unordered_map>
 
 #include "types.h"
 #include "colours.h"
@@ -35,7 +41,15 @@ namespace amqp::internal::schema {
         public :
             virtual ~OrderedTypeNotation() = default;
 
-            virtual int dependsOn (const OrderedTypeNotation &) const = 0;
+            virtual const std::string & name() const = 0;
+
+            /**
+             * Call f_ with the name of every type this one refers to.
+             * Names that aren't in the same set of types, primitives for
+             * example, are ignored when ordering.
+             */
+            virtual void dependencies (
+                const std::function<void (const std::string &)> & f_) const = 0;
     };
 
 }
@@ -44,20 +58,41 @@ namespace amqp::internal::schema {
 
 namespace amqp::internal::schema {
 
+    /**
+     * A set of types grouped into levels such that, iterating from begin
+     * to end, nothing depends on a type in a later level. Types on the
+     * same level are independent of one another and are kept in the
+     * order they were inserted.
+     *
+     * Inserting is just an append, the levels are worked out with a
+     * topological sort the first time they're looked at, linear in the
+     * number of types and the references between them. Because that
+     * happens behind a const interface the first look must not race
+     * with anything else, once ordered it's safe to share. Inserting
+     * after that point reorders everything, invalidating any iterators
+     * or references into the levels.
+     *
+     * Types that are part of, or depend on, a cycle can't be ordered.
+     * They're all put in a final level of their own.
+     */
     template<class T>
     class OrderedTypeNotations {
         private:
-            std::list<std::list<uPtr<T>>> m_schemas;
+            /**
+             * Stored most dependent first
+             */
+            mutable std::list<std::list<uPtr<T>>> m_schemas;
+
+            /**
+             * Inserted but not yet placed in a level
+             */
+            mutable std::vector<uPtr<T>> m_unordered;
 
         public :
             typedef decltype(m_schemas.begin()) iterator;
 
         private:
-            void insert (uPtr<T> &&, iterator);
-            void insertNewList (uPtr<T> &&);
-            void insertNewList (
-                    uPtr<T> &&,
-                    typename std::list<std::list<uPtr<T>>>::iterator &);
+            const std::list<std::list<uPtr<T>>> & ordered() const;
 
         public :
             void insert(uPtr<T> && ptr);
@@ -67,11 +102,11 @@ namespace amqp::internal::schema {
                     const amqp::internal::schema::OrderedTypeNotations<T> &);
 
             decltype (m_schemas.crbegin()) begin() const {
-                return m_schemas.crbegin();
+                return ordered().crbegin();
             }
 
             decltype (m_schemas.crend()) end() const {
-                return m_schemas.crend();
+                return ordered().crend();
             }
     };
 
@@ -86,7 +121,7 @@ operator << (
         const amqp::internal::schema::OrderedTypeNotations<T> &otn_
 ) {
     int idx1{0};
-    for (const auto &i : otn_.m_schemas) {
+    for (const auto &i : otn_.ordered()) {
         stream_ << "level " << ++idx1 << std::endl;
         for (const auto &j : i) {
             stream_ << "    * " << j->name() << std::endl;
@@ -102,105 +137,110 @@ operator << (
 template<class T>
 void
 amqp::internal::schema::
-OrderedTypeNotations<T>::insertNewList(uPtr<T> && ptr) {
-    std::list<uPtr<T>> l;
-    l.emplace_back (std::move (ptr));
-    m_schemas.emplace_back(std::move (l));
+OrderedTypeNotations<T>::insert (uPtr<T> && ptr) {
+    m_unordered.emplace_back (std::move (ptr));
 }
 
 /******************************************************************************/
 
 /**
- * This could be a bit more space efficient by checking the previous element
- * for dependendies again as its possible we are moving multiple elements "up"
- * but the extra checks probably don't make it worth it.
+ * Kahn's algorithm. A type's level is the length of the longest chain of
+ * references from it to a type with none, so leaves are level 0, and
+ * anything that refers to a leaf and nothing else is level 1 and so on.
  */
 template<class T>
-void
+const std::list<std::list<uPtr<T>>> &
 amqp::internal::schema::
-OrderedTypeNotations<T>::insertNewList(
-        uPtr<T> && ptr,
-        typename std::list<std::list<uPtr<T>>>::iterator & here_)
-{
-    std::list<uPtr<T>> l;
-    l.emplace_back (std::move (ptr));
-    m_schemas.insert(here_, std::move (l));
-}
+OrderedTypeNotations<T>::ordered() const {
+    if (m_unordered.empty()) {
+        return m_schemas;
+    }
 
-/******************************************************************************/
+    /*
+     * Anything already ordered goes back in with the new arrivals
+     */
+    std::vector<uPtr<T>> types;
+    types.reserve (m_unordered.size());
 
-template<class T>
-void
-amqp::internal::schema::
-OrderedTypeNotations<T>::insert (uPtr<T> && ptr) {
-    return insert (std::move (ptr), m_schemas.begin());
-}
+    for (auto i = m_schemas.rbegin() ; i != m_schemas.rend() ; ++i) {
+        for (auto & j : *i) {
+            types.emplace_back (std::move (j));
+        }
+    }
+    m_schemas.clear();
 
-/******************************************************************************/
+    for (auto & t : m_unordered) {
+        types.emplace_back (std::move (t));
+    }
+    m_unordered.clear();
+
+    std::unordered_map<std::string_view, size_t> index;
+    index.reserve (types.size());
+
+    for (size_t i { 0 } ; i < types.size() ; ++i) {
+        index.emplace (types[i]->name(), i);
+    }
 
-template<class T>
-void
-amqp::internal::schema::
-OrderedTypeNotations<T>::insert (
-        uPtr<T> && ptr,
-        amqp::internal::schema::OrderedTypeNotations<T>::iterator l_
-) {
     /*
-     * First we find where this element needs to be added
+     * For each type, how many of its references are still to be placed
+     * and which types refer to it
      */
-    amqp::internal::schema::OrderedTypeNotations<T>::iterator insertionPoint { l_ };
-
-    for (auto i = l_ ; i != m_schemas.end() ; ++i) {
-        for (const auto & j : *i) {
-            /*
-             * A score of 0 means no dependencies at all
-             * A score of 1 means "j" has a dependency on what's being inserted
-             * A score of 2 means what's being inserted depends on "j"
-             */
-            auto score = j->dependsOn(*ptr);
+    std::vector<size_t> waitingOn (types.size(), 0);
+    std::vector<std::vector<size_t>> referencedBy (types.size());
 
-            if (score == 1) {
-                insertionPoint = std::next(i);
-            } else if (score == 2) {
-                insertionPoint = i;
-                goto done;
+    for (size_t i { 0 } ; i < types.size() ; ++i) {
+        types[i]->dependencies ([&](const std::string & name_) {
+            auto it = index.find (name_);
+
+            if (it != index.end() && it->second != i) {
+                ++waitingOn[i];
+                referencedBy[it->second].push_back (i);
             }
+        });
+    }
+
+    std::vector<size_t> ready;
+    ready.reserve (types.size());
+
+    for (size_t i { 0 } ; i < types.size() ; ++i) {
+        if (waitingOn[i] == 0) ready.push_back (i);
+    }
+
+    std::vector<size_t> level (types.size(), 0);
+    size_t levels { 0 };
+
+    for (size_t r { 0 } ; r < ready.size() ; ++r) {
+        auto i = ready[r];
+
+        levels = std::max (levels, level[i] + 1);
+
+        for (auto j : referencedBy[i]) {
+            level[j] = std::max (level[j], level[i] + 1);
+            if (--waitingOn[j] == 0) ready.push_back (j);
         }
     }
-done:
 
     /*
-     * Now we insert it and work out if anything requires shuffling
+     * Whatever was never ready is stuck behind a cycle
      */
-    if (insertionPoint == m_schemas.end()) {
-        insertNewList (std::move(ptr));
-    } else {
-        const auto & insertedPtr = insertionPoint->emplace_front (std::move(ptr));
-
-        for (auto j = std::next (insertionPoint->begin()) ; j != insertionPoint->end() ; ) {
-            auto toErase = j++;
-
-            auto score { insertedPtr->dependsOn (**toErase) };
-
-            if (score > 0) {
-                uPtr<T> tmpPtr{std::move(*toErase)};
-                insertionPoint->erase (toErase);
-                switch (score) {
-                    // Needs to go after the element we're adding
-                    case 1: {
-                        insert(std::move(tmpPtr), std::next(insertionPoint));
-                        break;
-                    }
-                    // Needs to go before the element we're adding
-                    case 2: {
-                        insertNewList (std::move(tmpPtr), insertionPoint);
-                        break;
-                    }
-                }
-
-            }
+    if (ready.size() != types.size()) {
+        for (size_t i { 0 } ; i < types.size() ; ++i) {
+            if (waitingOn[i] != 0) level[i] = levels;
         }
+        ++levels;
     }
+
+    std::vector<std::list<uPtr<T>>> byLevel (levels);
+
+    for (size_t i { 0 } ; i < types.size() ; ++i) {
+        byLevel[level[i]].emplace_back (std::move (types[i]));
+    }
+
+    for (auto & l : byLevel) {
+        m_schemas.emplace_front (std::move (l));
+    }
+
+    return m_schemas;
 }
 
 /******************************************************************************/
@@ -0,0 +1,167 @@
+#include "Transforms.h"
+
+#include <iostream>
+#include <algorithm>
+#include <stdexcept>
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+std::ostream &
+operator << (std::ostream & stream_, const Transform & transform_) {
+    switch (transform_.kind()) {
+        case Transform::Kind::EnumDefault :
+            return stream_ << "EnumDefault " << transform_.to() << " -> " << transform_.from();
+        case Transform::Kind::Rename :
+            return stream_ << "Rename " << transform_.from() << " -> " << transform_.to();
+        default :
+            return stream_ << "Unknown";
+    }
+}
+
+std::ostream &
+operator << (std::ostream & stream_, const Transforms & transforms_) {
+    for (const auto & type : transforms_.m_types) {
+        stream_ << type.first << std::endl;
+
+        for (const auto & transform : type.second) {
+            stream_ << "  " << transform << std::endl;
+        }
+    }
+
+    return stream_;
+}
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::schema::Transform
+ *
+ ******************************************************************************/
+
+amqp::internal::schema::
+Transform::Transform (Kind kind_, std::string from_, std::string to_)
+    : m_kind (kind_)
+    , m_from (std::move (from_))
+    , m_to (std::move (to_))
+{ }
+
+/******************************************************************************/
+
+amqp::internal::schema::Transform::Kind
+amqp::internal::schema::
+Transform::kind (std::string_view name_) {
+    if (name_ == "EnumDefault") return Kind::EnumDefault;
+    if (name_ == "Rename") return Kind::Rename;
+
+    return Kind::Unknown;
+}
+
+/******************************************************************************/
+
+amqp::internal::schema::Transform::Kind
+amqp::internal::schema::
+Transform::kind() const {
+    return m_kind;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::schema::
+Transform::from() const {
+    return m_from;
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::schema::
+Transform::to() const {
+    return m_to;
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::schema::Transforms
+ *
+ ******************************************************************************/
+
+amqp::internal::schema::
+Transforms::Transforms (std::map<std::string, std::vector<Transform>> types_)
+    : m_types (std::move (types_))
+{ }
+
+/******************************************************************************/
+
+bool
+amqp::internal::schema::
+Transforms::empty() const {
+    return m_types.empty();
+}
+
+/******************************************************************************/
+
+const std::vector<amqp::internal::schema::Transform> &
+amqp::internal::schema::
+Transforms::of (const std::string & type_) const {
+    static const std::vector<Transform> none;
+
+    auto it = m_types.find (type_);
+
+    return it == m_types.end() ? none : it->second;
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::schema::
+Transforms::evolve (
+    const std::string & type_,
+    const std::string & constant_,
+    const std::vector<std::string_view> & local_
+) const {
+    const auto & transforms = of (type_);
+
+    /*
+     * Each step either finds the constant or follows one transform, so a
+     * chain longer than there are transforms has gone round in a circle
+     */
+    std::string_view name { constant_ };
+
+    for (size_t step { 0 } ; step <= transforms.size() ; ++step) {
+        auto it = std::find (local_.begin(), local_.end(), name);
+
+        if (it != local_.end()) {
+            return static_cast<size_t>(it - local_.begin());
+        }
+
+        auto back = std::find_if (transforms.begin(), transforms.end(),
+            [name](const Transform & t_) {
+                return t_.kind() != Transform::Kind::Unknown && t_.to() == name;
+            });
+
+        if (back != transforms.end()) {
+            name = back->from();
+            continue;
+        }
+
+        auto forward = std::find_if (transforms.begin(), transforms.end(),
+            [name](const Transform & t_) {
+                return t_.kind() == Transform::Kind::Rename && t_.from() == name;
+            });
+
+        if (forward == transforms.end()) {
+            break;
+        }
+
+        name = forward->to();
+    }
+
+    throw std::runtime_error (
+        "Cannot evolve " + type_ + "." + constant_ + ", it has no equivalent here");
+}
+
+/******************************************************************************/
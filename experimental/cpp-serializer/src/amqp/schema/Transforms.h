@@ -0,0 +1,118 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <map>
+#include <string>
+#include <vector>
+#include <iosfwd>
+#include <string_view>
+
+#include "amqp/AMQPDescribed.h"
+
+/******************************************************************************
+ *
+ * class amqp::internal::schema::Transform
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    /**
+     * One change made to an enum since it was first written, as the JVM
+     * records them from the class's annotations. Either a constant
+     * renamed, from then to, or a constant added, then, which readers
+     * that don't know it should treat as to. We keep them as the JVM
+     * writes them, the first of the pair being the old name.
+     *
+     * Anything else the JVM may write in future is kept as Unknown and
+     * otherwise ignored.
+     */
+    class Transform : public AMQPDescribed {
+        public :
+            enum class Kind { Unknown, EnumDefault, Rename };
+
+        private :
+            Kind        m_kind;
+            std::string m_from;
+            std::string m_to;
+
+        public :
+            Transform (Kind, std::string, std::string);
+
+            /**
+             * From the name the JVM gives the transform
+             */
+            static Kind kind (std::string_view);
+
+            Kind kind() const;
+
+            /**
+             * For an EnumDefault the constant defaulted to, for a Rename
+             * the name it used to have
+             */
+            const std::string & from() const;
+
+            /**
+             * For an EnumDefault the constant added, for a Rename the
+             * name it has now
+             */
+            const std::string & to() const;
+    };
+
+    std::ostream & operator << (std::ostream &, const Transform &);
+
+}
+
+/******************************************************************************
+ *
+ * class amqp::internal::schema::Transforms
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    /**
+     * The transforms schema of an envelope, every transform the writer
+     * knew of for each of the types in the blob, keyed on the type's name.
+     * Most blobs have none.
+     */
+    class Transforms : public AMQPDescribed {
+        private :
+            std::map<std::string, std::vector<Transform>> m_types;
+
+        public :
+            Transforms() = default;
+
+            explicit Transforms (std::map<std::string, std::vector<Transform>>);
+
+            bool empty() const;
+
+            /**
+             * The transforms for a type, in the order they were written,
+             * empty for a type that has none
+             */
+            const std::vector<Transform> & of (const std::string &) const;
+
+            /**
+             * Which of the constants a reader knows, by their position in
+             * local_, the writer's constant_ of enum type_ should be read
+             * as. Mirrors the JVM's EnumEvolutionSerializer, a constant
+             * the reader doesn't know is followed back through renames
+             * and the defaults given for constants added since, or, for a
+             * blob older than the reader, forward through renames, until
+             * one it does is found.
+             *
+             * Throws std::runtime_error if there's no such constant.
+             */
+            size_t evolve (
+                const std::string & type_,
+                const std::string & constant_,
+                const std::vector<std::string_view> & local_) const;
+
+            friend std::ostream & operator << (std::ostream &, const Transforms &);
+    };
+
+}
+
+/******************************************************************************/
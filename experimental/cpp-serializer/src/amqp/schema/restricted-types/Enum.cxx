@@ -0,0 +1,47 @@
+#include "Enum.h"
+
+/******************************************************************************/
+
+amqp::internal::schema::
+Enum::Enum (
+    uPtr<Descriptor> & descriptor_,
+    const std::string & name_,
+    const std::string & label_,
+    const std::vector<std::string> & provides_,
+    std::vector<std::string> choices_
+) : Restricted (
+        descriptor_,
+        name_,
+        label_,
+        provides_,
+        amqp::internal::schema::Restricted::RestrictedTypes::Enum)
+  , m_choices (std::move (choices_))
+{
+
+}
+
+/******************************************************************************/
+
+std::vector<std::string>::const_iterator
+amqp::internal::schema::
+Enum::begin() const {
+    return m_enumOf.begin();
+}
+
+/******************************************************************************/
+
+std::vector<std::string>::const_iterator
+amqp::internal::schema::
+Enum::end() const {
+    return m_enumOf.end();
+}
+
+/******************************************************************************/
+
+const std::vector<std::string> &
+amqp::internal::schema::
+Enum::choices() const {
+    return m_choices;
+}
+
+/******************************************************************************/
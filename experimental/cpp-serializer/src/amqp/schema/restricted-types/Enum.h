@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Restricted.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    /**
+     * A Java enum. The JVM writes its constants as choices, each named
+     * and valued with its ordinal, and an instance as the constant's
+     * name and ordinal. Here the names are kept indexed by ordinal so
+     * turning an instance back into its name is a single array lookup.
+     *
+     * Being a blob's own schema the table is the enum as it was when the
+     * blob was written, whatever has happened to the class since.
+     */
+    class Enum : public Restricted {
+        private :
+            /**
+             * Enums are made of no other types
+             */
+            std::vector<std::string> m_enumOf;
+
+            /**
+             * Indexed by ordinal
+             */
+            std::vector<std::string> m_choices;
+
+        public :
+            Enum (
+                uPtr<Descriptor> & descriptor_,
+                const std::string &,
+                const std::string &,
+                const std::vector<std::string> &,
+                std::vector<std::string>);
+
+            std::vector<std::string>::const_iterator begin() const override;
+            std::vector<std::string>::const_iterator end() const override;
+
+            const std::vector<std::string> & choices() const;
+    };
+
+}
+
+/******************************************************************************/
@@ -1,6 +1,8 @@
 #include <iostream>
 #include "List.h"
 
+#include <stdexcept>
+
 #include "debug.h"
 #include "colours.h"
 
@@ -10,10 +12,30 @@
 
 namespace {
 
+    /*
+     * java.util.List<int>, or for arrays int[], or int[p] for an array of
+     * primitives rather than their boxed equivalents
+     */
     std::pair<std::string, std::string>
     listType (const std::string & list_) {
+        if (!list_.empty() && list_.back() == ']') {
+            auto pos = list_.rfind ('[');
+
+            if (pos == std::string::npos) {
+                throw std::runtime_error ("Bad list type \"" + list_ + "\", it has no [");
+            }
+
+            return std::make_pair (
+                std::string { list_.substr (pos) },
+                std::string { list_.substr (0, pos) });
+        }
+
         auto pos = list_.find ('<');
 
+        if (pos == std::string::npos || list_.back() != '>') {
+            throw std::runtime_error ("Bad list type \"" + list_ + "\", it has no element type");
+        }
+
         return std::make_pair (
                std::string { list_.substr (0, pos) },
                 std::string { list_.substr(pos + 1, list_.size() - pos - 2) }
@@ -66,51 +88,3 @@ List::listOf() const {
 }
 
 /******************************************************************************/
-
-int
-amqp::internal::schema::
-List::dependsOn (const amqp::internal::schema::Restricted & lhs_) const {
-    auto rtn { 0 };
-    switch (lhs_.restrictedType()) {
-        case RestrictedTypes::List : {
-            const auto & list { dynamic_cast<const List &>(lhs_) };
-
-            // does the left hand side depend on us
-            DBG ("  L/L a) " << list.listOf() << " == " << name() << std::endl); // NOLINT
-            if (list.listOf() == name()) {
-                rtn = 1;
-            }
-
-            // do we depend on the lhs
-            DBG ("  L/L b) " << listOf() << " == " << list.name() << std::endl); // NOLINT
-            if (listOf() == list.name()) {
-                rtn = 2;
-            }
-        }
-    }
-
-    return rtn;
-}
-
-/******************************************************************************/
-
-int
-amqp::internal::schema::
-List::dependsOn (const amqp::internal::schema::Composite & lhs_) const {
-    auto rtn { 0 };
-    for (const auto & field : lhs_.fields()) {
-        DBG ("  L/C a) " << field->resolvedType() << " == " << name() << std::endl); // NOLINT
-        if (field->resolvedType() == name()) {
-            rtn = 1;
-        }
-    }
-
-    DBG ("  L/C b) " << listOf() << " == " << lhs_.name() << std::endl); // NOLINT
-    if (listOf() == lhs_.name()) {
-        rtn = 2;
-    }
-
-    return rtn;
-}
-
-/*********************************************************o*********************/
@@ -23,8 +23,6 @@ namespace amqp::internal::schema {
 
             const std::string & listOf() const;
 
-            int dependsOn (const Restricted &) const override;
-            int dependsOn (const class Composite &) const override;
     };
 
 }
@@ -0,0 +1,111 @@
+#include "Map.h"
+
+#include <stdexcept>
+
+/******************************************************************************/
+
+namespace {
+
+    /**
+     * Split the generic parameters of a map's name at the comma between
+     * them, ignoring any inside a parameter that is itself generic
+     */
+    std::vector<std::string>
+    mapType (const std::string & map_) {
+        auto open = map_.find ('<');
+        auto close = map_.rfind ('>');
+
+        if (open == std::string::npos || close == std::string::npos || close < open) {
+            throw std::runtime_error ("Map type \"" + map_ + "\" has no key or value type");
+        }
+
+        auto trim = [](const std::string & s_) {
+            auto first = s_.find_first_not_of (' ');
+            auto last = s_.find_last_not_of (' ');
+
+            return first == std::string::npos ? "" : s_.substr (first, last - first + 1);
+        };
+
+        std::vector<std::string> rtn;
+
+        int depth { 0 };
+        auto start = open + 1;
+
+        for (auto i = start ; i < close ; ++i) {
+            switch (map_[i]) {
+                case '<' : ++depth; break;
+                case '>' : --depth; break;
+                case ',' : {
+                    if (depth == 0) {
+                        rtn.emplace_back (trim (map_.substr (start, i - start)));
+                        start = i + 1;
+                    }
+                    break;
+                }
+                default : break;
+            }
+        }
+
+        rtn.emplace_back (trim (map_.substr (start, close - start)));
+
+        if (rtn.size() != 2 || rtn[0].empty() || rtn[1].empty()) {
+            throw std::runtime_error ("Map type \"" + map_ + "\" has no key or value type");
+        }
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
+
+amqp::internal::schema::
+Map::Map (
+    uPtr<Descriptor> & descriptor_,
+    const std::string & name_,
+    const std::string & label_,
+    const std::vector<std::string> & provides_
+) : Restricted (
+        descriptor_,
+        name_,
+        label_,
+        provides_,
+        amqp::internal::schema::Restricted::RestrictedTypes::Map)
+  , m_mapOf { mapType (name_) }
+{
+
+}
+
+/******************************************************************************/
+
+std::vector<std::string>::const_iterator
+amqp::internal::schema::
+Map::begin() const {
+    return m_mapOf.begin();
+}
+
+/******************************************************************************/
+
+std::vector<std::string>::const_iterator
+amqp::internal::schema::
+Map::end() const {
+    return m_mapOf.end();
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::schema::
+Map::keyType() const {
+    return m_mapOf[0];
+}
+
+/******************************************************************************/
+
+const std::string &
+amqp::internal::schema::
+Map::valueType() const {
+    return m_mapOf[1];
+}
+
+/******************************************************************************/
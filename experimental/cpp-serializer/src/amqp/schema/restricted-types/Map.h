@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Restricted.h"
+
+/******************************************************************************/
+
+namespace amqp::internal::schema {
+
+    /**
+     * Any java.util.Map, its name giving the types of its keys and
+     * values, "java.util.Map<string, net.corda.Amount>"
+     */
+    class Map : public Restricted {
+        private :
+            /**
+             * The key type then the value type
+             */
+            std::vector<std::string> m_mapOf;
+
+        public :
+            Map (
+                uPtr<Descriptor> & descriptor_,
+                const std::string &,
+                const std::string &,
+                const std::vector<std::string> &);
+
+            std::vector<std::string>::const_iterator begin() const override;
+            std::vector<std::string>::const_iterator end() const override;
+
+            const std::string & keyType() const;
+            const std::string & valueType() const;
+    };
+
+}
+
+/******************************************************************************/
@@ -1,9 +1,12 @@
 #include "Restricted.h"
 #include "List.h"
+#include "Map.h"
+#include "Enum.h"
 
 #include <string>
 #include <vector>
 #include <iostream>
+#include <stdexcept>
 
 /******************************************************************************/
 
@@ -49,6 +52,10 @@ operator << (
             stream_ << "map";
             break;
         }
+        case Restricted::RestrictedTypes::Enum : {
+            stream_ << "enum";
+            break;
+        }
     }
 
     return stream_;
@@ -70,6 +77,7 @@ operator << (
  * @param label_
  * @param provides_
  * @param source_
+ * @param choices_
  * @return
  */
 std::unique_ptr<amqp::internal::schema::Restricted>
@@ -79,12 +87,22 @@ Restricted::make(
         const std::string & name_,
         const std::string & label_,
         const std::vector<std::string> & provides_,
-        const std::string & source_)
+        const std::string & source_,
+        const std::vector<std::string> & choices_)
 {
     if (source_ == "list") {
         return std::make_unique<amqp::internal::schema::List> (
                 descriptor_, name_, label_, provides_, source_);
+    } else if (source_ == "map") {
+        return std::make_unique<amqp::internal::schema::Map> (
+                descriptor_, name_, label_, provides_);
+    } else if (source_ == "enum") {
+        return std::make_unique<amqp::internal::schema::Enum> (
+                descriptor_, name_, label_, provides_, choices_);
     }
+
+    throw std::runtime_error (
+            "Unsupported restricted type \"" + name_ + "\", source \"" + source_ + "\"");
 }
 
 /******************************************************************************/
@@ -121,10 +139,30 @@ Restricted::restrictedType() const {
 
 /******************************************************************************/
 
-int
+const std::string &
+amqp::internal::schema::
+Restricted::label() const {
+    return m_label;
+}
+
+/******************************************************************************/
+
+const std::vector<std::string> &
 amqp::internal::schema::
-Restricted::dependsOn (const OrderedTypeNotation & rhs_) const {
-    return dynamic_cast<const AMQPTypeNotation &>(rhs_).dependsOn(*this);
+Restricted::provides() const {
+    return m_provides;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::schema::
+Restricted::dependencies (
+    const std::function<void (const std::string &)> & f_
+) const {
+    for (auto i = begin() ; i != end() ; ++i) {
+        f_ (*i);
+    }
 }
 
 /*********************************************************o*********************/
@@ -34,7 +34,7 @@ namespace amqp::internal::schema {
         public :
             friend std::ostream & operator << (std::ostream &, const Restricted&);
 
-            enum RestrictedTypes { List, Map };
+            enum RestrictedTypes { List, Map, Enum };
 
         private :
             // could be null in the stream... not sure that information is
@@ -49,7 +49,7 @@ namespace amqp::internal::schema {
             std::vector<std::string> m_provides;
 
             /**
-             * Is it a map or list
+             * Is it a map, list or enum
              */
             RestrictedTypes m_source;
 
@@ -65,12 +65,17 @@ namespace amqp::internal::schema {
                 const RestrictedTypes &);
 
         public :
+            /**
+             * Only enums have choices, the names of their constants in
+             * ordinal order
+             */
             static std::unique_ptr<Restricted> make(
                     std::unique_ptr<Descriptor> & descriptor_,
                     const std::string &,
                     const std::string &,
                     const std::vector<std::string> &,
-                    const std::string &);
+                    const std::string &,
+                    const std::vector<std::string> & choices_ = { });
 
             Restricted (Restricted&) = delete;
 
@@ -78,6 +83,9 @@ namespace amqp::internal::schema {
 
             RestrictedTypes restrictedType() const;
 
+            const std::string & label() const;
+            const std::vector<std::string> & provides() const;
+
             /**
              * @return an iterator over the types the restricted class represents.
              * In the case of a list, the element this is a list of, in the
@@ -86,9 +94,11 @@ namespace amqp::internal::schema {
             virtual std::vector<std::string>::const_iterator begin() const = 0;
             virtual std::vector<std::string>::const_iterator end() const = 0;
 
-            int dependsOn (const OrderedTypeNotation &) const override;
-            int dependsOn (const Restricted &) const override = 0;
-            int dependsOn (const class Composite &) const override = 0;
+            /**
+             * The types we represent, as given by begin and end
+             */
+            void dependencies (
+                const std::function<void (const std::string &)> &) const override;
     };
 
 
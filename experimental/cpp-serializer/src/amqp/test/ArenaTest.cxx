@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <cstdint>
+
+#include "Arena.h"
+#include "ValueBuilder.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::reader;
+
+/******************************************************************************/
+
+TEST (Arena, alignment) { // NOLINT
+    Arena arena (64);
+
+    arena.allocate (1, 1);
+    auto * p = arena.allocate (sizeof (double), alignof (double));
+
+    ASSERT_EQ (0U, reinterpret_cast<uintptr_t> (p) % alignof (double));
+}
+
+/******************************************************************************/
+
+TEST (Arena, growth) { // NOLINT
+    Arena arena (64);
+
+    arena.allocate (48, 1);
+    ASSERT_EQ (64U, arena.capacity());
+
+    arena.allocate (48, 1);
+    ASSERT_EQ (64U + 128U, arena.capacity());
+
+    arena.allocate (1024, 1);
+    ASSERT_EQ (64U + 128U + 1024U, arena.capacity());
+}
+
+/******************************************************************************/
+
+TEST (Arena, resetKeepsLargestBlock) { // NOLINT
+    Arena arena (64);
+
+    arena.allocate (48, 1);
+    arena.allocate (48, 1);
+    arena.reset();
+
+    ASSERT_EQ (128U, arena.capacity());
+
+    arena.allocate (100, 1);
+    ASSERT_EQ (128U, arena.capacity());
+}
+
+/******************************************************************************/
+
+TEST (Arena, copy) { // NOLINT
+    Arena arena;
+
+    std::string s ("hello");
+    auto v = arena.copy (s);
+    s[0] = 'j';
+
+    ASSERT_EQ ("hello", v);
+}
+
+/******************************************************************************/
+
+TEST (Arena, valueTree) { // NOLINT
+    Arena arena;
+
+    ValueBuilder builder (arena, "Parsed");
+
+    builder.beginComposite ("net.corda.A");
+    builder.field ("a");
+    builder.value (int32_t { 1 });
+    builder.field ("b");
+    builder.beginList();
+    builder.value (std::string_view ("x"));
+    builder.value (true);
+    builder.endList();
+    builder.field ("c");
+    builder.beginComposite ("net.corda.B");
+    builder.endComposite();
+    builder.endComposite();
+
+    ASSERT_EQ (
+        R"("Parsed" : { "a" : 1, "b" : [ "x", 1 ], "c" : {  } })",
+        builder.result()->dump());
+}
+
+/******************************************************************************/
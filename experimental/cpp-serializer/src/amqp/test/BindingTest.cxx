@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include "codec/codec_wrapper.h"
+
+#include "amqp/binding/Decoder.h"
+
+#include "Blobs.h"
+
+/******************************************************************************/
+
+namespace {
+
+    struct Inner {
+        int32_t     x;
+        std::string y;
+    };
+
+    struct Outer {
+        int32_t              a;
+        Inner                b;
+        std::vector<int32_t> c;
+        std::vector<Inner>   d;
+    };
+
+    /*
+     * Some of the fields, not in the order the type has them
+     */
+    struct Partial {
+        std::vector<Inner> d;
+        int32_t            a;
+    };
+
+    struct Wrong {
+        int64_t a;
+    };
+
+    struct Missing {
+        int32_t e;
+    };
+
+}
+
+/******************************************************************************/
+
+namespace amqp::binding {
+
+    template<>
+    struct Binding<Inner> {
+        static constexpr std::string_view type { "net.corda.Inner" };
+
+        static constexpr auto fields = std::make_tuple (
+            field ("x", &Inner::x),
+            field ("y", &Inner::y));
+    };
+
+    template<>
+    struct Binding<Outer> {
+        static constexpr std::string_view type { "net.corda.Outer" };
+
+        static constexpr auto fields = std::make_tuple (
+            field ("a", &Outer::a),
+            field ("b", &Outer::b),
+            field ("c", &Outer::c),
+            field ("d", &Outer::d));
+    };
+
+    template<>
+    struct Binding<Partial> {
+        static constexpr std::string_view type { "net.corda.Outer" };
+
+        static constexpr auto fields = std::make_tuple (
+            field ("d", &Partial::d),
+            field ("a", &Partial::a));
+    };
+
+    template<>
+    struct Binding<Wrong> {
+        static constexpr std::string_view type { "net.corda.Outer" };
+
+        static constexpr auto fields = std::make_tuple (field ("a", &Wrong::a));
+    };
+
+    template<>
+    struct Binding<Missing> {
+        static constexpr std::string_view type { "net.corda.Outer" };
+
+        static constexpr auto fields = std::make_tuple (field ("e", &Missing::e));
+    };
+
+}
+
+/******************************************************************************/
+
+namespace {
+
+    using amqp::internal::binding::Plans;
+
+    template<typename T>
+    T
+    bound (const test::Readers & readers_, const std::string & blob_) {
+        Plans plans;
+        const auto & plan = plans.get<T> (*readers_.outer, "net.corda.Outer");
+
+        codec::Cursor cursor (blob_.data(), blob_.size());
+        cursor.next();
+
+        T rtn { };
+        amqp::internal::binding::decode (&cursor, rtn, plan);
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Binding, everything) { // NOLINT
+    test::Readers readers;
+
+    auto outer = bound<Outer> (readers, test::outerBlob (1));
+
+    EXPECT_EQ (1, outer.a);
+    EXPECT_EQ (2, outer.b.x);
+    EXPECT_EQ ("two", outer.b.y);
+    EXPECT_EQ ((std::vector<int32_t> { 3, 4 }), outer.c);
+    ASSERT_EQ (2U, outer.d.size());
+    EXPECT_EQ (5, outer.d[0].x);
+    EXPECT_EQ ("six", outer.d[1].y);
+}
+
+/******************************************************************************/
+
+TEST (Binding, outOfOrder) { // NOLINT
+    test::Readers readers;
+
+    Plans plans;
+    EXPECT_FALSE (plans.get<Partial> (*readers.outer, "net.corda.Outer").ordered);
+    EXPECT_TRUE (plans.get<Outer> (*readers.outer, "net.corda.Outer").ordered);
+
+    auto partial = bound<Partial> (readers, test::outerBlob (7));
+
+    EXPECT_EQ (7, partial.a);
+    ASSERT_EQ (2U, partial.d.size());
+    EXPECT_EQ ("five", partial.d[0].y);
+}
+
+/******************************************************************************/
+
+/*
+ * Skipping fields has to leave the cursor after the whole object
+ */
+TEST (Binding, movesOn) { // NOLINT
+    test::Readers readers;
+
+    Plans plans;
+    const auto & plan = plans.get<Partial> (*readers.outer, "net.corda.Outer");
+
+    auto blob = test::list ({ test::outerBlob (1), test::outerBlob (2), test::smallint (3) });
+    codec::Cursor cursor (blob.data(), blob.size());
+    cursor.next();
+
+    codec::auto_enter ae (&cursor);
+
+    Partial p;
+    amqp::internal::binding::decode (&cursor, p, plan);
+    EXPECT_EQ (1, p.a);
+    amqp::internal::binding::decode (&cursor, p, plan);
+    EXPECT_EQ (2, p.a);
+    EXPECT_EQ (3, codec::readAndNext<int32_t> (&cursor));
+}
+
+/******************************************************************************/
+
+/*
+ * d refers back to b which, skipped, is numbered regardless. Each of
+ * the objects is numbered on its own.
+ */
+TEST (Binding, references) { // NOLINT
+    test::Readers readers;
+
+    auto outer = bound<Outer> (readers, test::sharedBlob());
+    ASSERT_EQ (2U, outer.d.size());
+    EXPECT_EQ ("two", outer.d[0].y);
+    EXPECT_EQ ("six", outer.d[1].y);
+
+    Plans plans;
+    const auto & plan = plans.get<Partial> (*readers.outer, "net.corda.Outer");
+
+    auto blob = test::list ({ test::sharedBlob(), test::sharedBlob() });
+    codec::Cursor cursor (blob.data(), blob.size());
+    cursor.next();
+
+    codec::auto_enter ae (&cursor);
+
+    for (int i { 0 } ; i < 2 ; ++i) {
+        Partial p;
+        amqp::internal::binding::decode (&cursor, p, plan);
+
+        ASSERT_EQ (2U, p.d.size());
+        EXPECT_EQ (2, p.d[0].x);
+        EXPECT_EQ ("two", p.d[0].y);
+        EXPECT_EQ (6, p.d[1].x);
+    }
+}
+
+/******************************************************************************/
+
+TEST (Binding, mismatches) { // NOLINT
+    test::Readers readers;
+
+    EXPECT_THROW (bound<Wrong> (readers, test::outerBlob (1)), std::runtime_error); // NOLINT
+    EXPECT_THROW (bound<Missing> (readers, test::outerBlob (1)), std::runtime_error); // NOLINT
+    EXPECT_THROW (bound<Outer> (readers, test::innerBlob (1, "one")), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
@@ -0,0 +1,353 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <list>
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+#include "codec/Cursor.h"
+
+#include "amqp/schema/Field.h"
+#include "amqp/schema/Schema.h"
+#include "amqp/schema/Composite.h"
+#include "amqp/schema/Descriptor.h"
+#include "amqp/schema/restricted-types/Restricted.h"
+#include "amqp/reader/JsonWriter.h"
+#include "amqp/reader/PropertyReader.h"
+#include "amqp/reader/CompositeReader.h"
+#include "amqp/reader/restricted-readers/ListReader.h"
+#include "amqp/descriptors/AMQPDescriptorRegistory.h"
+
+#include "serialiser/Encoder.h"
+
+/******************************************************************************
+ *
+ * Hand encoded blobs, and the readers for them, for tests that need an
+ * object graph without going through a schema
+ *
+ ******************************************************************************/
+
+namespace test {
+
+    using namespace amqp::internal::reader;
+
+    inline std::string
+    sym (const std::string & s_) {
+        return std::string ("\xa3", 1) + static_cast<char>(s_.size()) + s_;
+    }
+
+    inline std::string
+    str (const std::string & s_) {
+        return std::string ("\xa1", 1) + static_cast<char>(s_.size()) + s_;
+    }
+
+    inline std::string
+    smallint (int8_t i_) {
+        return std::string ("\x54", 1) + static_cast<char>(i_);
+    }
+
+    inline std::string
+    list (const std::vector<std::string> & elements_) {
+        std::string body;
+        for (const auto & e : elements_) body += e;
+
+        if (body.size() < 255) {
+            return std::string ("\xc0", 1)
+                + static_cast<char>(body.size() + 1)
+                + static_cast<char>(elements_.size())
+                + body;
+        }
+
+        auto be32 = [](uint32_t i_) {
+            return std::string {
+                static_cast<char>(i_ >> 24U), static_cast<char>(i_ >> 16U),
+                static_cast<char>(i_ >> 8U), static_cast<char>(i_) };
+        };
+
+        return std::string ("\xd0", 1)
+            + be32 (body.size() + 4)
+            + be32 (elements_.size())
+            + body;
+    }
+
+    /*
+     * Keys and values one after the other
+     */
+    inline std::string
+    map (const std::vector<std::string> & elements_) {
+        std::string body;
+        for (const auto & e : elements_) body += e;
+
+        return std::string ("\xc1", 1)
+            + static_cast<char>(body.size() + 1)
+            + static_cast<char>(elements_.size())
+            + body;
+    }
+
+    inline std::string
+    described (const std::string & descriptor_, const std::string & body_) {
+        return std::string (1, '\0') + sym (descriptor_) + body_;
+    }
+
+    /*
+     * A back reference to the index_'th object of the blob
+     */
+    inline std::string
+    reference (uint8_t index_) {
+        return std::string ("\0\x80\xc5\x62\0\0\0\0\0\x08\x52", 11)
+            + static_cast<char>(index_);
+    }
+
+    /*
+     * Described by one of Corda's own descriptors, SCHEMA, CHOICE and the
+     * like, see AMQPDescriptorRegistory
+     */
+    inline std::string
+    corda (int id_, const std::string & body_) {
+        std::string rtn;
+        amqp::internal::serialiser::Encoder out (rtn);
+        out.putDescribed (id_);
+
+        return rtn + body_;
+    }
+
+    /*
+     * What the JVM writes for an enum constant, its name then its ordinal
+     */
+    inline std::string
+    constant (
+        const std::string & name_,
+        int8_t ordinal_,
+        const std::string & descriptor_ = "net.corda:colour"
+    ) {
+        return described (descriptor_, list ({ str (name_), smallint (ordinal_) }));
+    }
+
+    /*
+     * The OBJECT_DESCRIPTOR of a type in a schema section
+     */
+    inline void
+    objectDescriptor (amqp::internal::serialiser::Encoder & out_, const std::string & symbol_) {
+        out_.putDescribed (amqp::internal::OBJECT_DESCRIPTOR);
+        auto list = out_.beginList();
+        out_.putSymbol (symbol_);
+        out_.putNull();
+        out_.endList (list, 2);
+    }
+
+    /*
+     * The RESTRICTED_TYPE of an enum, its choices as names and ordinals
+     * in whatever order they're given
+     */
+    inline void
+    enumType (
+        amqp::internal::serialiser::Encoder & out_,
+        const std::string & name_,
+        const std::string & descriptor_,
+        const std::vector<std::pair<std::string, std::string>> & choices_
+    ) {
+        using namespace amqp::internal;
+
+        out_.putDescribed (RESTRICTED_TYPE);
+        auto restricted = out_.beginList();
+        out_.putString (name_);
+        out_.putNull();
+        out_.putEmptyList();
+        out_.putString ("enum");
+        objectDescriptor (out_, descriptor_);
+
+        auto choices = out_.beginList();
+        for (const auto & [name, ordinal] : choices_) {
+            out_.putDescribed (CHOICE);
+            auto choice = out_.beginList();
+            out_.putString (name);
+            out_.putString (ordinal);
+            out_.endList (choice, 2);
+        }
+        out_.endList (choices, choices_.size());
+
+        out_.endList (restricted, 6);
+    }
+
+    /*
+     * A schema section holding just the one enum, by default
+     * net.corda.Colour { RED, GREEN, BLUE } with its choices out of order
+     */
+    inline std::string
+    enumSchema (
+        const std::vector<std::pair<std::string, std::string>> & choices_ = {
+            { "GREEN", "1" }, { "RED", "0" }, { "BLUE", "2" } },
+        const std::string & name_ = "net.corda.Colour",
+        const std::string & descriptor_ = "net.corda:colour"
+    ) {
+        std::string rtn;
+        amqp::internal::serialiser::Encoder out (rtn);
+
+        out.putDescribed (amqp::internal::SCHEMA);
+        auto schema = out.beginList();
+        auto types = out.beginList();
+        enumType (out, name_, descriptor_, choices_);
+        out.endList (types, 1);
+        out.endList (schema, 1);
+
+        return rtn;
+    }
+
+    /*
+     * A restricted type for a schema built in place, described by
+     * net.corda:<source> unless told otherwise
+     */
+    inline uPtr<amqp::internal::schema::Restricted>
+    restricted (
+        const std::string & name_,
+        const std::string & source_,
+        const std::string & descriptor_ = "",
+        const std::vector<std::string> & choices_ = { }
+    ) {
+        using namespace amqp::internal::schema;
+
+        auto descriptor = std::make_unique<Descriptor> (
+            descriptor_.empty() ? "net.corda:" + source_ : descriptor_);
+
+        return Restricted::make (descriptor, name_, "", { }, source_, choices_);
+    }
+
+    /*
+     * A composite for a schema built in place, its fields as names and
+     * types. As the JVM writes them a field of a generic type is "*"
+     * requiring that type, anything else names its type directly
+     */
+    inline uPtr<amqp::internal::schema::Composite>
+    composite (
+        const std::string & name_,
+        const std::string & descriptor_,
+        const std::vector<std::pair<std::string, std::string>> & fields_
+    ) {
+        using namespace amqp::internal::schema;
+
+        std::vector<uPtr<Field>> fields;
+        for (const auto & [name, type] : fields_) {
+            if (type.find ('<') == std::string::npos) {
+                fields.emplace_back (std::make_unique<Field> (
+                    name, type, std::list<std::string> { }, "", "", true, false));
+            } else {
+                fields.emplace_back (std::make_unique<Field> (
+                    name, "*", std::list<std::string> { type }, "", "", true, false));
+            }
+        }
+
+        auto descriptor = std::make_unique<Descriptor> (descriptor_);
+
+        return std::make_unique<Composite> (
+            name_, "", std::list<std::string> { }, descriptor, fields);
+    }
+
+    /*
+     * net.corda.Outer {
+     *     a : int
+     *     b : net.corda.Inner { x : int, y : string }
+     *     c : List<int>
+     *     d : List<net.corda.Inner>
+     * }
+     */
+    struct Readers {
+        std::shared_ptr<Reader>          integer;
+        std::shared_ptr<Reader>          string;
+        std::shared_ptr<CompositeReader> inner;
+        std::shared_ptr<ListReader>      ints;
+        std::shared_ptr<ListReader>      inners;
+        std::shared_ptr<CompositeReader> outer;
+
+        Readers()
+            : integer (PropertyReader::make ("int"))
+            , string (PropertyReader::make ("string"))
+        {
+            inner = std::make_shared<CompositeReader> (
+                "net.corda.Inner", "net.corda:inner",
+                std::vector<CompositeReader::Field> {
+                    { "x", integer }, { "y", string } });
+
+            ints = std::make_shared<ListReader> ("List<int>", integer);
+            inners = std::make_shared<ListReader> ("List<net.corda.Inner>", inner);
+
+            outer = std::make_shared<CompositeReader> (
+                "net.corda.Outer", "net.corda:outer",
+                std::vector<CompositeReader::Field> {
+                    { "a", integer }, { "b", inner }, { "c", ints }, { "d", inners } });
+
+            inner->freeze();
+            ints->freeze();
+            inners->freeze();
+            outer->freeze();
+        }
+    };
+
+    inline std::string
+    innerBlob (int8_t x_, const std::string & y_) {
+        return described ("net.corda:inner", list ({ smallint (x_), str (y_) }));
+    }
+
+    inline std::string
+    outerBlob (int8_t a_) {
+        return described ("net.corda:outer", list ({
+            smallint (a_),
+            innerBlob (2, "two"),
+            described ("net.corda:list", list ({ smallint (3), smallint (4) })),
+            described ("net.corda:list", list ({
+                innerBlob (5, "five"), innerBlob (6, "six") }))
+        }));
+    }
+
+    /*
+     * d starting with b again. What the JVM wrote with writeObject, and
+     * so numbered, is
+     *
+     *   0 b, 1 c, 2 the second of d, 3 d, 4 the whole thing
+     *
+     * Neither a nor the strings are, int and String fields are written
+     * in place, so nothing can refer to them.
+     */
+    inline std::string
+    sharedBlob() {
+        return described ("net.corda:outer", list ({
+            smallint (1),
+            innerBlob (2, "two"),
+            described ("net.corda:list", list ({ smallint (3), smallint (4) })),
+            described ("net.corda:list", list ({
+                reference (0), innerBlob (6, "six") }))
+        }));
+    }
+
+    inline const amqp::internal::schema::Schema &
+    schema() {
+        static const amqp::internal::schema::Schema schema {
+            amqp::internal::schema::OrderedTypeNotations<
+                    amqp::internal::schema::AMQPTypeNotation> { } };
+
+        return schema;
+    }
+
+    /*
+     * Run f_ with a cursor on the blob and a JsonWriter, handing back
+     * whatever it wrote
+     */
+    template<typename F>
+    std::string
+    json (const std::string & blob_, F f_) {
+        codec::Cursor cursor (blob_.data(), blob_.size());
+        cursor.next();
+
+        JsonWriter json;
+        f_ (&cursor, json);
+        json.endDocument();
+
+        return json.take();
+    }
+
+}
+
+/******************************************************************************/
+
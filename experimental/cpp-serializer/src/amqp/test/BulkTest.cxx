@@ -0,0 +1,311 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+
+#include "codec/Bulk.h"
+#include "codec/Cursor.h"
+#include "codec/ByteSwap.h"
+
+#include "amqp/binding/Decoder.h"
+#include "amqp/schema/restricted-types/List.h"
+
+#include "Blobs.h"
+
+/******************************************************************************/
+
+namespace {
+
+    std::string
+    be (uint64_t value_, size_t width_) {
+        std::string rtn;
+        for (size_t b { width_ } ; b > 0 ; --b) {
+            rtn += static_cast<char>(value_ >> (8U * (b - 1)));
+        }
+
+        return rtn;
+    }
+
+    /*
+     * An array32 of values_, each width_ bytes, all with constructor code_
+     */
+    std::string
+    array (char code_, size_t width_, const std::vector<uint64_t> & values_) {
+        std::string body (1, code_);
+        for (auto v : values_) body += be (v, width_);
+
+        return std::string ("\xf0", 1) + be (body.size() + 4, 4) + be (values_.size(), 4) + body;
+    }
+
+    /*
+     * Every length up to a few registers' worth, to take each kernel
+     * through its tail
+     */
+    template<typename T, typename F>
+    void
+    swapped (F swap_) {
+        for (size_t n { 0 } ; n < 70 ; ++n) {
+            std::string in;
+            std::vector<T> expected;
+
+            for (size_t i { 0 } ; i < n ; ++i) {
+                auto v = static_cast<T>(0x0102030405060708ULL * (i + 1));
+                in += be (v, sizeof (T));
+                expected.push_back (v);
+            }
+
+            // offset by one so nothing is aligned
+            std::string unaligned = "x" + in;
+            std::vector<T> out (n + 1, T { 0x55 });
+
+            swap_ (unaligned.data() + 1, out.data(), n);
+
+            EXPECT_EQ (T { 0x55 }, out[n]) << n;
+            out.resize (n);
+            EXPECT_EQ (expected, out) << n;
+        }
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Bulk, byteswap) { // NOLINT
+    swapped<uint16_t> (codec::byteswap16);
+    swapped<uint32_t> (codec::byteswap32);
+    swapped<uint64_t> (codec::byteswap64);
+
+    std::string kernel = codec::byteswapKernel();
+    EXPECT_TRUE (kernel == "avx2" || kernel == "ssse3" || kernel == "scalar");
+}
+
+/******************************************************************************/
+
+TEST (Bulk, arrayElements) { // NOLINT
+    auto blob = array ('\x81', 8, { 1, 2, 3 }) + test::list ({ test::smallint (1) });
+
+    codec::Cursor cursor (blob.data(), blob.size());
+    cursor.next();
+
+    uint8_t code;
+    auto elements = cursor.getArrayElements (code);
+    EXPECT_EQ (0x81, code);
+    EXPECT_EQ (24U, elements.size());
+    EXPECT_EQ (blob.data() + 10, elements.data());
+
+    cursor.next();
+    EXPECT_TRUE (cursor.getArrayElements (code).empty());
+    EXPECT_EQ (0, code);
+
+    blob = std::string ("\xe0\x06\x02\xa1", 4) + std::string ("\x01" "a\x01" "b", 4);
+    codec::Cursor strings (blob.data(), blob.size());
+    strings.next();
+
+    EXPECT_TRUE (strings.getArrayElements (code).empty());
+}
+
+/******************************************************************************/
+
+/*
+ * An array claiming more elements than its size holds, or too small to
+ * hold its own count, mustn't be read into whatever follows it
+ */
+TEST (Bulk, arrayBounds) { // NOLINT
+    std::string blob = std::string ("\xe0\x02\x03\x71", 4) + "\xa1\x0bhello world";
+
+    codec::Cursor cursor (blob.data(), blob.size());
+    cursor.next();
+
+    uint8_t code;
+    EXPECT_THROW (cursor.getArrayElements (code), std::runtime_error); // NOLINT
+
+    std::vector<int32_t> ints;
+    EXPECT_THROW (codec::readAll (&cursor, ints), std::runtime_error); // NOLINT
+
+    for (const auto & header : {
+            std::string ("\xe0\x00", 2),
+            std::string ("\xf0\x00\x00\x00\x02\x00\x00", 7) }
+    ) {
+        std::vector<char> bytes (header.begin(), header.end());
+        codec::Cursor c (bytes.data(), bytes.size());
+        c.next();
+
+        EXPECT_THROW (c.getArrayElements (code), std::runtime_error); // NOLINT
+        EXPECT_THROW (c.enter(), std::runtime_error); // NOLINT
+    }
+
+    // a described constructor running past the array's end
+    blob = std::string ("\xe0\x03\x01\x00\xa3", 5) + std::string ("\x04net.corda", 10);
+    codec::Cursor described (blob.data(), blob.size());
+    described.next();
+
+    EXPECT_THROW (described.enter(), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+TEST (Bulk, readAll) { // NOLINT
+    auto blob = array ('\x81', 8, { 1, static_cast<uint64_t>(-2), 0x7fffffffffffffffULL })
+        + test::list ({ std::string ("\x55\x01", 2), std::string ("\x55\xfe", 2), be (0x81, 1) + be (300, 8) })
+        + array ('\x55', 1, { 1, 0xff })
+        + test::list ({ std::string ("\x81", 1) + be (1, 8), std::string ("\x40", 1) })
+        + std::string ("\x45", 1)
+        + test::smallint (1);
+
+    codec::Cursor cursor (blob.data(), blob.size());
+    cursor.next();
+
+    std::vector<int64_t> longs;
+
+    ASSERT_TRUE (codec::readAll (&cursor, longs));
+    EXPECT_EQ ((std::vector<int64_t> { 1, -2, 0x7fffffffffffffffLL }), longs);
+
+    // longs can't be ints, nothing moves
+    std::vector<int32_t> ints;
+    EXPECT_FALSE (codec::readAll (&cursor, ints));
+    EXPECT_EQ (codec::AMQP_LIST, cursor.type());
+
+    // a list of them though
+    longs.push_back (7);
+    ASSERT_TRUE (codec::readAll (&cursor, longs));
+    EXPECT_EQ ((std::vector<int64_t> { 1, -2, 300 }), longs);
+
+    // an array of the compact form
+    ASSERT_TRUE (codec::readAll (&cursor, longs));
+    EXPECT_EQ ((std::vector<int64_t> { 1, -1 }), longs);
+
+    // a null, again nothing moves
+    EXPECT_FALSE (codec::readAll (&cursor, longs));
+    EXPECT_EQ (codec::AMQP_LIST, cursor.type());
+    EXPECT_EQ (2U, cursor.getList());
+
+    cursor.next();
+    ASSERT_TRUE (codec::readAll (&cursor, longs));
+    EXPECT_TRUE (longs.empty());
+
+    // not a list at all
+    EXPECT_FALSE (codec::readAll (&cursor, longs));
+    EXPECT_EQ (codec::AMQP_INT, cursor.type());
+}
+
+/******************************************************************************/
+
+TEST (Bulk, types) { // NOLINT
+    auto blob = array ('\x61', 2, { 0xfffe, 3 })
+        + array ('\x72', 4, { 0x3fc00000 })
+        + array ('\x82', 8, { 0x3ff0000000000000ULL, 0xc000000000000000ULL })
+        + array ('\x73', 4, { 'a', 0x20ac })
+        + array ('\x51', 1, { 0x80, 0x7f });
+
+    codec::Cursor cursor (blob.data(), blob.size());
+    cursor.next();
+
+    std::vector<int16_t> shorts;
+    ASSERT_TRUE (codec::readAll (&cursor, shorts));
+    EXPECT_EQ ((std::vector<int16_t> { -2, 3 }), shorts);
+
+    std::vector<float> floats;
+    ASSERT_TRUE (codec::readAll (&cursor, floats));
+    EXPECT_EQ ((std::vector<float> { 1.5F }), floats);
+
+    std::vector<double> doubles;
+    ASSERT_TRUE (codec::readAll (&cursor, doubles));
+    EXPECT_EQ ((std::vector<double> { 1.0, -2.0 }), doubles);
+
+    std::vector<char32_t> chars;
+    ASSERT_TRUE (codec::readAll (&cursor, chars));
+    EXPECT_EQ ((std::vector<char32_t> { U'a', U'€' }), chars);
+
+    std::vector<int8_t> bytes;
+    ASSERT_TRUE (codec::readAll (&cursor, bytes));
+    EXPECT_EQ ((std::vector<int8_t> { -128, 127 }), bytes);
+}
+
+/******************************************************************************/
+
+/*
+ * int[p] as the JVM writes it, a described array, printed and read as any
+ * other list would be
+ */
+TEST (Bulk, listReader) { // NOLINT
+    auto integer = amqp::internal::reader::PropertyReader::make ("int");
+    auto character = amqp::internal::reader::PropertyReader::make ("char");
+
+    amqp::internal::reader::ListReader ints ("int[p]", integer);
+    amqp::internal::reader::ListReader chars ("char[p]", character);
+
+    ints.freeze();
+    chars.freeze();
+
+    auto visit = [](const auto & reader_, const std::string & blob_) {
+        return test::json (blob_, [&](codec::Cursor * c_, auto & json_) {
+            reader_.visit (c_, test::schema(), json_);
+        });
+    };
+
+    auto described = test::described ("net.corda:ints", array ('\x71', 4, { 1, 0xffffffff, 3 }));
+
+    EXPECT_EQ ("[ 1, -1, 3 ]\n", visit (ints, described));
+    EXPECT_EQ ("[ \"a\", \"b\" ]\n",
+        visit (chars, test::described ("net.corda:chars", array ('\x73', 4, { 'a', 'b' }))));
+
+    // with a null the element reader takes over, as ever reading it as 0
+    EXPECT_EQ ("[ 1, 0 ]\n", visit (ints, test::described ("net.corda:ints",
+        test::list ({ test::smallint (1), std::string ("\x40", 1) }))));
+
+    codec::Cursor cursor (described.data(), described.size());
+    cursor.next();
+
+    auto variant = ints.read (&cursor);
+    ASSERT_EQ (3U, variant.asList().size());
+    EXPECT_EQ (-1, variant[1].asInt());
+}
+
+/******************************************************************************/
+
+TEST (Bulk, schemaNames) { // NOLINT
+    using namespace amqp::internal::schema;
+
+    for (const auto & [name, of] : {
+            std::make_pair ("int[p]", "int"),
+            std::make_pair ("java.lang.Integer[]", "java.lang.Integer"),
+            std::make_pair ("long[p][]", "long[p]"),
+            std::make_pair ("java.util.List<int>", "int") }
+    ) {
+        auto list = test::restricted (name, "list");
+
+        EXPECT_EQ (of, dynamic_cast<const List &>(*list).listOf());
+    }
+
+    for (const auto & name : { "java.util.List_int]", "java.util.List", "" }) {
+        EXPECT_THROW (test::restricted (name, "list"), std::runtime_error) << name; // NOLINT
+    }
+}
+
+/******************************************************************************/
+
+TEST (Bulk, binding) { // NOLINT
+    test::Readers readers;
+
+    amqp::internal::binding::Plans plans;
+    auto plan = amqp::internal::binding::Member<std::vector<int32_t>>::plan (
+        *readers.ints, plans, "c");
+
+    auto blob = test::described ("net.corda:list", array ('\x71', 4, { 5, 6, 7 }))
+        + test::described ("net.corda:list", test::list ({
+            test::smallint (8), std::string ("\x40", 1) }));
+
+    codec::Cursor cursor (blob.data(), blob.size());
+    cursor.next();
+
+    std::vector<int32_t> out;
+    amqp::internal::binding::Member<std::vector<int32_t>>::decode (&cursor, out, plan);
+    EXPECT_EQ ((std::vector<int32_t> { 5, 6, 7 }), out);
+
+    amqp::internal::binding::Member<std::vector<int32_t>>::decode (&cursor, out, plan);
+    EXPECT_EQ ((std::vector<int32_t> { 8, 0 }), out);
+}
+
+/******************************************************************************/
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <sstream>
+
+#include "amqp/CodeGenerator.h"
+
+#include "Blobs.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal;
+using namespace amqp::internal::schema;
+
+/******************************************************************************/
+
+namespace {
+
+    /*
+     * net.corda.A (a : int, <second> : List<net.corda.B>)
+     * net.corda.B (class : string)
+     */
+    uPtr<Schema>
+    testSchema (const std::string & second_, const std::string & descriptor_) {
+        OrderedTypeNotations<AMQPTypeNotation> types;
+
+        types.insert (test::composite ("net.corda.B", "net.corda:B", {
+            { "class", "string" } }));
+        types.insert (test::restricted ("java.util.List<net.corda.B>", "list"));
+        types.insert (test::composite ("net.corda.A", descriptor_, {
+            { "a", "int" }, { second_, "java.util.List<net.corda.B>" } }));
+
+        return std::make_unique<Schema> (std::move (types));
+    }
+
+    bool
+    contains (const std::string & haystack_, const std::string & needle_) {
+        return haystack_.find (needle_) != std::string::npos;
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (CodeGenerator, header) { // NOLINT
+    CodeGenerator generator ("test::gen");
+    generator.add (*testSchema ("bs", "net.corda:A"));
+
+    std::stringstream ss;
+    generator.header (ss);
+    auto header = ss.str();
+
+    EXPECT_TRUE (contains (header, "namespace test::gen {"));
+    EXPECT_TRUE (contains (header, "        int32_t a { };\n"));
+    EXPECT_TRUE (contains (header, "        std::vector<B> bs { };\n"));
+
+    // keywords can't be used as member names
+    EXPECT_TRUE (contains (header, "        std::string class_ { };\n"));
+    EXPECT_TRUE (contains (header, "field (\"class\", &test::gen::B::class_)"));
+
+    // B has to be defined before anything that holds it
+    EXPECT_LT (header.find ("struct B {"), header.find ("struct A {"));
+
+    EXPECT_TRUE (contains (header, "struct Binding<test::gen::A>"));
+    EXPECT_TRUE (contains (header, "\"net.corda.A\""));
+    EXPECT_TRUE (contains (header, "descriptor {\n            \"net.corda:A\" };"));
+}
+
+/******************************************************************************/
+
+/*
+ * Two versions of A, only what they have in common is bound
+ */
+TEST (CodeGenerator, versions) { // NOLINT
+    CodeGenerator generator ("gen");
+    generator.add (*testSchema ("bs", "net.corda:A1"));
+    generator.add (*testSchema ("cs", "net.corda:A2"));
+
+    std::stringstream ss;
+    generator.header (ss);
+    auto header = ss.str();
+
+    EXPECT_TRUE (contains (header, "net.corda:A1"));
+    EXPECT_TRUE (contains (header, "net.corda:A2"));
+    EXPECT_TRUE (contains (header, "        int32_t a { };\n"));
+    EXPECT_FALSE (contains (header, "std::vector<B> bs"));
+    EXPECT_FALSE (contains (header, "std::vector<B> cs"));
+    EXPECT_TRUE (contains (header, "// bs : java.util.List<net.corda.B>, not in every version"));
+
+    // neither version's descriptor fits the struct
+    EXPECT_FALSE (contains (header, "descriptor {\n            \"net.corda:A"));
+    EXPECT_TRUE (contains (header, "descriptor {\n            \"net.corda:B\" };"));
+}
+
+/******************************************************************************/
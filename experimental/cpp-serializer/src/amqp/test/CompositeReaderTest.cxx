@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <stdexcept>
+
+#include "Blobs.h"
+
+/******************************************************************************/
+
+using namespace test;
+
+/******************************************************************************/
+
+TEST (CompositeReader, descriptor) { // NOLINT
+    Readers readers;
+
+    auto blob = innerBlob (1, "one");
+
+    EXPECT_EQ ("{ \"x\" : 1, \"y\" : \"one\" }\n",
+        json (blob, [&](codec::Cursor * c_, JsonWriter & json_) {
+            readers.inner->visit (c_, schema(), json_);
+        }));
+
+    codec::Cursor cursor (blob.data(), blob.size());
+    cursor.next();
+    EXPECT_EQ (1, readers.inner->read (&cursor)[0].asInt());
+}
+
+/******************************************************************************/
+
+/*
+ * Something described by anything but our own descriptor, even one
+ * whose fields would line up, is an error rather than misread
+ */
+TEST (CompositeReader, wrongDescriptor) { // NOLINT
+    Readers readers;
+
+    auto blob = described ("net.corda:other", list ({ smallint (1), str ("one") }));
+
+    try {
+        json (blob, [&](codec::Cursor * c_, JsonWriter & json_) {
+            readers.inner->visit (c_, schema(), json_);
+        });
+        FAIL() << "visited an instance of another type";
+    } catch (const std::runtime_error & e) {
+        EXPECT_EQ (
+            std::string ("Expected an instance of net.corda.Inner (net.corda:inner)"
+                " but found net.corda:other"),
+            e.what());
+    }
+
+    codec::Cursor cursor (blob.data(), blob.size());
+    cursor.next();
+    EXPECT_THROW (readers.inner->read (&cursor), std::runtime_error); // NOLINT
+
+    // same length, differing only at the end
+    auto nested = described ("net.corda:outer", list ({
+        smallint (1),
+        described ("net.corda:innex", list ({ smallint (2), str ("two") })),
+        described ("net.corda:list", list ({ })),
+        described ("net.corda:list", list ({ })) }));
+
+    EXPECT_THROW ( // NOLINT
+        json (nested, [&](codec::Cursor * c_, JsonWriter & json_) {
+            readers.outer->visit (c_, schema(), json_);
+        }),
+        std::runtime_error);
+}
+
+/******************************************************************************/
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "codec/Cursor.h"
+#include "codec/codec_wrapper.h"
+
+/******************************************************************************/
+
+namespace {
+
+    /*
+     * described (ulong 0xc562000000000001) [ "abc", int 7, [ true, null ] ]
+     */
+    const std::vector<char> composite {
+        0x00,
+            static_cast<char>(0x80), static_cast<char>(0xc5), 0x62, 0, 0, 0, 0, 0, 1,
+            static_cast<char>(0xc0), 13, 3,
+                static_cast<char>(0xa1), 3, 'a', 'b', 'c',
+                0x54, 7,
+                static_cast<char>(0xc0), 3, 2,
+                    0x41,
+                    0x40
+    };
+
+}
+
+/******************************************************************************/
+
+TEST (Cursor, navigation) { // NOLINT
+    codec::Cursor c (composite.data(), composite.size());
+
+    ASSERT_EQ (codec::AMQP_INVALID, c.type());
+    ASSERT_TRUE (c.next());
+    ASSERT_EQ (codec::AMQP_DESCRIBED, c.type());
+    ASSERT_EQ (composite.size(), c.bytes().size());
+
+    ASSERT_TRUE (c.enter());
+    ASSERT_TRUE (c.next());
+    ASSERT_EQ (codec::AMQP_ULONG, c.type());
+    EXPECT_EQ (0xc562000000000001UL, c.getULong());
+
+    ASSERT_TRUE (c.next());
+    ASSERT_EQ (codec::AMQP_LIST, c.type());
+    EXPECT_EQ (3, c.getList());
+
+    {
+        codec::auto_enter ae (&c);
+
+        EXPECT_EQ ("abc", codec::readAndNext<std::string> (&c));
+        EXPECT_EQ (7, codec::readAndNext<int32_t> (&c));
+
+        codec::auto_list_enter ale (&c, true);
+        EXPECT_EQ (2, ale.elements());
+        EXPECT_TRUE (codec::readAndNext<bool> (&c));
+        EXPECT_EQ (codec::AMQP_NULL, c.type());
+        EXPECT_FALSE (c.next());
+    }
+
+    // exiting leaves us back on the list we entered
+    ASSERT_EQ (codec::AMQP_LIST, c.type());
+    EXPECT_FALSE (c.next());
+
+    ASSERT_TRUE (c.exit());
+    ASSERT_EQ (codec::AMQP_DESCRIBED, c.type());
+    EXPECT_FALSE (c.next());
+}
+
+/******************************************************************************/
+
+TEST (Cursor, zeroCopy) { // NOLINT
+    codec::Cursor c (composite.data(), composite.size());
+
+    c.next();
+    codec::auto_enter ae (&c, true);
+    codec::auto_enter ae2 (&c);
+
+    auto str = c.getString();
+
+    EXPECT_EQ ("abc", str);
+    EXPECT_EQ (composite.data() + 15, str.data());
+}
+
+/******************************************************************************/
+
+TEST (Cursor, array) { // NOLINT
+    /*
+     * array8 of three ints sharing one constructor
+     */
+    const std::vector<char> array {
+        static_cast<char>(0xe0), 14, 3, 0x71,
+            0, 0, 0, 1,
+            0, 0, 0, 2,
+            0, 0, 1, 0
+    };
+
+    codec::Cursor c (array.data(), array.size());
+
+    c.next();
+    ASSERT_EQ (codec::AMQP_ARRAY, c.type());
+    ASSERT_EQ (3, c.getArray());
+
+    std::vector<int32_t> values;
+    c.enter();
+    while (c.next()) {
+        ASSERT_EQ (codec::AMQP_INT, c.type());
+        values.push_back (c.getInt());
+    }
+    c.exit();
+
+    EXPECT_EQ ((std::vector<int32_t> { 1, 2, 256 }), values);
+}
+
+/******************************************************************************/
+
+TEST (Cursor, overrun) { // NOLINT
+    const std::vector<char> truncated {
+        static_cast<char>(0xa1), 10, 'a', 'b'
+    };
+
+    codec::Cursor c (truncated.data(), truncated.size());
+
+    EXPECT_THROW (c.next(), std::runtime_error);
+}
+
+/******************************************************************************/
+
+/*
+ * Lists and maps whose size doesn't leave room for their count, the
+ * value itself being whole
+ */
+TEST (Cursor, truncatedHeader) { // NOLINT
+    for (const auto & header : {
+            std::string ("\xc0\x00", 2),
+            std::string ("\xc1\x00", 2),
+            std::string ("\xd0\x00\x00\x00\x03\x00\x00\x00", 8),
+            std::string ("\xd1\x00\x00\x00\x00", 5) }
+    ) {
+        std::vector<char> bytes (header.begin(), header.end());
+        codec::Cursor c (bytes.data(), bytes.size());
+
+        ASSERT_TRUE (c.next());
+        EXPECT_THROW (c.enter(), std::runtime_error); // NOLINT
+    }
+}
+
+/******************************************************************************/
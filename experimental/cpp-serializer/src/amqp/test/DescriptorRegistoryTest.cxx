@@ -0,0 +1,38 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "amqp/descriptors/AMQPDescriptorRegistory.h"
+
+/******************************************************************************/
+
+using namespace amqp;
+
+/******************************************************************************/
+
+TEST (DescriptorRegistory, known) { // NOLINT
+    for (int i { internal::ENVELOPE } ; i <= internal::TRANSFORM_ELEMENT_KEY ; ++i) {
+        auto * descriptor = findDescriptor (i | internal::DESCRIPTOR_TOP_32BITS);
+
+        ASSERT_NE (nullptr, descriptor);
+        ASSERT_EQ (describedToString (static_cast<uint32_t>(i)), descriptor->symbol());
+    }
+
+    ASSERT_STREQ ("ENVELOPE", descriptor (1UL | internal::DESCRIPTOR_TOP_32BITS).symbol());
+}
+
+/******************************************************************************/
+
+TEST (DescriptorRegistory, unknown) { // NOLINT
+    ASSERT_EQ (nullptr, findDescriptor (internal::DESCRIPTOR_TOP_32BITS));
+    ASSERT_EQ (nullptr, findDescriptor (12UL | internal::DESCRIPTOR_TOP_32BITS));
+    ASSERT_EQ (nullptr, findDescriptor (1UL));
+    ASSERT_EQ (nullptr, findDescriptor (22UL));
+    ASSERT_EQ (nullptr, findDescriptor (1UL | (0xc563UL << 48U)));
+
+    ASSERT_EQ ("UNKNOWN", describedToString (uint64_t { 22 }));
+
+    ASSERT_THROW (descriptor (22UL), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
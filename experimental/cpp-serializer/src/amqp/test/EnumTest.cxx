@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <cstdio>
+#include <stdexcept>
+#include <unistd.h>
+
+#include "codec/codec_wrapper.h"
+
+#include "amqp/SchemaCatalog.h"
+#include "amqp/CompositeFactory.h"
+#include "amqp/reader/restricted-readers/EnumReader.h"
+#include "amqp/descriptors/corda-descriptors/EnvelopeDescriptor.h"
+
+#include "schema/restricted-types/Enum.h"
+
+
+#include "Blobs.h"
+
+/******************************************************************************/
+
+using amqp::reader::Variant;
+
+/******************************************************************************/
+
+TEST (Enum, schema) { // NOLINT
+    using namespace amqp::internal::schema;
+
+    auto schema = amqp::internal::EnvelopeDescriptor::buildSchema (test::enumSchema());
+
+    auto it = schema->fromDescriptor ("net.corda:colour");
+    ASSERT_NE (schema->end(), schema->begin());
+
+    const auto & colour = dynamic_cast<const Enum &>(*(it->second.get()));
+
+    EXPECT_EQ (Restricted::RestrictedTypes::Enum, colour.restrictedType());
+    EXPECT_EQ ((std::vector<std::string> { "RED", "GREEN", "BLUE" }), colour.choices());
+    EXPECT_EQ (colour.begin(), colour.end());
+}
+
+/******************************************************************************/
+
+/*
+ * Were a repeated ordinal to be let through it would hide the earlier
+ * choice and leave the one it should have been with no name
+ */
+TEST (Enum, badOrdinals) { // NOLINT
+    auto build = [](const std::vector<std::pair<std::string, std::string>> & choices_) {
+        return amqp::internal::EnvelopeDescriptor::buildSchema (test::enumSchema (choices_));
+    };
+
+    for (const auto & choices : {
+            std::vector<std::pair<std::string, std::string>> {
+                { "RED", "0" }, { "GREEN", "0" }, { "BLUE", "2" } },
+            std::vector<std::pair<std::string, std::string>> {
+                { "RED", "1" }, { "GREEN", "1" } },
+            std::vector<std::pair<std::string, std::string>> {
+                { "RED", "0" }, { "GREEN", "3" } },
+            std::vector<std::pair<std::string, std::string>> {
+                { "RED", "0" }, { "GREEN", "-1" } } }
+    ) {
+        try {
+            build (choices);
+            FAIL() << choices[1].first << " " << choices[1].second;
+        } catch (const std::runtime_error & e) {
+            EXPECT_NE (std::string::npos, std::string (e.what()).find ("bad ordinal")) << e.what();
+        }
+    }
+
+    EXPECT_NO_THROW (build ({ { "RED", "1" }, { "GREEN", "0" } })); // NOLINT
+}
+
+/******************************************************************************/
+
+TEST (Enum, reader) { // NOLINT
+    amqp::internal::reader::EnumReader reader (
+        "net.corda.Colour", { "RED", "GREEN", "BLUE" });
+
+    // only the ordinal counts, the name is never looked at
+    EXPECT_EQ ("\"BLUE\"\n",
+        test::json (test::constant ("blue", 2), [&](codec::Cursor * c_, auto & json_) {
+            reader.visit (c_, test::schema(), json_);
+        }));
+
+    auto blob = test::constant ("GREEN", 1) + test::constant ("PURPLE", 3);
+    codec::Cursor cursor (blob.data(), blob.size());
+    cursor.next();
+
+    EXPECT_EQ ("GREEN", reader.read (&cursor).asString());
+    EXPECT_THROW (reader.read (&cursor), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+TEST (Enum, factory) { // NOLINT
+    using namespace amqp::internal::schema;
+
+    auto parsed = amqp::internal::EnvelopeDescriptor::buildSchema (test::enumSchema());
+
+    const auto & colour = dynamic_cast<const Enum &>(
+        *(parsed->fromType ("net.corda.Colour")->second.get()));
+
+    OrderedTypeNotations<AMQPTypeNotation> types;
+
+    types.insert (test::restricted (
+        colour.name(), "enum", "net.corda:colour", colour.choices()));
+    types.insert (test::composite ("net.corda.Light", "net.corda:light", {
+        { "colour", "net.corda.Colour" },
+        { "colours", "java.util.List<net.corda.Colour>" } }));
+    types.insert (test::restricted (
+        "java.util.List<net.corda.Colour>", "list", "net.corda:colours"));
+
+    Schema schema (std::move (types));
+
+    amqp::internal::CompositeFactory factory;
+    factory.process (schema);
+    factory.freeze();
+
+    auto reader = factory.byType ("net.corda.Light");
+    ASSERT_TRUE (reader);
+
+    auto blob = test::described ("net.corda:light", test::list ({
+        test::constant ("RED", 0),
+        test::described ("net.corda:colours", test::list ({
+            test::constant ("BLUE", 2), test::constant ("GREEN", 1) })) }));
+
+    EXPECT_EQ ("{ \"colour\" : \"RED\", \"colours\" : [ \"BLUE\", \"GREEN\" ] }\n",
+        test::json (blob, [&](codec::Cursor * c_, auto & json_) {
+            reader->visit (c_, schema, json_);
+        }));
+}
+
+/******************************************************************************/
+
+TEST (Enum, catalog) { // NOLINT
+    using namespace amqp::internal::schema;
+
+    auto path = "/tmp/schema-catalog-enum-test." + std::to_string (getpid());
+
+    {
+        amqp::internal::SchemaCatalog catalog (path);
+        catalog.add (1, "bytes", *amqp::internal::EnvelopeDescriptor::buildSchema (test::enumSchema()));
+        catalog.save();
+    }
+
+    amqp::internal::SchemaCatalog catalog (path);
+
+    auto loaded = catalog.find (1, "bytes");
+    ASSERT_NE (nullptr, loaded);
+
+    const auto & colour = dynamic_cast<const Enum &>(
+        *(loaded->fromType ("net.corda.Colour")->second.get()));
+
+    EXPECT_EQ ((std::vector<std::string> { "RED", "GREEN", "BLUE" }), colour.choices());
+
+    unlink (path.c_str());
+    unlink ((path + ".lock").c_str());
+}
+
+/******************************************************************************/
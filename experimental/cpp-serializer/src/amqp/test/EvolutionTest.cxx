@@ -0,0 +1,318 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <stdexcept>
+
+#include "codec/codec_wrapper.h"
+
+#include "amqp/SchemaCache.h"
+#include "amqp/binding/Decoder.h"
+#include "amqp/schema/Transforms.h"
+#include "amqp/descriptors/AMQPDescriptorRegistory.h"
+#include "amqp/descriptors/corda-descriptors/EnvelopeDescriptor.h"
+
+#include "serialiser/Member.h"
+#include "serialiser/Encoder.h"
+
+#include "Blobs.h"
+
+/******************************************************************************/
+
+namespace {
+
+    enum class Colour { Red, Green, Blue };
+
+    /*
+     * Reordered since it was written, with a field it didn't have then
+     * and without one it did
+     */
+    struct Light {
+        Colour                 colour;
+        std::optional<int32_t> lumens;
+        std::string            name;
+    };
+
+    struct Later {
+        int32_t                a;
+        std::optional<int32_t> z;
+    };
+
+    struct Nullable {
+        std::optional<int32_t>     a;
+        std::optional<std::string> e;
+    };
+
+    std::string
+    transform (const std::string & kind_, const std::string & from_, const std::string & to_) {
+        using namespace amqp::internal;
+
+        return test::corda (TRANSFORM_ELEMENT, test::list ({
+            test::str (kind_), test::str (from_), test::str (to_) }));
+    }
+
+    /*
+     * Since the reader's version of the enum, RED GREEN BLUE, GREEN was
+     * renamed VERT, BLUE removed and PINK added, to be read as RED
+     */
+    std::string
+    transforms() {
+        using namespace amqp::internal;
+
+        return test::corda (TRANSFORM_SCHEMA, test::map ({
+            test::str ("net.corda.Colour"), test::map ({
+                test::corda (TRANSFORM_ELEMENT_KEY, test::smallint (1)),
+                test::list ({ transform ("EnumDefault", "RED", "PINK") }),
+                test::corda (TRANSFORM_ELEMENT_KEY, test::smallint (2)),
+                test::list ({ transform ("Rename", "GREEN", "VERT") }) }) }));
+    }
+
+    /*
+     * enum net.corda.Colour { RED, VERT, PINK }
+     * net.corda.Light { name : string, colour : net.corda.Colour }
+     */
+    std::string
+    schema() {
+        using namespace amqp::internal;
+
+        std::string rtn;
+        serialiser::Encoder out (rtn);
+
+        out.putDescribed (SCHEMA);
+        auto schema = out.beginList();
+        auto types = out.beginList();
+
+        test::enumType (out, "net.corda.Colour", "net.corda:colour", {
+            { "RED", "0" }, { "VERT", "1" }, { "PINK", "2" } });
+
+        out.putDescribed (COMPOSITE_TYPE);
+        auto composite = out.beginList();
+        out.putString ("net.corda.Light");
+        out.putNull();
+        out.putEmptyList();
+        test::objectDescriptor (out, "net.corda:light");
+        auto fields = out.beginList();
+        serialiser::putField (out, "name", "string", false);
+        serialiser::putField (out, "colour", "net.corda.Colour", false);
+        out.endList (fields, 2);
+        out.endList (composite, 5);
+
+        out.endList (types, 2);
+        out.endList (schema, 1);
+
+        return rtn;
+    }
+
+    std::string
+    envelope (const std::string & object_, const std::string & transforms_) {
+        using namespace amqp::internal;
+
+        std::string rtn;
+        serialiser::Encoder out (rtn);
+
+        out.putDescribed (ENVELOPE);
+        auto list = out.beginList();
+        out.putEncoded (object_);
+        out.putEncoded (schema());
+        out.putEncoded (transforms_);
+        out.endList (list, 3);
+
+        return rtn;
+    }
+
+    std::string
+    light (const std::string & name_, const std::string & colour_, int8_t ordinal_) {
+        return test::described ("net.corda:light", test::list ({
+            test::str (name_), test::constant (colour_, ordinal_) }));
+    }
+
+}
+
+/******************************************************************************/
+
+namespace amqp::binding {
+
+    template<>
+    struct Binding<Colour> {
+        static constexpr std::string_view type { "net.corda.Colour" };
+
+        static constexpr auto constants = std::array {
+            constant ("RED", Colour::Red),
+            constant ("GREEN", Colour::Green),
+            constant ("BLUE", Colour::Blue) };
+    };
+
+    template<>
+    struct Binding<Light> {
+        static constexpr std::string_view type { "net.corda.Light" };
+
+        static constexpr auto fields = std::make_tuple (
+            field ("colour", &Light::colour),
+            field ("lumens", &Light::lumens),
+            field ("name", &Light::name));
+    };
+
+    template<>
+    struct Binding<Later> {
+        static constexpr std::string_view type { "net.corda.Outer" };
+
+        static constexpr auto fields = std::make_tuple (
+            field ("a", &Later::a),
+            field ("z", &Later::z));
+    };
+
+    template<>
+    struct Binding<Nullable> {
+        static constexpr std::string_view type { "net.corda.Outer" };
+
+        static constexpr auto fields = std::make_tuple (
+            field ("a", &Nullable::a),
+            field ("e", &Nullable::e));
+    };
+
+}
+
+/******************************************************************************/
+
+TEST (Evolution, transforms) { // NOLINT
+    using amqp::internal::schema::Transform;
+
+    auto parsed = amqp::internal::EnvelopeDescriptor::buildTransforms (schema() + transforms());
+
+    const auto & colour = parsed->of ("net.corda.Colour");
+    ASSERT_EQ (2U, colour.size());
+
+    EXPECT_EQ (Transform::Kind::EnumDefault, colour[0].kind());
+    EXPECT_EQ ("RED", colour[0].from());
+    EXPECT_EQ ("PINK", colour[0].to());
+
+    EXPECT_EQ (Transform::Kind::Rename, colour[1].kind());
+    EXPECT_EQ ("GREEN", colour[1].from());
+    EXPECT_EQ ("VERT", colour[1].to());
+
+    EXPECT_TRUE (parsed->of ("net.corda.Light").empty());
+    EXPECT_TRUE (amqp::internal::EnvelopeDescriptor::buildTransforms (schema())->empty());
+}
+
+/******************************************************************************/
+
+TEST (Evolution, evolve) { // NOLINT
+    using amqp::internal::schema::Transform;
+
+    amqp::internal::schema::Transforms transforms ({ { "net.corda.Colour", {
+        Transform (Transform::Kind::EnumDefault, "VERT", "PINK"),
+        Transform (Transform::Kind::Rename, "GREEN", "VERT"),
+        Transform (Transform::Kind::Rename, "BLUE", "AZURE"),
+        Transform (Transform::Kind::Rename, "AZURE", "BLUE") } } });
+
+    std::vector<std::string_view> older { "RED", "GREEN" };
+    std::vector<std::string_view> newer { "RED", "VERT" };
+
+    EXPECT_EQ (0U, transforms.evolve ("net.corda.Colour", "RED", older));
+
+    // back through a rename, then through a default and a rename
+    EXPECT_EQ (1U, transforms.evolve ("net.corda.Colour", "VERT", older));
+    EXPECT_EQ (1U, transforms.evolve ("net.corda.Colour", "PINK", older));
+
+    // forward through a rename
+    EXPECT_EQ (1U, transforms.evolve ("net.corda.Colour", "GREEN", newer));
+
+    EXPECT_THROW (transforms.evolve ("net.corda.Colour", "BLUE", older), std::runtime_error); // NOLINT
+    EXPECT_THROW (transforms.evolve ("net.corda.Other", "VERT", older), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+TEST (Evolution, decode) { // NOLINT
+    amqp::internal::SchemaCache cache;
+    amqp::internal::binding::Decoder<Light> decoder;
+
+    std::vector<std::pair<std::string, Colour>> cases {
+        { envelope (light ("one", "RED", 0), transforms()), Colour::Red },
+        { envelope (light ("two", "VERT", 1), transforms()), Colour::Green },
+        { envelope (light ("three", "PINK", 2), transforms()), Colour::Red } };
+
+    for (const auto & [blob, colour] : cases) {
+        auto out = decoder.decode (blob.data(), blob.size(), cache);
+
+        EXPECT_EQ (colour, out.colour);
+        EXPECT_FALSE (out.lumens);
+    }
+
+    // one schema, compiled, and planned, once
+    EXPECT_EQ (1U, cache.size());
+    EXPECT_EQ (2U, cache.hits());
+
+    auto blob = envelope (light ("two", "VERT", 1), transforms());
+    EXPECT_EQ ("two", decoder.decode (blob.data(), blob.size(), cache).name);
+}
+
+/******************************************************************************/
+
+/*
+ * The same schema without the transforms is a different one, and without
+ * them VERT and PINK mean nothing here
+ */
+TEST (Evolution, untransformed) { // NOLINT
+    amqp::internal::SchemaCache cache;
+    amqp::internal::binding::Decoder<Light> decoder;
+
+    std::string empty;
+    {
+        amqp::internal::serialiser::Encoder out (empty);
+        out.putDescribed (amqp::internal::TRANSFORM_SCHEMA);
+        out.putEmptyMap();
+    }
+
+    auto blob = envelope (light ("one", "RED", 0), empty);
+    EXPECT_THROW (decoder.decode (blob.data(), blob.size(), cache), std::runtime_error); // NOLINT
+
+    blob = envelope (light ("one", "RED", 0), transforms());
+    EXPECT_EQ (Colour::Red, decoder.decode (blob.data(), blob.size(), cache).colour);
+
+    EXPECT_EQ (2U, cache.size());
+}
+
+/******************************************************************************/
+
+TEST (Evolution, optional) { // NOLINT
+    test::Readers readers;
+
+    amqp::internal::binding::Plans plans;
+    const auto & later = plans.get<Later> (*readers.outer, "net.corda.Outer");
+
+    EXPECT_EQ (amqp::internal::binding::Plan<Later>::absent, later.position[1]);
+    EXPECT_TRUE (later.ordered);
+
+    // decoding again clears what the blob doesn't have
+    Later out { 0, 5 };
+    auto blob = test::outerBlob (7);
+    codec::Cursor cursor (blob.data(), blob.size());
+    cursor.next();
+
+    amqp::internal::binding::decode (&cursor, out, later);
+    EXPECT_EQ (7, out.a);
+    EXPECT_FALSE (out.z);
+
+    // present but null
+    const auto & nullable = plans.get<Nullable> (*readers.outer, "net.corda.Outer");
+
+    blob = test::outerBlob (7) + test::described ("net.corda:outer", test::list ({
+        std::string ("\x40", 1), test::innerBlob (2, "two"),
+        test::described ("net.corda:list", test::list ({ })),
+        test::described ("net.corda:list", test::list ({ })) }));
+
+    codec::Cursor nulls (blob.data(), blob.size());
+    nulls.next();
+
+    Nullable n { std::nullopt, "e" };
+    amqp::internal::binding::decode (&nulls, n, nullable);
+    EXPECT_EQ (7, n.a);
+    EXPECT_FALSE (n.e);
+
+    amqp::internal::binding::decode (&nulls, n, nullable);
+    EXPECT_FALSE (n.a);
+}
+
+/******************************************************************************/
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <string_view>
+
+#include "amqp/reader/JsonString.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal::reader;
+
+/******************************************************************************/
+
+/*
+ * Each byte needing attention at every position of strings of every
+ * length up to a few registers' worth, to take the kernel through its
+ * tail, offset by one so nothing is aligned
+ */
+TEST (JsonString, plain) { // NOLINT
+    std::string kernel = format::escapeKernel();
+    EXPECT_TRUE (kernel == "avx2" || kernel == "sse2" || kernel == "scalar");
+
+    for (char special : { '"', '\\', '\0', '\n', '\x1f', '\x80', '\xff' }) {
+        for (size_t n { 1 } ; n < 100 ; ++n) {
+            for (size_t at { 0 } ; at < n ; ++at) {
+                std::string s (n + 1, 'a');
+                s[at + 1] = special;
+
+                EXPECT_EQ (at, format::plain (std::string_view (s).substr (1)))
+                    << n << " " << at << " " << static_cast<int>(special);
+            }
+
+            std::string s (n + 1, ' ');
+            EXPECT_EQ (n, format::plain (std::string_view (s).substr (1))) << n;
+        }
+    }
+
+    EXPECT_EQ (0U, format::plain (""));
+    EXPECT_EQ (2U, format::plain ("~\x7f\""));
+}
+
+/******************************************************************************/
+
+TEST (JsonString, sequence) { // NOLINT
+    auto check = [](std::string_view s_, size_t length_, bool valid_) {
+        bool valid;
+        EXPECT_EQ (length_, format::sequence (s_, valid)) << s_;
+        EXPECT_EQ (valid_, valid) << s_;
+    };
+
+    check ("\xc3\xbc", 2, true);            // ü
+    check ("\xe2\x82\xac", 3, true);        // €
+    check ("\xf0\x9f\x98\x80", 4, true);    // U+1F600
+    check ("\xf4\x8f\xbf\xbf", 4, true);    // U+10FFFF
+    check ("\xef\xbf\xbd", 3, true);        // U+FFFD
+
+    check ("\x80", 1, false);               // a lone continuation
+    check ("\xc0\xaf", 1, false);           // overlong /
+    check ("\xc1\xbf", 1, false);
+    check ("\xe0\x80\xaf", 1, false);       // overlong
+    check ("\xf0\x80\x80\xaf", 1, false);
+    check ("\xed\xa0\x80", 1, false);       // a surrogate, U+D800
+    check ("\xf4\x90\x80\x80", 1, false);   // U+110000
+    check ("\xf5\x80\x80\x80", 1, false);
+    check ("\xff", 1, false);
+
+    // truncated, the whole prefix goes
+    check ("\xe2\x82", 2, false);
+    check ("\xe2\x82z", 2, false);
+    check ("\xf0\x9f\x98", 3, false);
+    check ("\xc3", 1, false);
+    check ("\xc3z", 1, false);
+}
+
+/******************************************************************************/
+
+TEST (JsonString, quote) { // NOLINT
+    EXPECT_EQ (R"("")", format::quote (""));
+    EXPECT_EQ (R"("O=Bank A, L=London, C=GB")", format::quote ("O=Bank A, L=London, C=GB"));
+    EXPECT_EQ (R"("a\"b\\c\b\f\n\r\td\u0001\u001f")", format::quote ("a\"b\\c\b\f\n\r\td\x01\x1f"));
+    EXPECT_EQ (std::string (R"("\u0000")"), format::quote (std::string_view ("\0", 1)));
+
+    EXPECT_EQ ("\"Z\xc3\xbcrich \xe2\x82\xac\"", format::quote ("Z\xc3\xbcrich \xe2\x82\xac"));
+    EXPECT_EQ (R"("a\ufffdb\ufffd\ufffdc\ufffd")", format::quote ("a\xc0""b\xe2\x82\xff""c\xf0\x9f\x98"));
+
+    std::string out ("x");
+    format::quote (std::string (40, 'y') + "\"", out);
+    EXPECT_EQ ("x\"" + std::string (40, 'y') + "\\\"\"", out);
+}
+
+/******************************************************************************/
+
+/*
+ * Runs needing no escaping are handed over whole, however many multi
+ * byte characters they hold
+ */
+TEST (JsonString, runs) { // NOLINT
+    std::vector<std::string> runs;
+
+    format::escape (
+        std::string_view ("CN=M\xc3\xbcller, O=\xe2\x82\xac Bank\n\"x\""),
+        [&runs](std::string_view run_) { runs.emplace_back (run_); });
+
+    EXPECT_EQ ((std::vector<std::string> {
+        "CN=M\xc3\xbcller, O=\xe2\x82\xac Bank", "\\n", "", "\\\"", "x", "\\\"", "" }), runs);
+}
+
+/******************************************************************************/
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <cstdio>
+#include <limits>
+
+#include <unistd.h>
+
+#include "amqp/reader/JsonWriter.h"
+
+/******************************************************************************/
+
+namespace {
+
+    /*
+     * Run f_ against a writer targeting a temporary file and hand back
+     * whatever ended up in the file
+     */
+    template<typename F>
+    std::string
+    written (F f_, size_t bufferSize_ = 64 * 1024) {
+        FILE * tmp = tmpfile();
+
+        {
+            amqp::internal::reader::JsonWriter json (fileno (tmp), bufferSize_);
+            f_ (json);
+        }
+
+        std::string rtn (ftell (tmp), '\0');
+        rewind (tmp);
+        fread (&rtn[0], 1, rtn.size(), tmp);
+        fclose (tmp);
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (JsonWriter, nesting) { // NOLINT
+    auto out = written ([](auto & json_) {
+        json_.beginComposite ("net.corda.A");
+        json_.field ("a");
+        json_.value (int32_t { 1 });
+        json_.field ("b");
+        json_.beginList();
+        json_.value (int64_t { 2 });
+        json_.value (int64_t { 3 });
+        json_.endList();
+        json_.field ("c");
+        json_.beginList();
+        json_.endList();
+        json_.field ("d");
+        json_.beginComposite ("net.corda.B");
+        json_.endComposite();
+        json_.field ("e");
+        json_.null();
+        json_.field ("f");
+        json_.value (true);
+        json_.endComposite();
+        json_.endDocument();
+    });
+
+    ASSERT_EQ (
+        R"({ "a" : 1, "b" : [ 2, 3 ], "c" : [ ], "d" : { }, "e" : null, "f" : true })" "\n",
+        out);
+}
+
+/******************************************************************************/
+
+TEST (JsonWriter, escaping) { // NOLINT
+    auto out = written ([](auto & json_) {
+        json_.beginList();
+        json_.value (std::string_view ("a\"b\\c\nd\x01"));
+        json_.endList();
+        json_.endDocument();
+    });
+
+    ASSERT_EQ (R"([ "a\"b\\c\nd\u0001" ])" "\n", out);
+}
+
+/******************************************************************************/
+
+TEST (JsonWriter, utf8) { // NOLINT
+    auto out = written ([](auto & json_) {
+        json_.beginList();
+        json_.value (std::string_view ("O=Bank \xc3\x9c, L=Z\xc3\xbcrich"));
+        json_.value (std::string_view ("bad \xff\xc3 end"));
+        json_.endList();
+        json_.endDocument();
+    });
+
+    ASSERT_EQ ("[ \"O=Bank \xc3\x9c, L=Z\xc3\xbcrich\", \"bad \\ufffd\\ufffd end\" ]\n", out);
+}
+
+/******************************************************************************/
+
+TEST (JsonWriter, doubles) { // NOLINT
+    auto out = written ([](auto & json_) {
+        json_.beginList();
+        json_.value (1.0);
+        json_.value (0.1);
+        json_.value (std::numeric_limits<double>::quiet_NaN());
+        json_.endList();
+        json_.endDocument();
+    });
+
+    ASSERT_EQ ("[ 1, 0.1, null ]\n", out);
+}
+
+/******************************************************************************/
+
+TEST (JsonWriter, smallBuffer) { // NOLINT
+    auto out = written ([](auto & json_) {
+        json_.beginList();
+        json_.value (std::string_view ("longer than the buffer"));
+        json_.endList();
+        json_.endDocument();
+    }, 4);
+
+    ASSERT_EQ ("[ \"longer than the buffer\" ]\n", out);
+}
+
+/******************************************************************************/
+
+TEST (JsonWriter, discardUnflushed) { // NOLINT
+    auto out = written ([](auto & json_) {
+        json_.beginList();
+        json_.value (int32_t { 1 });
+    });
+
+    ASSERT_EQ ("", out);
+}
+
+/******************************************************************************/
+
+TEST (JsonWriter, keepCompleteDocuments) { // NOLINT
+    auto out = written ([](auto & json_) {
+        json_.beginList();
+        json_.value (int32_t { 1 });
+        json_.endList();
+        json_.endDocument();
+        json_.beginList();
+        json_.value (int32_t { 2 });
+    });
+
+    ASSERT_EQ ("[ 1 ]\n", out);
+}
+
+/******************************************************************************/
+
+TEST (JsonWriter, rollback) { // NOLINT
+    auto out = written ([](auto & json_) {
+        json_.beginComposite ("net.corda.A");
+        json_.field ("a");
+        json_.beginList();
+        json_.value (int32_t { 1 });
+        ASSERT_TRUE (json_.rollback());
+        json_.beginComposite ("net.corda.A");
+        json_.field ("a");
+        json_.value (int32_t { 2 });
+        json_.endComposite();
+        json_.endDocument();
+    });
+
+    ASSERT_EQ ("{ \"a\" : 2 }\n", out);
+}
+
+/******************************************************************************/
+
+TEST (JsonWriter, rollbackAfterSpill) { // NOLINT
+    auto out = written ([](auto & json_) {
+        json_.beginList();
+        json_.value (std::string_view ("longer than the buffer"));
+        ASSERT_FALSE (json_.rollback());
+    }, 4);
+
+    // whatever was still buffered is dropped
+    ASSERT_EQ ("[ \"longer than the buffe", out);
+}
+
+/******************************************************************************/
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <stdexcept>
+
+#include "codec/codec_wrapper.h"
+
+#include "amqp/CompositeFactory.h"
+#include "amqp/reader/restricted-readers/MapReader.h"
+
+#include "schema/restricted-types/Map.h"
+
+#include "Blobs.h"
+
+/******************************************************************************/
+
+using amqp::reader::Variant;
+
+/******************************************************************************/
+
+namespace {
+
+    /*
+     * Map<string, net.corda.Inner>, keys deliberately not in order
+     */
+    std::string
+    mapBlob() {
+        return test::described ("net.corda:map", test::map ({
+            test::str ("b"), test::innerBlob (1, "one"),
+            test::str ("a"), test::innerBlob (2, "two") }));
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Map, types) { // NOLINT
+    using namespace amqp::internal::schema;
+
+    auto descriptor = std::make_unique<Descriptor> ("net.corda:map");
+    auto restricted = Restricted::make (
+        descriptor, "java.util.Map<string, java.util.Map<int, java.util.List<int>>>",
+        "", { }, "map");
+
+    ASSERT_EQ (Restricted::RestrictedTypes::Map, restricted->restrictedType());
+
+    const auto & map = dynamic_cast<const Map &>(*restricted);
+    EXPECT_EQ ("string", map.keyType());
+    EXPECT_EQ ("java.util.Map<int, java.util.List<int>>", map.valueType());
+
+    descriptor = std::make_unique<Descriptor> ("net.corda:set");
+    EXPECT_THROW (Restricted::make (descriptor, "java.util.Set<int>", "", { }, "set"), // NOLINT
+        std::runtime_error);
+}
+
+/******************************************************************************/
+
+/*
+ * Entries come out in the order they were written
+ */
+TEST (Map, visit) { // NOLINT
+    test::Readers readers;
+
+    auto map = std::make_shared<amqp::internal::reader::MapReader> (
+        "java.util.Map<string, net.corda.Inner>", readers.string, readers.inner);
+    map->freeze();
+
+    auto json = test::json (mapBlob(), [&](codec::Cursor * c_, auto & json_) {
+        map->visit (c_, test::schema(), json_);
+    });
+
+    EXPECT_EQ (
+        "[ { \"key\" : \"b\", \"value\" : { \"x\" : 1, \"y\" : \"one\" } }, "
+        "{ \"key\" : \"a\", \"value\" : { \"x\" : 2, \"y\" : \"two\" } } ]\n",
+        json);
+
+    auto blob = mapBlob();
+    codec::Cursor cursor (blob.data(), blob.size());
+    cursor.next();
+
+    auto entries = map->read (&cursor);
+
+    ASSERT_EQ (2U, entries.asList().size());
+    EXPECT_EQ ("b", entries[0][0].asString());
+    EXPECT_EQ (1, entries[0][1][0].asInt());
+    EXPECT_EQ ("a", entries[1][0].asString());
+    EXPECT_EQ ("two", entries[1][1][1].asString());
+}
+
+/******************************************************************************/
+
+TEST (Map, factory) { // NOLINT
+    using namespace amqp::internal::schema;
+
+    OrderedTypeNotations<AMQPTypeNotation> types;
+
+    types.insert (test::restricted ("java.util.Map<string, long>", "map"));
+    types.insert (test::composite ("net.corda.Wallet", "net.corda:wallet", {
+        { "balances", "java.util.Map<string, long>" } }));
+
+    Schema schema (std::move (types));
+
+    amqp::internal::CompositeFactory factory;
+    factory.process (schema);
+    factory.freeze();
+
+    auto reader = factory.byType ("net.corda.Wallet");
+    ASSERT_TRUE (reader);
+
+    auto blob = test::described ("net.corda:wallet", test::list ({
+        test::described ("net.corda:map", test::map ({
+            test::str ("GBP"), std::string ("\x55\x0a", 2),
+            test::str ("USD"), std::string ("\x55\x14", 2) })) }));
+
+    auto json = test::json (blob, [&](codec::Cursor * c_, auto & json_) {
+        reader->visit (c_, schema, json_);
+    });
+
+    EXPECT_EQ (
+        "{ \"balances\" : [ { \"key\" : \"GBP\", \"value\" : 10 }, "
+        "{ \"key\" : \"USD\", \"value\" : 20 } ] }\n",
+        json);
+}
+
+/******************************************************************************/
@@ -17,46 +17,18 @@ namespace {
             { }
 
 
-            int dependsOn (const OrderedTypeNotation & otn_) const override {
-                const auto & otn = dynamic_cast<const OTN &>(otn_);
-
-                // does the "left hand side" depend on us (in this case
-                // the lhs is us as we're not inverting
-                if (std::find (
-                        m_dependsOn.begin(),
-                        m_dependsOn.end(),
-                        otn.name()) != m_dependsOn.end())
-                {
-                    return 1;
-                }
-
-                // do we depend on the left hand side
-
-                if (std::find (
-                        otn.begin(),
-                        otn.end(),
-                        name()) != otn.end())
-                {
-                    return 2;
-                }
-
-                return 0;
+            void dependencies (
+                const std::function<void (const std::string &)> & f_
+            ) const override {
+                for (const auto & name : m_dependsOn) f_ (name);
             }
 
-            const std::string & name() const { return m_name; }
+            const std::string & name() const override { return m_name; }
 
             decltype(m_dependsOn.cbegin()) begin() const { return m_dependsOn.cbegin(); }
             decltype(m_dependsOn.cend()) end() const { return m_dependsOn.cend(); }
     };
 
-    inline
-    std::string
-    str (const amqp::internal::schema::OrderedTypeNotations<OTN> & list_) {
-        std::stringstream ss;
-        ss << list_;
-        return ss.str();
-    }
-
 }
 
 /******************************************************************************/
@@ -72,7 +44,7 @@ operator << (
         const amqp::internal::schema::OrderedTypeNotations<OTN> &otn_
 ) {
     auto first { true };
-    for (const auto & i : otn_.m_schemas) {
+    for (const auto & i : otn_.ordered()) {
         for (const auto & j : i) {
             if (first) {
                 first = false;
@@ -88,6 +60,20 @@ operator << (
 
 /******************************************************************************/
 
+namespace {
+
+    inline
+    std::string
+    str (const amqp::internal::schema::OrderedTypeNotations<OTN> & list_) {
+        std::stringstream ss;
+        ss << list_;
+        return ss.str();
+    }
+
+}
+
+/******************************************************************************/
+
 TEST (OTNTest, singleInsert) { // NOLINT
     amqp::internal::schema::OrderedTypeNotations<OTN> list;
 
@@ -219,3 +205,40 @@ TEST (OTNTest, three_5) { // NOLINT
 }
 
 /******************************************************************************/
+
+TEST (OTNTest, diamond) { // NOLINT
+    amqp::internal::schema::OrderedTypeNotations<OTN> list;
+
+    list.insert(std::make_unique<OTN>("D", std::vector<std::string> { }));
+    list.insert(std::make_unique<OTN>("A", std::vector<std::string> { "B", "C" }));
+    list.insert(std::make_unique<OTN>("C", std::vector<std::string> { "D", "int" }));
+    list.insert(std::make_unique<OTN>("B", std::vector<std::string> { "D" }));
+
+    EXPECT_EQ ("A C B D", str (list));
+}
+
+/******************************************************************************/
+
+TEST (OTNTest, cycle) { // NOLINT
+    amqp::internal::schema::OrderedTypeNotations<OTN> list;
+
+    list.insert(std::make_unique<OTN>("A", std::vector<std::string> { "B" }));
+    list.insert(std::make_unique<OTN>("B", std::vector<std::string> { "A", "C" }));
+    list.insert(std::make_unique<OTN>("C", std::vector<std::string> { "C" }));
+
+    EXPECT_EQ ("A B C", str (list));
+}
+
+/******************************************************************************/
+
+TEST (OTNTest, insertAfterOrdering) { // NOLINT
+    amqp::internal::schema::OrderedTypeNotations<OTN> list;
+
+    list.insert(std::make_unique<OTN>("B", std::vector<std::string> { }));
+    EXPECT_EQ ("B", str (list));
+
+    list.insert(std::make_unique<OTN>("A", std::vector<std::string> { "B" }));
+    EXPECT_EQ ("A B", str (list));
+}
+
+/******************************************************************************/
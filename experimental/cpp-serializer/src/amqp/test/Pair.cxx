@@ -14,7 +14,7 @@ using namespace amqp::internal::reader;
 TEST (Pair, string) { // NOLINT
     TypedPair<std::string> str_test ("Left", "Hello");
 
-    EXPECT_EQ("Left : Hello", str_test.dump());
+    EXPECT_EQ(R"("Left" : "Hello")", str_test.dump());
 }
 
 /******************************************************************************/
@@ -22,7 +22,7 @@ TEST (Pair, string) { // NOLINT
 TEST (Pair, int) { // NOLINT
     TypedPair<int> int_test ("Left", 101);
 
-    EXPECT_EQ("Left : 101", int_test.dump());
+    EXPECT_EQ(R"("Left" : 101)", int_test.dump());
 }
 
 /******************************************************************************/
@@ -31,7 +31,7 @@ TEST (Pair, UP1) { // NOLINT
     std::unique_ptr<TypedPair<double>> test =
         std::make_unique<TypedPair<double>> ("property", 10.0);
 
-    EXPECT_EQ("property : 10.000000", test->dump());
+    EXPECT_EQ(R"("property" : 10.000000)", test->dump());
 }
 
 /******************************************************************************/
@@ -54,7 +54,7 @@ TEST (Pair, UP2) { // NOLINT
         std::make_unique<TypedPair<std::vector<std::unique_ptr<IValue>>>> (
             "Vector", std::move (vec));
 
-    EXPECT_EQ("Vector : { first : 1, second : 2 }", test->dump());
+    EXPECT_EQ(R"("Vector" : { "first" : 1, "second" : 2 })", test->dump());
 }
 
 /******************************************************************************/
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include "codec/Cursor.h"
+
+#include "amqp/reader/Binary.h"
+#include "amqp/reader/Formats.h"
+#include "amqp/reader/PropertyReader.h"
+#include "amqp/schema/Field.h"
+
+#include "Blobs.h"
+
+/******************************************************************************/
+
+namespace {
+
+    std::string
+    encoded (char code_, const std::string & bytes_) {
+        return std::string (1, code_) + bytes_;
+    }
+
+    std::string
+    visited (const std::string & type_, const std::string & blob_) {
+        auto reader = amqp::internal::reader::PropertyReader::make (type_);
+
+        return test::json (blob_, [&](codec::Cursor * c_, auto & json_) {
+            reader->visit (c_, test::schema(), json_);
+        });
+    }
+
+    std::string
+    readString (const std::string & type_, const std::string & blob_) {
+        auto reader = amqp::internal::reader::PropertyReader::make (type_);
+
+        codec::Cursor cursor (blob_.data(), blob_.size());
+        cursor.next();
+
+        return reader->readString (&cursor);
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Primitives, typeCode) { // NOLINT
+    EXPECT_EQ (codec::AMQP_BOOL, codec::type_code ("boolean"));
+    EXPECT_EQ (codec::AMQP_ULONG, codec::type_code ("ulong"));
+    EXPECT_EQ (codec::AMQP_BINARY, codec::type_code ("binary"));
+    EXPECT_EQ (codec::AMQP_INVALID, codec::type_code ("bool"));
+    EXPECT_EQ (codec::AMQP_INVALID, codec::type_code ("net.corda.Outer"));
+
+    using amqp::internal::schema::Field;
+
+    for (const auto * type : {
+            "boolean", "ubyte", "byte", "ushort", "short", "uint", "int",
+            "char", "ulong", "long", "timestamp", "float", "double",
+            "decimal32", "decimal64", "decimal128", "uuid", "binary",
+            "string", "symbol" }
+    ) {
+        EXPECT_TRUE (Field::typeIsPrimitive (type)) << type;
+        EXPECT_EQ (type, amqp::internal::reader::PropertyReader::make (type)->type());
+    }
+
+    EXPECT_FALSE (Field::typeIsPrimitive ("*"));
+    EXPECT_FALSE (Field::typeIsPrimitive ("list"));
+    EXPECT_FALSE (Field::typeIsPrimitive ("net.corda.Outer"));
+
+    EXPECT_THROW (amqp::internal::reader::PropertyReader::make ("list"), std::runtime_error); // NOLINT
+    EXPECT_THROW (amqp::internal::reader::PropertyReader::make ("null"), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+TEST (Primitives, visit) { // NOLINT
+    EXPECT_EQ ("255\n", visited ("ubyte", encoded ('\x50', "\xff")));
+    EXPECT_EQ ("-1\n", visited ("byte", encoded ('\x51', "\xff")));
+    EXPECT_EQ ("65535\n", visited ("ushort", encoded ('\x60', "\xff\xff")));
+    EXPECT_EQ ("-2\n", visited ("short", encoded ('\x61', "\xff\xfe")));
+    EXPECT_EQ ("4294967295\n", visited ("uint", encoded ('\x70', "\xff\xff\xff\xff")));
+    EXPECT_EQ ("18446744073709551615\n", visited ("ulong", encoded ('\x80', std::string (8, '\xff'))));
+    EXPECT_EQ ("1.5\n", visited ("float", encoded ('\x72', std::string ("\x3f\xc0\x00\x00", 4))));
+    EXPECT_EQ ("\"A\"\n", visited ("char", encoded ('\x73', std::string ("\x00\x00\x00\x41", 4))));
+    EXPECT_EQ ("\"\xc3\xa9\"\n", visited ("char", encoded ('\x73', std::string ("\x00\x00\x00\xe9", 4))));
+    EXPECT_EQ ("\"GBP\"\n", visited ("symbol", test::sym ("GBP")));
+
+    EXPECT_EQ ("\"1970-01-01T00:00:01.500Z\"\n",
+        visited ("timestamp", encoded ('\x83', std::string ("\0\0\0\0\0\0\x05\xdc", 8))));
+
+    EXPECT_EQ ("\"00112233-4455-6677-8899-aabbccddeeff\"\n",
+        visited ("uuid", encoded ('\x98', std::string (
+            "\x00\x11\x22\x33\x44\x55\x66\x77\x88\x99\xaa\xbb\xcc\xdd\xee\xff", 16))));
+
+    EXPECT_EQ ("\"AQID\"\n", visited ("binary", encoded ('\xa0', std::string ("\x03\x01\x02\x03", 4))));
+    EXPECT_EQ ("\"AAAAAQ==\"\n", visited ("decimal32", encoded ('\x74', std::string ("\0\0\0\x01", 4))));
+
+    EXPECT_EQ ("null\n", visited ("ulong", std::string ("\x40", 1)));
+}
+
+/******************************************************************************/
+
+TEST (Primitives, read) { // NOLINT
+    using amqp::reader::Variant;
+
+    auto blob = encoded ('\x53', "\x07")
+        + encoded ('\x80', std::string ("\0\0\0\0\0\0\0\x09", 8))
+        + encoded ('\xa0', std::string ("\x02\xca\xfe", 3))
+        + std::string ("\x40", 1);
+
+    codec::Cursor cursor (blob.data(), blob.size());
+    cursor.next();
+
+    auto ulong = amqp::internal::reader::PropertyReader::make ("ulong");
+    auto binary = amqp::internal::reader::PropertyReader::make ("binary");
+
+    EXPECT_EQ (7U, ulong->read (&cursor).asULong());
+    EXPECT_EQ (9U, ulong->read (&cursor).asULong());
+
+    auto bytes = binary->read (&cursor).asBinary().bytes;
+    EXPECT_EQ ("\xca\xfe", bytes);
+
+    // a view of the blob, not a copy
+    EXPECT_EQ (blob.data() + blob.size() - 3, bytes.data());
+
+    EXPECT_TRUE (binary->read (&cursor).isNull());
+    EXPECT_FALSE (cursor.next());
+}
+
+/******************************************************************************/
+
+TEST (Primitives, readString) { // NOLINT
+    EXPECT_EQ ("-2", readString ("short", encoded ('\x61', "\xff\xfe")));
+    EXPECT_EQ ("4294967295", readString ("uint", encoded ('\x70', "\xff\xff\xff\xff")));
+    EXPECT_EQ ("1970-01-01T00:00:00.000Z", readString ("timestamp", encoded ('\x83', std::string (8, '\0'))));
+    EXPECT_EQ ("AQID", readString ("binary", encoded ('\xa0', std::string ("\x03\x01\x02\x03", 4))));
+    EXPECT_EQ ("null", readString ("short", std::string ("\x40", 1)));
+}
+
+/******************************************************************************/
+
+TEST (Primitives, formats) { // NOLINT
+    using namespace amqp::internal::reader;
+
+    EXPECT_EQ ("", format::base64 (""));
+    EXPECT_EQ ("Zg==", format::base64 ("f"));
+    EXPECT_EQ ("Zm8=", format::base64 ("fo"));
+    EXPECT_EQ ("Zm9vYmFy", format::base64 ("foobar"));
+
+    EXPECT_EQ ("1969-12-31T23:59:59.999Z", format::timestamp (-1));
+    EXPECT_EQ ("2019-01-31T12:00:00.000Z", format::timestamp (1548936000000L));
+
+    char buf[4];
+    EXPECT_EQ ("\xe2\x82\xac", format::utf8 (0x20ac, buf));
+    EXPECT_EQ ("\xf0\x9f\x98\x80", format::utf8 (0x1f600, buf));
+}
+
+/******************************************************************************/
@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include "codec/codec_wrapper.h"
+
+#include "amqp/reader/Projection.h"
+
+#include "Blobs.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace test;
+
+    std::string
+    project (const Readers & readers_, const std::vector<std::string> & paths_) {
+        Projection projection (*readers_.outer, paths_);
+
+        return json (outerBlob (1), [&](codec::Cursor * c_, JsonWriter & json_) {
+            projection.visit (c_, schema(), json_);
+        });
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Projection, everything) { // NOLINT
+    Readers readers;
+
+    auto all = json (outerBlob (1), [&](codec::Cursor * c_, JsonWriter & json_) {
+        readers.outer->visit (c_, schema(), json_);
+    });
+
+    ASSERT_EQ (all, project (readers, { "a", "b", "c", "d" }));
+}
+
+/******************************************************************************/
+
+TEST (Projection, nested) { // NOLINT
+    Readers readers;
+
+    ASSERT_EQ ("{ \"b\" : { \"y\" : \"two\" } }\n", project (readers, { "b.y" }));
+    ASSERT_EQ ("{ \"b\" : { \"x\" : 2, \"y\" : \"two\" } }\n",
+            project (readers, { "b.y", "b" }));
+}
+
+/******************************************************************************/
+
+TEST (Projection, schemaOrder) { // NOLINT
+    Readers readers;
+
+    ASSERT_EQ ("{ \"a\" : 1, \"c\" : [ 3, 4 ] }\n", project (readers, { "c", "a" }));
+}
+
+/******************************************************************************/
+
+TEST (Projection, throughLists) { // NOLINT
+    Readers readers;
+
+    ASSERT_EQ ("{ \"d\" : [ { \"y\" : \"five\" }, { \"y\" : \"six\" } ] }\n",
+            project (readers, { "d.y" }));
+}
+
+/******************************************************************************/
+
+/*
+ * Stopping after the last field we want has to leave the cursor after
+ * the whole composite, not part way through it
+ */
+TEST (Projection, skipsTheRest) { // NOLINT
+    Readers readers;
+    Projection projection (*readers.outer, { "a" });
+
+    auto blob = list ({ outerBlob (1), outerBlob (2), smallint (3) });
+
+    auto out = json (blob, [&](codec::Cursor * c_, JsonWriter & json_) {
+        codec::auto_enter ae (c_);
+
+        json_.beginList();
+        projection.visit (c_, schema(), json_);
+        projection.visit (c_, schema(), json_);
+        json_.value (codec::readAndNext<int32_t> (c_));
+        json_.endList();
+    });
+
+    ASSERT_EQ ("[ { \"a\" : 1 }, { \"a\" : 2 }, 3 ]\n", out);
+}
+
+/******************************************************************************/
+
+TEST (Projection, badPaths) { // NOLINT
+    Readers readers;
+
+    EXPECT_THROW (Projection (*readers.outer, { "e" }), std::runtime_error); // NOLINT
+    EXPECT_THROW (Projection (*readers.outer, { "b.z" }), std::runtime_error); // NOLINT
+    EXPECT_THROW (Projection (*readers.outer, { "a.x" }), std::runtime_error); // NOLINT
+    EXPECT_THROW (Projection (*readers.outer, { "b..y" }), std::runtime_error); // NOLINT
+    EXPECT_THROW (Projection (*readers.outer, { "" }), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
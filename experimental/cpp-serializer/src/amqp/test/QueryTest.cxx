@@ -0,0 +1,219 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include "codec/codec_wrapper.h"
+
+#include "amqp/reader/Query.h"
+
+#include "Blobs.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace test;
+
+    std::string
+    select (const Readers & readers_, const std::vector<std::string> & select_) {
+        Query query (*readers_.outer, select_, { });
+
+        return json (outerBlob (1), [&](codec::Cursor * c_, JsonWriter & json_) {
+            json_.beginComposite ("");
+            query.select (c_, schema(), json_);
+            json_.endComposite();
+        });
+    }
+
+    bool
+    matches (const Readers & readers_, const std::vector<std::string> & where_) {
+        std::vector<Query::Condition> conditions;
+        for (const auto & w : where_) conditions.emplace_back (Query::condition (w));
+
+        Query query (*readers_.outer, { }, conditions);
+
+        auto blob = outerBlob (1);
+        codec::Cursor cursor (blob.data(), blob.size());
+        cursor.next();
+
+        return query.matches (&cursor, schema());
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (Query, condition) { // NOLINT
+    auto c = Query::condition ("a.b>=10");
+
+    EXPECT_EQ ("a.b", c.path);
+    EXPECT_EQ (Query::GE, c.op);
+    EXPECT_EQ (Query::Literal::Number, c.value.kind);
+    EXPECT_TRUE (c.value.integral);
+    EXPECT_EQ (10, c.value.integer);
+
+    c = Query::condition (" name == 'a b' ");
+
+    EXPECT_EQ ("name", c.path);
+    EXPECT_EQ (Query::EQ, c.op);
+    EXPECT_EQ (Query::Literal::String, c.value.kind);
+    EXPECT_EQ ("a b", c.value.text);
+
+    EXPECT_EQ (Query::NE, Query::condition ("a != null").op);
+    EXPECT_EQ (Query::Literal::Null, Query::condition ("a != null").value.kind);
+    EXPECT_EQ (Query::LT, Query::condition ("a < 1.5").op);
+    EXPECT_FALSE (Query::condition ("a < 1.5").value.integral);
+    EXPECT_EQ (Query::Literal::Bool, Query::condition ("a = true").value.kind);
+
+    EXPECT_THROW (Query::condition ("a"), std::runtime_error); // NOLINT
+    EXPECT_THROW (Query::condition ("a !x"), std::runtime_error); // NOLINT
+    EXPECT_THROW (Query::condition ("== 1"), std::runtime_error); // NOLINT
+    EXPECT_THROW (Query::condition ("a =="), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+TEST (Query, select) { // NOLINT
+    Readers readers;
+
+    EXPECT_EQ ("{ \"a\" : 1 }\n", select (readers, { "a" }));
+    EXPECT_EQ ("{ \"b.y\" : \"two\" }\n", select (readers, { "b.y" }));
+    EXPECT_EQ ("{ \"b\" : { \"x\" : 2, \"y\" : \"two\" } }\n", select (readers, { "b" }));
+    EXPECT_EQ ("{ \"c\" : [ 3, 4 ], \"c[*]\" : [ 3, 4 ] }\n",
+            select (readers, { "c", "c[*]" }));
+    EXPECT_EQ ("{ \"d[*].y\" : [ \"five\", \"six\" ] }\n", select (readers, { "d[*].y" }));
+    EXPECT_EQ ("{ \"d[*]\" : [ { \"x\" : 5, \"y\" : \"five\" }, { \"x\" : 6, \"y\" : \"six\" } ] }\n",
+            select (readers, { "d[*]" }));
+}
+
+/******************************************************************************/
+
+TEST (Query, where) { // NOLINT
+    Readers readers;
+
+    EXPECT_TRUE (matches (readers, { }));
+    EXPECT_TRUE (matches (readers, { "a == 1" }));
+    EXPECT_FALSE (matches (readers, { "a > 1" }));
+    EXPECT_TRUE (matches (readers, { "a < 1.5" }));
+    EXPECT_TRUE (matches (readers, { "b.y == two" }));
+    EXPECT_FALSE (matches (readers, { "b.y != \"two\"" }));
+
+    // any element will do
+    EXPECT_TRUE (matches (readers, { "d[*].y == six" }));
+    EXPECT_TRUE (matches (readers, { "d[*].x >= 6" }));
+    EXPECT_FALSE (matches (readers, { "d[*].x > 6" }));
+    EXPECT_TRUE (matches (readers, { "c[*] == 4" }));
+
+    // different types are only ever unequal
+    EXPECT_FALSE (matches (readers, { "a == 'one'" }));
+    EXPECT_TRUE (matches (readers, { "a != 'one'" }));
+    EXPECT_FALSE (matches (readers, { "a == null" }));
+
+    // all of them
+    EXPECT_TRUE (matches (readers, { "a == 1", "b.x == 2" }));
+    EXPECT_FALSE (matches (readers, { "a == 1", "b.x == 3" }));
+}
+
+/******************************************************************************/
+
+TEST (Query, leavesCursor) { // NOLINT
+    Readers readers;
+    Query query (*readers.outer, { "a" }, { Query::condition ("a == 1") });
+
+    auto out = json (outerBlob (1), [&](codec::Cursor * c_, JsonWriter & json_) {
+        ASSERT_TRUE (query.matches (c_, schema()));
+
+        json_.beginComposite ("");
+        query.select (c_, schema(), json_);
+        json_.field ("all");
+        readers.outer->visit (c_, schema(), json_);
+        json_.endComposite();
+    });
+
+    auto all = json (outerBlob (1), [&](codec::Cursor * c_, JsonWriter & json_) {
+        readers.outer->visit (c_, schema(), json_);
+    });
+
+    ASSERT_EQ ("{ \"a\" : 1, \"all\" : " + all.substr (0, all.size() - 1) + " }\n", out);
+}
+
+/******************************************************************************/
+
+TEST (Query, badPaths) { // NOLINT
+    Readers readers;
+
+    auto where = [&readers](const std::string & condition_) {
+        Query (*readers.outer, { }, { Query::condition (condition_) });
+    };
+
+    auto select = [&readers](const std::string & path_) {
+        Query (*readers.outer, { path_ }, { });
+    };
+
+    EXPECT_THROW (select ("e"), std::runtime_error); // NOLINT
+    EXPECT_THROW (select ("d.y"), std::runtime_error); // NOLINT
+    EXPECT_THROW (select ("a[*]"), std::runtime_error); // NOLINT
+    EXPECT_THROW (select ("d[0]"), std::runtime_error); // NOLINT
+    EXPECT_THROW (select ("a.x"), std::runtime_error); // NOLINT
+    EXPECT_THROW (select ("b..x"), std::runtime_error); // NOLINT
+
+    EXPECT_THROW (where ("b == 1"), std::runtime_error); // NOLINT
+    EXPECT_THROW (where ("c == 1"), std::runtime_error); // NOLINT
+    EXPECT_NO_THROW (where ("c[*] == 1")); // NOLINT
+}
+
+/******************************************************************************/
+
+/*
+ * A batch of blobs of two root types, only one of which has the path
+ * asked about. Blobs of the other simply don't match.
+ */
+TEST (Query, mixedTypes) { // NOLINT
+    Readers readers;
+
+    Queries queries ({ "a" }, { Query::condition ("b.x > 1") });
+
+    std::string why;
+    EXPECT_EQ (nullptr, queries.compile (*readers.inner, &why));
+    EXPECT_EQ ("Cannot use \"a\", net.corda.Inner has no field a", why);
+
+    auto outer = queries.compile (*readers.outer);
+    ASSERT_NE (nullptr, outer);
+
+    // compiled once per type, either way
+    EXPECT_EQ (outer, queries.compile (*readers.outer));
+    EXPECT_EQ (nullptr, queries.compile (*readers.inner));
+
+    const std::vector<std::pair<const Reader *, std::string>> blobs {
+        { readers.outer.get(), outerBlob (1) },
+        { readers.inner.get(), innerBlob (7, "seven") },
+        { readers.outer.get(), outerBlob (2) },
+        { readers.inner.get(), innerBlob (8, "eight") } };
+
+    std::string out;
+    size_t matched { 0 };
+
+    for (const auto & [reader, blob] : blobs) {
+        auto query = queries.compile (*reader);
+        if (!query) continue;
+
+        codec::Cursor cursor (blob.data(), blob.size());
+        cursor.next();
+
+        if (!query->matches (&cursor, schema())) continue;
+
+        ++matched;
+        out += json (blob, [&](codec::Cursor * c_, JsonWriter & json_) {
+            json_.beginComposite ("");
+            query->select (c_, schema(), json_);
+            json_.endComposite();
+        });
+    }
+
+    EXPECT_EQ (2U, matched);
+    EXPECT_EQ ("{ \"a\" : 1 }\n{ \"a\" : 2 }\n", out);
+}
+
+/******************************************************************************/
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <stdexcept>
+
+#include "codec/References.h"
+#include "codec/codec_wrapper.h"
+
+#include "amqp/reader/Projection.h"
+
+#include "Blobs.h"
+
+/******************************************************************************/
+
+using namespace test;
+
+/******************************************************************************/
+
+TEST (References, numbering) { // NOLINT
+    Readers readers;
+
+    auto blob = sharedBlob();
+    codec::Cursor cursor (blob.data(), blob.size());
+    cursor.next();
+
+    readers.outer->read (&cursor);
+
+    const auto & references = cursor.references();
+
+    ASSERT_EQ (5U, references.size());
+    EXPECT_EQ (innerBlob (2, "two"), references.object (0));
+    EXPECT_EQ (described ("net.corda:list", list ({ smallint (3), smallint (4) })),
+        references.object (1));
+    EXPECT_EQ (innerBlob (6, "six"), references.object (2));
+    EXPECT_EQ (blob, references.object (4));
+
+    EXPECT_THROW (references.object (5), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+/*
+ * Unlike a String field the elements of a list of them were written with
+ * writeObject so can be referred back to
+ */
+TEST (References, strings) { // NOLINT
+    Readers readers;
+
+    auto strings = std::make_shared<ListReader> ("List<string>", readers.string);
+    strings->freeze();
+
+    auto blob = described ("net.corda:list", list ({
+        str ("one"), str ("two"), reference (1), reference (0) }));
+
+    codec::Cursor cursor (blob.data(), blob.size());
+    cursor.next();
+
+    auto read = strings->read (&cursor);
+
+    ASSERT_EQ (4U, read.asList().size());
+    EXPECT_EQ ("two", read[2].asString());
+    EXPECT_EQ ("one", read[3].asString());
+
+    const auto & references = cursor.references();
+
+    ASSERT_EQ (3U, references.size());
+    EXPECT_EQ (str ("one"), references.object (0));
+    EXPECT_EQ (blob, references.object (2));
+}
+
+/******************************************************************************/
+
+TEST (References, isReference) { // NOLINT
+    auto blob = reference (200) + described ("net.corda:inner", list ({ }));
+
+    codec::Cursor cursor (blob.data(), blob.size());
+    size_t index { 0 };
+
+    cursor.next();
+    ASSERT_TRUE (cursor.isReference (index));
+    EXPECT_EQ (200U, index);
+
+    cursor.next();
+    EXPECT_FALSE (cursor.isReference (index));
+}
+
+/******************************************************************************/
+
+/*
+ * Without a reader there's no telling what the JVM numbered
+ */
+TEST (References, unread) { // NOLINT
+    auto blob = reference (0);
+
+    codec::Cursor cursor (blob.data(), blob.size());
+    cursor.next();
+
+    EXPECT_THROW (codec::auto_resolve ref (&cursor), std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+/*
+ * By default the object is repeated wherever it's referred to
+ */
+TEST (References, visit) { // NOLINT
+    Readers readers;
+
+    auto visit = [&](codec::Cursor * c_, JsonWriter & json_) {
+        readers.outer->visit (c_, schema(), json_);
+    };
+
+    EXPECT_EQ (
+        "{ \"a\" : 1, \"b\" : { \"x\" : 2, \"y\" : \"two\" }, \"c\" : [ 3, 4 ], "
+        "\"d\" : [ { \"x\" : 2, \"y\" : \"two\" }, { \"x\" : 6, \"y\" : \"six\" } ] }\n",
+        json (sharedBlob(), visit));
+
+    EXPECT_EQ (
+        "{ \"a\" : 1, \"b\" : { \"x\" : 2, \"y\" : \"two\" }, \"c\" : [ 3, 4 ], "
+        "\"d\" : [ { \"@ref\" : 0 }, { \"x\" : 6, \"y\" : \"six\" } ] }\n",
+        json (sharedBlob(), [&](codec::Cursor * c_, JsonWriter & json_) {
+            json_.references (true);
+            visit (c_, json_);
+        }));
+}
+
+/******************************************************************************/
+
+TEST (References, read) { // NOLINT
+    Readers readers;
+
+    auto blob = sharedBlob();
+    codec::Cursor cursor (blob.data(), blob.size());
+    cursor.next();
+
+    auto outer = readers.outer->read (&cursor);
+
+    ASSERT_EQ (2U, outer[3].asList().size());
+    EXPECT_EQ (2, outer[3][0][0].asInt());
+    EXPECT_EQ ("two", outer[3][0][1].asString());
+    EXPECT_EQ ("six", outer[3][1][1].asString());
+}
+
+/******************************************************************************/
+
+/*
+ * The reference in d to b is found even though b itself was skipped
+ */
+TEST (References, projection) { // NOLINT
+    Readers readers;
+    Projection projection (*readers.outer, { "d" });
+
+    EXPECT_EQ (
+        "{ \"d\" : [ { \"x\" : 2, \"y\" : \"two\" }, { \"x\" : 6, \"y\" : \"six\" } ] }\n",
+        json (sharedBlob(), [&](codec::Cursor * c_, JsonWriter & json_) {
+            projection.visit (c_, schema(), json_);
+        }));
+}
+
+/******************************************************************************/
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "amqp/SchemaCache.h"
+
+/******************************************************************************/
+
+namespace {
+
+    /*
+     * described (ulong 0xc562000000000002) [ [ ] ], the smallest
+     * schema we can encode
+     */
+    const std::string emptySchema {
+        '\x00',
+            '\x80', '\xc5', '\x62', 0, 0, 0, 0, 0, '\x02',
+            '\xc0', 2, 1,
+                '\x45'
+    };
+
+}
+
+/******************************************************************************/
+
+TEST (SchemaCache, fingerprint) { // NOLINT
+    using amqp::internal::SchemaCache;
+
+    EXPECT_EQ (SchemaCache::fingerprint ("abc"), SchemaCache::fingerprint ("abc"));
+    EXPECT_NE (SchemaCache::fingerprint ("abc"), SchemaCache::fingerprint ("abd"));
+}
+
+/******************************************************************************/
+
+TEST (SchemaCache, hit) { // NOLINT
+    amqp::internal::SchemaCache cache;
+
+    auto & first = cache.compile (emptySchema);
+
+    EXPECT_EQ (0, cache.hits());
+    EXPECT_EQ (1, cache.misses());
+
+    // a copy so we know we're not just matching on the pointer
+    std::string copy { emptySchema };
+    auto & second = cache.compile (copy);
+
+    EXPECT_EQ (&first, &second);
+    EXPECT_EQ (1, cache.hits());
+    EXPECT_EQ (1, cache.misses());
+    EXPECT_EQ (1, cache.size());
+}
+
+/******************************************************************************/
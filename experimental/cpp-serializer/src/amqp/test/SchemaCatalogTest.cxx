@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <cstdio>
+#include <unistd.h>
+
+#include "amqp/SchemaCatalog.h"
+
+#include "schema/restricted-types/List.h"
+
+#include "Blobs.h"
+
+/******************************************************************************/
+
+using namespace amqp::internal;
+using namespace amqp::internal::schema;
+
+/******************************************************************************/
+
+namespace {
+
+    std::string
+    tmpCatalog() {
+        return "/tmp/schema-catalog-test." + std::to_string (getpid());
+    }
+
+    /*
+     * class A (a : int, b : List<int>)
+     */
+    uPtr<Schema>
+    testSchema() {
+        OrderedTypeNotations<AMQPTypeNotation> types;
+
+        types.insert (test::restricted ("java.util.List<int>", "list"));
+        types.insert (test::composite ("A", "net.corda:A", {
+            { "a", "int" }, { "b", "java.util.List<int>" } }));
+
+        return std::make_unique<Schema> (std::move (types));
+    }
+
+}
+
+/******************************************************************************/
+
+TEST (SchemaCatalog, missing) { // NOLINT
+    SchemaCatalog catalog ("/tmp/no/such/catalog");
+
+    EXPECT_EQ (0, catalog.size());
+    EXPECT_EQ (nullptr, catalog.find (1, "bytes"));
+}
+
+/******************************************************************************/
+
+TEST (SchemaCatalog, roundTrip) { // NOLINT
+    auto path = tmpCatalog();
+
+    {
+        SchemaCatalog catalog (path);
+        catalog.add (1, "bytes", *testSchema());
+        catalog.save();
+    }
+
+    SchemaCatalog catalog (path);
+    ASSERT_EQ (1, catalog.size());
+
+    // same fingerprint, different schema
+    EXPECT_EQ (nullptr, catalog.find (1, "other"));
+
+    auto loaded = catalog.find (1, "bytes");
+    ASSERT_NE (nullptr, loaded);
+
+    auto a = loaded->fromDescriptor ("net.corda:A");
+    ASSERT_NE (loaded->end(), loaded->begin());
+    ASSERT_EQ ("A", a->second.get()->name());
+
+    const auto & composite = dynamic_cast<const Composite &>(*(a->second.get()));
+    ASSERT_EQ (2, composite.fields().size());
+    EXPECT_EQ ("a", composite.fields()[0]->name());
+    EXPECT_EQ ("java.util.List<int>", composite.fields()[1]->resolvedType());
+    EXPECT_TRUE (composite.fields()[1]->mandatory());
+
+    auto list = loaded->fromType ("java.util.List<int>");
+    const auto & restricted = dynamic_cast<const List &>(*(list->second.get()));
+    EXPECT_EQ ("int", restricted.listOf());
+
+    unlink (path.c_str());
+    unlink ((path + ".lock").c_str());
+}
+
+/******************************************************************************/
+
+TEST (SchemaCatalog, merge) { // NOLINT
+    auto path = tmpCatalog();
+
+    SchemaCatalog first (path);
+    SchemaCatalog second (path);
+
+    first.add (1, "one", *testSchema());
+    second.add (2, "two", *testSchema());
+
+    first.save();
+    second.save();
+
+    SchemaCatalog catalog (path);
+
+    EXPECT_EQ (2, catalog.size());
+    EXPECT_NE (nullptr, catalog.find (1, "one"));
+    EXPECT_NE (nullptr, catalog.find (2, "two"));
+
+    unlink (path.c_str());
+    unlink ((path + ".lock").c_str());
+}
+
+/******************************************************************************/
+
+TEST (SchemaCatalog, schemas) { // NOLINT
+    auto path = tmpCatalog();
+
+    {
+        SchemaCatalog catalog (path);
+        catalog.add (1, "one", *testSchema());
+        catalog.save();
+    }
+
+    SchemaCatalog catalog (path);
+    catalog.add (2, "two", *testSchema());
+
+    // one saved and one still pending
+    auto schemas = catalog.schemas();
+    ASSERT_EQ (2, schemas.size());
+
+    for (const auto & schema : schemas) {
+        EXPECT_EQ ("A", schema->fromDescriptor ("net.corda:A")->second.get()->name());
+    }
+
+    unlink (path.c_str());
+    unlink ((path + ".lock").c_str());
+}
+
+/******************************************************************************/
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "serialiser/Serialiser.h"
+
+#include "amqp/SchemaCache.h"
+#include "amqp/AMQPHeader.h"
+#include "amqp/reader/Binary.h"
+#include "amqp/binding/Decoder.h"
+
+/******************************************************************************/
+
+namespace {
+
+    struct Leg {
+        int32_t     index;
+        std::string party;
+    };
+
+    struct Trade {
+        int64_t                           quantity;
+        double                            price;
+        std::string                       reference;
+        bool                              settled;
+        amqp::reader::Binary              hash;
+        Leg                               first;
+        std::vector<Leg>                  legs;
+        std::vector<std::vector<int32_t>> matrix;
+    };
+
+    struct Named {
+        int32_t a;
+    };
+
+    /*
+     * Everything after the header and section id
+     */
+    std::string_view
+    payload (std::string_view blob_) {
+        return blob_.substr (amqp::AMQP_HEADER.size() + 1);
+    }
+
+}
+
+/******************************************************************************/
+
+namespace amqp::binding {
+
+    template<>
+    struct Binding<Leg> {
+        static constexpr std::string_view type { "net.corda.Leg" };
+
+        static constexpr auto fields = std::make_tuple (
+            field ("index", &Leg::index),
+            field ("party", &Leg::party));
+    };
+
+    template<>
+    struct Binding<Trade> {
+        static constexpr std::string_view type { "net.corda.Trade" };
+
+        static constexpr auto fields = std::make_tuple (
+            field ("quantity", &Trade::quantity),
+            field ("price", &Trade::price),
+            field ("reference", &Trade::reference),
+            field ("settled", &Trade::settled),
+            field ("hash", &Trade::hash),
+            field ("first", &Trade::first),
+            field ("legs", &Trade::legs),
+            field ("matrix", &Trade::matrix));
+    };
+
+    template<>
+    struct Binding<Named> {
+        static constexpr std::string_view type { "net.corda.Named" };
+        static constexpr std::string_view descriptor { "net.corda:lJ96fbMlaK66WxNRrBvIfQ==" };
+
+        static constexpr auto fields = std::make_tuple (
+            field ("a", &Named::a));
+    };
+
+}
+
+/******************************************************************************/
+
+TEST (Serialiser, roundTrip) { // NOLINT
+    const std::string hash ("\x00\xff\x10\x80", 4);
+
+    Trade trade {
+        -5000000000L, 1.25, std::string (300, 'r'), true, { hash },
+        { 1, "alice" },
+        { { 2, "bob" }, { -200, "carol" } },
+        { { 1, 2 }, { }, { 100000 } } };
+
+    serialiser::Serialiser s;
+    auto blob = s.serialise (trade);
+
+    ASSERT_EQ (0, blob.compare (0, amqp::AMQP_HEADER.size(),
+            amqp::AMQP_HEADER.data(), amqp::AMQP_HEADER.size()));
+    ASSERT_EQ (amqp::DATA_AND_STOP, blob[amqp::AMQP_HEADER.size()]);
+
+    amqp::internal::SchemaCache cache;
+    amqp::internal::binding::Decoder<Trade> decoder;
+
+    auto bytes = payload (blob);
+    auto out = decoder.decode (bytes.data(), bytes.size(), cache);
+
+    EXPECT_EQ (trade.quantity, out.quantity);
+    EXPECT_EQ (trade.price, out.price);
+    EXPECT_EQ (trade.reference, out.reference);
+    EXPECT_TRUE (out.settled);
+    EXPECT_EQ (trade.hash, out.hash);
+
+    // a view of the blob, not a copy
+    EXPECT_GE (out.hash.bytes.data(), bytes.data());
+    EXPECT_LE (out.hash.bytes.data() + out.hash.bytes.size(), bytes.data() + bytes.size());
+    EXPECT_EQ ("alice", out.first.party);
+    ASSERT_EQ (2U, out.legs.size());
+    EXPECT_EQ (-200, out.legs[1].index);
+    EXPECT_EQ ("carol", out.legs[1].party);
+    EXPECT_EQ (trade.matrix, out.matrix);
+}
+
+/******************************************************************************/
+
+/*
+ * Every blob of a type carries the same schema, byte for byte, so they
+ * all share one entry in a SchemaCache
+ */
+TEST (Serialiser, schemaCached) { // NOLINT
+    EXPECT_EQ (&serialiser::Serialiser::schema<Leg>(), &serialiser::Serialiser::schema<Leg>());
+
+    std::string one, two;
+    serialiser::Serialiser::serialise (Leg { 1, "one" }, one);
+    serialiser::Serialiser::serialise (Leg { 2, "two" }, two);
+
+    EXPECT_NE (one, two);
+
+    const auto & schema = serialiser::Serialiser::schema<Leg>();
+    ASSERT_GT (one.size(), schema.size());
+    EXPECT_EQ (schema, one.substr (one.size() - schema.size()));
+
+    amqp::internal::SchemaCache cache;
+    amqp::internal::binding::Decoder<Leg> decoder;
+
+    for (const auto & blob : { one, two, one }) {
+        auto bytes = payload (blob);
+        decoder.decode (bytes.data(), bytes.size(), cache);
+    }
+
+    EXPECT_EQ (1U, cache.size());
+    EXPECT_EQ (2U, cache.hits());
+}
+
+/******************************************************************************/
+
+TEST (Serialiser, descriptors) { // NOLINT
+    using amqp::internal::serialiser::Member;
+
+    EXPECT_EQ ("net.corda:lJ96fbMlaK66WxNRrBvIfQ==", Member<Named>::descriptor());
+
+    auto derived = Member<Leg>::descriptor();
+    EXPECT_EQ (0U, derived.find ("net.corda:"));
+    EXPECT_EQ (34U, derived.size());
+    EXPECT_NE (derived, Member<Trade>::descriptor());
+
+    EXPECT_EQ ("java.util.List<java.util.List<int>>",
+            Member<std::vector<std::vector<int32_t>>>::name());
+
+    Named named { 7 };
+    std::string blob;
+    serialiser::Serialiser::serialise (named, blob);
+
+    amqp::internal::SchemaCache cache;
+    amqp::internal::binding::Decoder<Named> decoder;
+
+    auto bytes = payload (blob);
+    EXPECT_EQ (7, decoder.decode (bytes.data(), bytes.size(), cache).a);
+}
+
+/******************************************************************************/
@@ -10,7 +10,7 @@ using namespace amqp::internal::reader;
 TEST (Single, string) { // NOLINT
     TypedSingle<std::string> str_test ("Hello");
 
-    EXPECT_EQ("Hello", str_test.dump());
+    EXPECT_EQ("\"Hello\"", str_test.dump());
 }
 
 TEST (Single, list) { // NOLINT
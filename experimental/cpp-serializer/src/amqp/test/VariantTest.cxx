@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <stdexcept>
+
+#include "codec/codec_wrapper.h"
+
+#include "amqp/reader/Variant.h"
+
+#include "Blobs.h"
+
+/******************************************************************************/
+
+using amqp::reader::Record;
+using amqp::reader::Variant;
+
+/******************************************************************************/
+
+TEST (Variant, primitives) { // NOLINT
+    EXPECT_TRUE (Variant().isNull());
+    EXPECT_EQ (Variant::Type::Int, Variant (int32_t { 1 }).type());
+    EXPECT_EQ (Variant::Type::Long, Variant (int64_t { 1 }).type());
+    EXPECT_EQ (Variant::Type::String, Variant ("a").type());
+
+    EXPECT_EQ (10, Variant (int32_t { 10 }).asInt());
+    EXPECT_EQ ("hello", Variant ("hello").asString());
+    EXPECT_TRUE (Variant (true).asBool());
+
+    EXPECT_THROW (Variant (int32_t { 10 }).asLong(), std::runtime_error); // NOLINT
+    EXPECT_THROW (Variant ("a")[0], std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+TEST (Variant, read) { // NOLINT
+    test::Readers readers;
+
+    auto blob = test::outerBlob (1);
+    codec::Cursor cursor (blob.data(), blob.size());
+    cursor.next();
+
+    auto outer = readers.outer->read (&cursor);
+
+    ASSERT_EQ (Variant::Type::Record, outer.type());
+    ASSERT_EQ (4U, outer.asRecord().fields.size());
+
+    EXPECT_EQ (1, outer[0].asInt());
+    EXPECT_EQ (2, outer[1][0].asInt());
+    EXPECT_EQ ("two", outer[1][1].asString());
+
+    EXPECT_EQ (Variant (Variant::List { Variant (int32_t { 3 }), Variant (int32_t { 4 }) }),
+            outer[2]);
+
+    ASSERT_EQ (2U, outer[3].asList().size());
+    EXPECT_EQ (Variant (Record { { Variant (int32_t { 6 }), Variant ("six") } }), outer[3][1]);
+
+    EXPECT_THROW (outer[4], std::runtime_error); // NOLINT
+}
+
+/******************************************************************************/
+
+/*
+ * Reading has to leave the cursor after the value, just as visiting does
+ */
+TEST (Variant, readMovesOn) { // NOLINT
+    test::Readers readers;
+
+    auto blob = test::list ({ test::outerBlob (1), test::outerBlob (2), test::smallint (3) });
+    codec::Cursor cursor (blob.data(), blob.size());
+    cursor.next();
+
+    codec::auto_enter ae (&cursor);
+
+    EXPECT_EQ (1, readers.outer->read (&cursor)[0].asInt());
+    EXPECT_EQ (2, readers.outer->read (&cursor)[0].asInt());
+    EXPECT_EQ (3, readers.integer->read (&cursor).asInt());
+}
+
+/******************************************************************************/
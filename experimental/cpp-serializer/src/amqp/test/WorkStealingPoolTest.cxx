@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <set>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+
+#include "amqp/WorkStealingPool.h"
+
+/******************************************************************************/
+
+TEST (WorkStealingPool, runsEverythingOnce) { // NOLINT
+    amqp::internal::WorkStealingPool pool (4);
+
+    std::vector<std::atomic<int>> ran (1000);
+
+    for (size_t i { 0 } ; i < ran.size() ; ++i) {
+        pool.submit ([&ran, i](size_t) { ++ran[i]; });
+    }
+
+    pool.wait();
+
+    for (const auto & r : ran) {
+        ASSERT_EQ (1, r);
+    }
+}
+
+/******************************************************************************/
+
+TEST (WorkStealingPool, workerIndex) { // NOLINT
+    amqp::internal::WorkStealingPool pool (3);
+
+    std::mutex lock;
+    std::set<size_t> workers;
+
+    for (int i { 0 } ; i < 100 ; ++i) {
+        pool.submit ([&](size_t worker_) {
+            std::lock_guard<std::mutex> guard (lock);
+            workers.insert (worker_);
+        });
+    }
+
+    pool.wait();
+
+    ASSERT_EQ (3, pool.size());
+    ASSERT_FALSE (workers.empty());
+    ASSERT_LT (*workers.rbegin(), pool.size());
+}
+
+/******************************************************************************/
+
+/*
+ * The first task doesn't finish until every counting task has run. They
+ * all share its deque so whichever worker ends up stuck on it the other
+ * has to clear the lot, stealing them if need be
+ */
+TEST (WorkStealingPool, stealing) { // NOLINT
+    amqp::internal::WorkStealingPool pool (2);
+
+    std::atomic<int> stolen { 0 };
+
+    pool.submit ([&stolen](size_t) {
+        while (stolen < 10) std::this_thread::yield();
+    });
+
+    // tasks are dealt round robin, pad out the other deque
+    for (int i { 0 } ; i < 10 ; ++i) {
+        pool.submit ([](size_t) { });
+        pool.submit ([&stolen](size_t) { ++stolen; });
+    }
+
+    pool.wait();
+
+    ASSERT_EQ (10, stolen);
+}
+
+/******************************************************************************/
+
+TEST (WorkStealingPool, rethrow) { // NOLINT
+    amqp::internal::WorkStealingPool pool (2);
+
+    pool.submit ([](size_t) { throw std::runtime_error ("bang"); });
+    pool.submit ([](size_t) { });
+
+    ASSERT_THROW (pool.wait(), std::runtime_error); // NOLINT
+
+    pool.submit ([](size_t) { });
+    pool.wait();
+}
+
+/******************************************************************************/
+
+TEST (WorkStealingPool, drainOnDestruction) { // NOLINT
+    std::atomic<int> ran { 0 };
+
+    {
+        amqp::internal::WorkStealingPool pool (2);
+
+        for (int i { 0 } ; i < 50 ; ++i) {
+            pool.submit ([&ran](size_t) { ++ran; });
+        }
+    }
+
+    ASSERT_EQ (50, ran);
+}
+
+/******************************************************************************/
@@ -0,0 +1,210 @@
+#include "Bulk.h"
+
+#include <cstring>
+
+#include "ByteSwap.h"
+
+/******************************************************************************/
+
+namespace {
+
+    using namespace codec;
+
+    /*
+     * For each C++ type the format code of its full width encoding, which
+     * arrays of it are bulk converted from, and every code a value of it
+     * may be written with
+     */
+    template<typename T> struct Traits;
+
+    template<>
+    struct Traits<int8_t> {
+        static constexpr uint8_t wide { 0x51 };
+        static bool accepts (uint8_t c_) { return c_ == wide; }
+        static int8_t get (const Cursor & c_) { return c_.getByte(); }
+    };
+
+    template<>
+    struct Traits<uint8_t> {
+        static constexpr uint8_t wide { 0x50 };
+        static bool accepts (uint8_t c_) { return c_ == wide; }
+        static uint8_t get (const Cursor & c_) { return c_.getUByte(); }
+    };
+
+    template<>
+    struct Traits<int16_t> {
+        static constexpr uint8_t wide { 0x61 };
+        static bool accepts (uint8_t c_) { return c_ == wide; }
+        static int16_t get (const Cursor & c_) { return c_.getShort(); }
+    };
+
+    template<>
+    struct Traits<uint16_t> {
+        static constexpr uint8_t wide { 0x60 };
+        static bool accepts (uint8_t c_) { return c_ == wide; }
+        static uint16_t get (const Cursor & c_) { return c_.getUShort(); }
+    };
+
+    template<>
+    struct Traits<int32_t> {
+        static constexpr uint8_t wide { 0x71 };
+        static bool accepts (uint8_t c_) { return c_ == wide || c_ == 0x54; }
+        static int32_t get (const Cursor & c_) { return c_.getInt(); }
+    };
+
+    template<>
+    struct Traits<uint32_t> {
+        static constexpr uint8_t wide { 0x70 };
+        static bool accepts (uint8_t c_) { return c_ == wide || c_ == 0x52 || c_ == 0x43; }
+        static uint32_t get (const Cursor & c_) { return c_.getUInt(); }
+    };
+
+    template<>
+    struct Traits<char32_t> {
+        static constexpr uint8_t wide { 0x73 };
+        static bool accepts (uint8_t c_) { return c_ == wide; }
+        static char32_t get (const Cursor & c_) { return c_.getChar(); }
+    };
+
+    template<>
+    struct Traits<int64_t> {
+        static constexpr uint8_t wide { 0x81 };
+        static bool accepts (uint8_t c_) { return c_ == wide || c_ == 0x55; }
+        static int64_t get (const Cursor & c_) { return c_.getLong(); }
+    };
+
+    template<>
+    struct Traits<uint64_t> {
+        static constexpr uint8_t wide { 0x80 };
+        static bool accepts (uint8_t c_) { return c_ == wide || c_ == 0x53 || c_ == 0x44; }
+        static uint64_t get (const Cursor & c_) { return c_.getULong(); }
+    };
+
+    template<>
+    struct Traits<float> {
+        static constexpr uint8_t wide { 0x72 };
+        static bool accepts (uint8_t c_) { return c_ == wide; }
+        static float get (const Cursor & c_) { return c_.getFloat(); }
+    };
+
+    template<>
+    struct Traits<double> {
+        static constexpr uint8_t wide { 0x82 };
+        static bool accepts (uint8_t c_) { return c_ == wide; }
+        static double get (const Cursor & c_) { return c_.getDouble(); }
+    };
+
+    template<typename T>
+    void
+    swap (const char * src_, T * dst_, size_t n_) {
+        if constexpr (sizeof (T) == 1) {
+            memcpy (dst_, src_, n_);
+        } else if constexpr (sizeof (T) == 2) {
+            byteswap16 (src_, dst_, n_);
+        } else if constexpr (sizeof (T) == 4) {
+            byteswap32 (src_, dst_, n_);
+        } else {
+            byteswap64 (src_, dst_, n_);
+        }
+    }
+
+    /*
+     * Element by element, for lists, arrays of compact encodings, and
+     * anything else readAll can't simply convert
+     */
+    template<typename T>
+    bool
+    walk (Cursor * data_, size_t elements_, std::vector<T> & out_) {
+        out_.clear();
+        out_.reserve (elements_);
+
+        data_->enter();
+
+        for (size_t i { 0 } ; i < elements_ ; ++i) {
+            if (!data_->next() || !Traits<T>::accepts (data_->code())) {
+                data_->exit();
+                return false;
+            }
+
+            out_.push_back (Traits<T>::get (*data_));
+        }
+
+        data_->exit();
+
+        return true;
+    }
+
+}
+
+/******************************************************************************/
+
+bool
+codec::isBulk (type_t type_) {
+    switch (type_) {
+        case AMQP_BYTE :
+        case AMQP_UBYTE :
+        case AMQP_SHORT :
+        case AMQP_USHORT :
+        case AMQP_INT :
+        case AMQP_UINT :
+        case AMQP_LONG :
+        case AMQP_ULONG :
+        case AMQP_FLOAT :
+        case AMQP_DOUBLE :
+        case AMQP_CHAR : return true;
+        default : return false;
+    }
+}
+
+/******************************************************************************/
+
+template<typename T>
+bool
+codec::readAll (Cursor * data_, std::vector<T> & out_) {
+    switch (data_->type()) {
+        case AMQP_ARRAY : {
+            uint8_t code;
+            auto elements = data_->getArrayElements (code);
+
+            if (code == Traits<T>::wide) {
+                out_.resize (elements.size() / sizeof (T));
+                swap (elements.data(), out_.data(), out_.size());
+                break;
+            }
+
+            if (!walk (data_, data_->getArray(), out_)) {
+                return false;
+            }
+
+            break;
+        }
+        case AMQP_LIST : {
+            if (!walk (data_, data_->getList(), out_)) {
+                return false;
+            }
+
+            break;
+        }
+        default : return false;
+    }
+
+    data_->next();
+
+    return true;
+}
+
+/******************************************************************************/
+
+template bool codec::readAll<int8_t> (Cursor *, std::vector<int8_t> &);
+template bool codec::readAll<uint8_t> (Cursor *, std::vector<uint8_t> &);
+template bool codec::readAll<int16_t> (Cursor *, std::vector<int16_t> &);
+template bool codec::readAll<uint16_t> (Cursor *, std::vector<uint16_t> &);
+template bool codec::readAll<int32_t> (Cursor *, std::vector<int32_t> &);
+template bool codec::readAll<uint32_t> (Cursor *, std::vector<uint32_t> &);
+template bool codec::readAll<char32_t> (Cursor *, std::vector<char32_t> &);
+template bool codec::readAll<int64_t> (Cursor *, std::vector<int64_t> &);
+template bool codec::readAll<uint64_t> (Cursor *, std::vector<uint64_t> &);
+template bool codec::readAll<float> (Cursor *, std::vector<float> &);
+template bool codec::readAll<double> (Cursor *, std::vector<double> &);
+
+/******************************************************************************/
@@ -0,0 +1,50 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <vector>
+#include <cstdint>
+
+#include "Cursor.h"
+
+/******************************************************************************
+ *
+ * Bulk decoding of runs of primitives
+ *
+ ******************************************************************************/
+
+namespace codec {
+
+    /**
+     * Whether there's a bulk decoder for elements of the AMQP type, each
+     * has its own C++ type, see readAll
+     *
+     *   byte : int8_t      ubyte : uint8_t
+     *   short : int16_t    ushort : uint16_t
+     *   int : int32_t      uint : uint32_t
+     *   long : int64_t     ulong : uint64_t
+     *   float : float      double : double
+     *   char : char32_t
+     */
+    bool isBulk (type_t);
+
+    /**
+     * Decode the list or array the cursor is on, every element of which
+     * should be the AMQP type T is read from, into out_, replacing what
+     * it held, and move past it.
+     *
+     * Arrays of full width values, as the JVM writes its primitive arrays,
+     * are converted in one go, see byteswap64 and friends. Anything else,
+     * lists or the compact encodings of small numbers, is walked without
+     * looking at anything but the format code of each element.
+     *
+     * Returns false, without moving, if the cursor isn't on a list or
+     * array or it holds anything else, a null say, leaving the caller to
+     * fall back on reading element by element. out_ is then unspecified.
+     */
+    template<typename T>
+    bool readAll (Cursor *, std::vector<T> & out_);
+
+}
+
+/******************************************************************************/
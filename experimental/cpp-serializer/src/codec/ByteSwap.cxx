@@ -0,0 +1,174 @@
+#include "ByteSwap.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if (defined (__x86_64__) || defined (__i386__)) && (defined (__GNUC__) || defined (__clang__))
+#define CODEC_BYTESWAP_X86
+#include <immintrin.h>
+#endif
+
+/******************************************************************************/
+
+namespace {
+
+    template<size_t W> struct Word;
+    template<> struct Word<2> { using type = uint16_t; };
+    template<> struct Word<4> { using type = uint32_t; };
+    template<> struct Word<8> { using type = uint64_t; };
+
+    /*
+     * Assembled a byte at a time so it's right whatever order the host
+     * is, compilers recognise the pattern and emit a single load and swap
+     */
+    template<size_t W>
+    void
+    scalar (const uint8_t * src_, uint8_t * dst_, size_t n_) {
+        for (size_t i { 0 } ; i < n_ ; ++i, src_ += W, dst_ += W) {
+            typename Word<W>::type value { 0 };
+
+            for (size_t b { 0 } ; b < W ; ++b) {
+                value = static_cast<typename Word<W>::type>((value << 8U) | src_[b]);
+            }
+
+            memcpy (dst_, &value, W);
+        }
+    }
+
+#ifdef CODEC_BYTESWAP_X86
+
+    /*
+     * The pshufb control reversing each W byte value in a register. Only
+     * the bottom four bits of each index count and the AVX2 shuffle works
+     * within each 128 bit half, so the one mask serves both widths.
+     */
+    template<size_t W>
+    struct Mask {
+        alignas (32) char bytes[32];
+
+        constexpr Mask() : bytes { } {
+            for (size_t i { 0 } ; i < sizeof (bytes) ; ++i) {
+                bytes[i] = static_cast<char>((i / W) * W + W - 1 - i % W);
+            }
+        }
+    };
+
+    template<size_t W>
+    constexpr Mask<W> mask { };
+
+    template<size_t W>
+    __attribute__ ((target ("ssse3")))
+    void
+    ssse3 (const uint8_t * src_, uint8_t * dst_, size_t n_) {
+        const auto m = _mm_load_si128 (reinterpret_cast<const __m128i *>(mask<W>.bytes));
+
+        size_t bytes { n_ * W };
+        size_t i { 0 };
+
+        for ( ; i + 16 <= bytes ; i += 16) {
+            auto v = _mm_loadu_si128 (reinterpret_cast<const __m128i *>(src_ + i));
+            _mm_storeu_si128 (reinterpret_cast<__m128i *>(dst_ + i), _mm_shuffle_epi8 (v, m));
+        }
+
+        scalar<W> (src_ + i, dst_ + i, (bytes - i) / W);
+    }
+
+    template<size_t W>
+    __attribute__ ((target ("avx2")))
+    void
+    avx2 (const uint8_t * src_, uint8_t * dst_, size_t n_) {
+        const auto m = _mm256_load_si256 (reinterpret_cast<const __m256i *>(mask<W>.bytes));
+
+        size_t bytes { n_ * W };
+        size_t i { 0 };
+
+        for ( ; i + 64 <= bytes ; i += 64) {
+            auto a = _mm256_loadu_si256 (reinterpret_cast<const __m256i *>(src_ + i));
+            auto b = _mm256_loadu_si256 (reinterpret_cast<const __m256i *>(src_ + i + 32));
+            _mm256_storeu_si256 (reinterpret_cast<__m256i *>(dst_ + i), _mm256_shuffle_epi8 (a, m));
+            _mm256_storeu_si256 (reinterpret_cast<__m256i *>(dst_ + i + 32), _mm256_shuffle_epi8 (b, m));
+        }
+
+        for ( ; i + 32 <= bytes ; i += 32) {
+            auto a = _mm256_loadu_si256 (reinterpret_cast<const __m256i *>(src_ + i));
+            _mm256_storeu_si256 (reinterpret_cast<__m256i *>(dst_ + i), _mm256_shuffle_epi8 (a, m));
+        }
+
+        scalar<W> (src_ + i, dst_ + i, (bytes - i) / W);
+    }
+
+#endif
+
+    using Kernel = void (*)(const uint8_t *, uint8_t *, size_t);
+
+    struct Kernels {
+        const char * name;
+        Kernel       k16;
+        Kernel       k32;
+        Kernel       k64;
+    };
+
+    /*
+     * Chosen once, the first time anything is swapped
+     */
+    const Kernels &
+    kernels() {
+        static const Kernels rtn = []() {
+#ifdef CODEC_BYTESWAP_X86
+            __builtin_cpu_init();
+
+            if (__builtin_cpu_supports ("avx2")) {
+                return Kernels { "avx2", &avx2<2>, &avx2<4>, &avx2<8> };
+            }
+
+            if (__builtin_cpu_supports ("ssse3")) {
+                return Kernels { "ssse3", &ssse3<2>, &ssse3<4>, &ssse3<8> };
+            }
+#endif
+            return Kernels { "scalar", &scalar<2>, &scalar<4>, &scalar<8> };
+        }();
+
+        return rtn;
+    }
+
+    inline const uint8_t *
+    in (const void * p_) {
+        return static_cast<const uint8_t *>(p_);
+    }
+
+    inline uint8_t *
+    out (void * p_) {
+        return static_cast<uint8_t *>(p_);
+    }
+
+}
+
+/******************************************************************************/
+
+void
+codec::byteswap16 (const void * src_, void * dst_, size_t n_) {
+    kernels().k16 (in (src_), out (dst_), n_);
+}
+
+/******************************************************************************/
+
+void
+codec::byteswap32 (const void * src_, void * dst_, size_t n_) {
+    kernels().k32 (in (src_), out (dst_), n_);
+}
+
+/******************************************************************************/
+
+void
+codec::byteswap64 (const void * src_, void * dst_, size_t n_) {
+    kernels().k64 (in (src_), out (dst_), n_);
+}
+
+/******************************************************************************/
+
+const char *
+codec::byteswapKernel() {
+    return kernels().name;
+}
+
+/******************************************************************************/
@@ -0,0 +1,35 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <cstddef>
+
+/******************************************************************************
+ *
+ * Bulk conversion of big endian values to host order
+ *
+ ******************************************************************************/
+
+namespace codec {
+
+    /**
+     * Copy n_ values of 2, 4 or 8 bytes from src_, in network order, to
+     * dst_ in host order. Neither need be aligned and they mustn't overlap.
+     *
+     * On x86 the work is done 32 bytes at a time with AVX2, or 16 with
+     * SSSE3, when the CPU we're running on has them, picked once when
+     * first called. Anything else, and what's left over at the end, is
+     * swapped one value at a time.
+     */
+    void byteswap16 (const void * src_, void * dst_, size_t n_);
+    void byteswap32 (const void * src_, void * dst_, size_t n_);
+    void byteswap64 (const void * src_, void * dst_, size_t n_);
+
+    /**
+     * Which of the above is in use, "avx2", "ssse3" or "scalar"
+     */
+    const char * byteswapKernel();
+
+}
+
+/******************************************************************************/
@@ -0,0 +1,860 @@
+#include "Cursor.h"
+
+#include <limits>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include "References.h"
+
+#include "amqp/descriptors/AMQPDescriptorRegistory.h"
+
+/******************************************************************************/
+
+namespace {
+
+    /*
+     * AMQP is big endian on the wire
+     */
+    inline uint16_t
+    be16 (const uint8_t * p_) {
+        return static_cast<uint16_t>((p_[0] << 8U) | p_[1]);
+    }
+
+    inline uint32_t
+    be32 (const uint8_t * p_) {
+        return   (static_cast<uint32_t>(p_[0]) << 24U)
+               | (static_cast<uint32_t>(p_[1]) << 16U)
+               | (static_cast<uint32_t>(p_[2]) <<  8U)
+               |  static_cast<uint32_t>(p_[3]);
+    }
+
+    inline uint64_t
+    be64 (const uint8_t * p_) {
+        return (static_cast<uint64_t>(be32 (p_)) << 32U) | be32 (p_ + 4);
+    }
+
+    inline std::string_view
+    view (const uint8_t * p_, size_t sz_) {
+        return std::string_view (reinterpret_cast<const char *>(p_), sz_);
+    }
+
+    /*
+     * Format codes, see section 1.6 of the AMQP 1.0 specification
+     */
+    const uint8_t DESCRIBED = 0x00;
+    const uint8_t ULONG     = 0x80;
+    const uint8_t LIST0     = 0x45;
+    const uint8_t LIST8     = 0xc0;
+    const uint8_t MAP8      = 0xc1;
+    const uint8_t LIST32    = 0xd0;
+    const uint8_t MAP32     = 0xd1;
+    const uint8_t ARRAY8    = 0xe0;
+    const uint8_t ARRAY32   = 0xf0;
+
+}
+
+/******************************************************************************/
+
+const char *
+codec::type_name (codec::type_t type_) {
+    switch (type_) {
+        case AMQP_NULL       : return "null";
+        case AMQP_BOOL       : return "boolean";
+        case AMQP_UBYTE      : return "ubyte";
+        case AMQP_BYTE       : return "byte";
+        case AMQP_USHORT     : return "ushort";
+        case AMQP_SHORT      : return "short";
+        case AMQP_UINT       : return "uint";
+        case AMQP_INT        : return "int";
+        case AMQP_CHAR       : return "char";
+        case AMQP_ULONG      : return "ulong";
+        case AMQP_LONG       : return "long";
+        case AMQP_TIMESTAMP  : return "timestamp";
+        case AMQP_FLOAT      : return "float";
+        case AMQP_DOUBLE     : return "double";
+        case AMQP_DECIMAL32  : return "decimal32";
+        case AMQP_DECIMAL64  : return "decimal64";
+        case AMQP_DECIMAL128 : return "decimal128";
+        case AMQP_UUID       : return "uuid";
+        case AMQP_BINARY     : return "binary";
+        case AMQP_STRING     : return "string";
+        case AMQP_SYMBOL     : return "symbol";
+        case AMQP_DESCRIBED  : return "described";
+        case AMQP_ARRAY      : return "array";
+        case AMQP_LIST       : return "list";
+        case AMQP_MAP        : return "map";
+        default              : return "invalid";
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Only ever asked about the types named in a schema, so there's no need
+ * for anything cleverer than walking the codes
+ */
+codec::type_t
+codec::type_code (std::string_view name_) {
+    for (int code { AMQP_NULL } ; code <= AMQP_MAP ; ++code) {
+        if (name_ == type_name (static_cast<type_t>(code))) {
+            return static_cast<type_t>(code);
+        }
+    }
+
+    return AMQP_INVALID;
+}
+
+/******************************************************************************
+ *
+ * codec::Cursor
+ *
+ ******************************************************************************/
+
+codec::
+Cursor::Cursor (const char * data_, size_t size_)
+    : m_begin (reinterpret_cast<const uint8_t *>(data_))
+    , m_end (m_begin + size_)
+    , m_current { nullptr, nullptr, 0 }
+    , m_valid (false)
+    , m_numbering (false)
+{
+    m_stack.reserve (16);
+
+    /*
+     * The top level frame is unbounded in element count, only the size
+     * of the buffer constrains it
+     */
+    m_stack.push_back (Frame {
+            m_current, m_begin, m_end,
+            std::numeric_limits<size_t>::max(),
+            false, 0, nullptr });
+}
+
+/******************************************************************************/
+
+codec::
+Cursor::Cursor (std::string_view bytes_, const Cursor & owner_)
+    : Cursor (bytes_.data(), bytes_.size())
+{
+    m_references = owner_.m_references;
+    m_root = owner_.m_root;
+}
+
+/******************************************************************************/
+
+void
+codec::
+Cursor::check (const uint8_t * p_, size_t sz_) const {
+    if (p_ < m_begin || p_ + sz_ > m_end || p_ + sz_ < p_) {
+        std::stringstream ss;
+        ss << "AMQP buffer overrun at offset " << (p_ - m_begin)
+           << " reading " << sz_ << " bytes of " << (m_end - m_begin);
+        throw std::runtime_error (ss.str());
+    }
+}
+
+/******************************************************************************/
+
+void
+codec::
+Cursor::check (const uint8_t * p_, size_t sz_, const uint8_t * end_) const {
+    check (p_, sz_);
+
+    if (p_ + sz_ > end_) {
+        std::stringstream ss;
+        ss << "AMQP buffer overrun at offset " << (p_ - m_begin)
+           << " reading " << sz_ << " bytes of a value ending at offset "
+           << (end_ - m_begin);
+        throw std::runtime_error (ss.str());
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * Build a node for a value that carries its own constructor
+ */
+codec::Cursor::Node
+codec::
+Cursor::node (const uint8_t * p_) const {
+    check (p_, 1);
+    return Node { p_, p_ + 1, *p_ };
+}
+
+/******************************************************************************/
+
+/**
+ * The number of bytes following the format code for a value of that
+ * type. The top nibble of the format code tells us the width category
+ */
+size_t
+codec::
+Cursor::payloadSize (uint8_t code_, const uint8_t * p_) const {
+    switch (code_ >> 4U) {
+        case 0x4 : return 0;
+        case 0x5 : return 1;
+        case 0x6 : return 2;
+        case 0x7 : return 4;
+        case 0x8 : return 8;
+        case 0x9 : return 16;
+        case 0xa :
+        case 0xc :
+        case 0xe : {
+            check (p_, 1);
+            return 1 + *p_;
+        }
+        case 0xb :
+        case 0xd :
+        case 0xf : {
+            check (p_, 4);
+            return 4 + static_cast<size_t>(be32 (p_));
+        }
+        default : {
+            std::stringstream ss;
+            ss << "Unknown AMQP format code 0x" << std::hex
+               << static_cast<int>(code_);
+            throw std::runtime_error (ss.str());
+        }
+    }
+}
+
+/******************************************************************************/
+
+size_t
+codec::
+Cursor::size (const Node & node_) const {
+    size_t header = node_.payload - node_.start;
+
+    if (header && node_.code == DESCRIBED) {
+        auto descriptor = node (node_.payload);
+        auto dSize = size (descriptor);
+
+        return header + dSize + size (node (node_.payload + dSize));
+    }
+
+    return header + payloadSize (node_.code, node_.payload);
+}
+
+/******************************************************************************/
+
+bool
+codec::
+Cursor::next() {
+    auto & frame = m_stack.back();
+
+    if (frame.remaining == 0) {
+        return false;
+    }
+
+    Node n { };
+
+    if (frame.descriptor) {
+        n = node (frame.descriptor);
+        check (n.start, size (n));
+        frame.descriptor = nullptr;
+    } else {
+        if (frame.next >= frame.end) {
+            return false;
+        }
+
+        n = frame.array
+            ? Node { frame.next, frame.next, frame.elementCode }
+            : node (frame.next);
+
+        auto sz = size (n);
+        check (n.start, sz);
+        frame.next = n.start + sz;
+    }
+
+    --frame.remaining;
+
+    m_current = n;
+    m_valid = true;
+
+    return true;
+}
+
+/******************************************************************************/
+
+bool
+codec::
+Cursor::enter() {
+    if (!m_valid) {
+        return false;
+    }
+
+    Frame frame { m_current, nullptr, nullptr, 0, false, 0, nullptr };
+    const uint8_t * p = m_current.payload;
+
+    switch (m_current.code) {
+        case DESCRIBED : {
+            // a described type is always a pair, descriptor then value
+            frame.next = p;
+            frame.end = m_current.start + size (m_current);
+            frame.remaining = 2;
+            break;
+        }
+        case LIST8 :
+        case MAP8 : {
+            // the size has been checked, the count it should cover hasn't
+            frame.next = p + 2;
+            frame.end = p + 1 + p[0];
+            check (p + 1, 1, frame.end);
+            frame.remaining = p[1];
+            break;
+        }
+        case LIST32 :
+        case MAP32 : {
+            frame.next = p + 8;
+            frame.end = p + 4 + be32 (p);
+            check (p + 4, 4, frame.end);
+            frame.remaining = be32 (p + 4);
+            break;
+        }
+        case ARRAY8 :
+        case ARRAY32 : {
+            const uint8_t * ctor;
+
+            if (m_current.code == ARRAY8) {
+                frame.end = p + 1 + p[0];
+                check (p + 1, 1, frame.end);
+                frame.remaining = p[1];
+                ctor = p + 2;
+            } else {
+                frame.end = p + 4 + be32 (p);
+                check (p + 4, 4, frame.end);
+                frame.remaining = be32 (p + 4);
+                ctor = p + 8;
+            }
+
+            frame.array = true;
+
+            if (ctor < frame.end) {
+                if (*ctor == DESCRIBED) {
+                    auto dSize = size (node (ctor + 1));
+                    check (ctor + 1, dSize + 1, frame.end);
+
+                    frame.descriptor = ctor + 1;
+                    frame.elementCode = ctor[1 + dSize];
+                    frame.next = ctor + 2 + dSize;
+                    ++frame.remaining;
+                } else {
+                    frame.elementCode = *ctor;
+                    frame.next = ctor + 1;
+                }
+            }
+            break;
+        }
+        default : {
+            // Entering a scalar (or an empty list) is legal, it just
+            // has no children
+            break;
+        }
+    }
+
+    m_stack.push_back (frame);
+    m_valid = false;
+
+    return true;
+}
+
+/******************************************************************************/
+
+bool
+codec::
+Cursor::exit() {
+    if (m_stack.size() <= 1) {
+        return false;
+    }
+
+    m_current = m_stack.back().parent;
+    m_valid = true;
+    m_stack.pop_back();
+
+    return true;
+}
+
+/******************************************************************************/
+
+codec::type_t
+codec::
+Cursor::type() const {
+    if (!m_valid) {
+        return AMQP_INVALID;
+    }
+
+    if (m_current.payload != m_current.start && m_current.code == DESCRIBED) {
+        return AMQP_DESCRIBED;
+    }
+
+    switch (m_current.code) {
+        case 0x40 : return AMQP_NULL;
+        case 0x41 :
+        case 0x42 :
+        case 0x56 : return AMQP_BOOL;
+        case 0x50 : return AMQP_UBYTE;
+        case 0x51 : return AMQP_BYTE;
+        case 0x60 : return AMQP_USHORT;
+        case 0x61 : return AMQP_SHORT;
+        case 0x43 :
+        case 0x52 :
+        case 0x70 : return AMQP_UINT;
+        case 0x54 :
+        case 0x71 : return AMQP_INT;
+        case 0x73 : return AMQP_CHAR;
+        case 0x44 :
+        case 0x53 :
+        case 0x80 : return AMQP_ULONG;
+        case 0x55 :
+        case 0x81 : return AMQP_LONG;
+        case 0x83 : return AMQP_TIMESTAMP;
+        case 0x72 : return AMQP_FLOAT;
+        case 0x82 : return AMQP_DOUBLE;
+        case 0x74 : return AMQP_DECIMAL32;
+        case 0x84 : return AMQP_DECIMAL64;
+        case 0x94 : return AMQP_DECIMAL128;
+        case 0x98 : return AMQP_UUID;
+        case 0xa0 :
+        case 0xb0 : return AMQP_BINARY;
+        case 0xa1 :
+        case 0xb1 : return AMQP_STRING;
+        case 0xa3 :
+        case 0xb3 : return AMQP_SYMBOL;
+        case 0x45 :
+        case 0xc0 :
+        case 0xd0 : return AMQP_LIST;
+        case 0xc1 :
+        case 0xd1 : return AMQP_MAP;
+        case 0xe0 :
+        case 0xf0 : return AMQP_ARRAY;
+        default   : return AMQP_INVALID;
+    }
+}
+
+/******************************************************************************/
+
+uint8_t
+codec::
+Cursor::code() const {
+    return m_current.code;
+}
+
+/******************************************************************************/
+
+std::string_view
+codec::
+Cursor::bytes() const {
+    if (!m_valid) {
+        return std::string_view();
+    }
+
+    return view (m_current.start, size (m_current));
+}
+
+/******************************************************************************/
+
+bool
+codec::
+Cursor::isDescribed() const {
+    return type() == AMQP_DESCRIBED;
+}
+
+/******************************************************************************/
+
+/**
+ * The descriptor is always a full width ulong, the Corda prefix leaves
+ * no smaller encoding of it, so anything else is rejected on its first
+ * byte before we look any further
+ */
+bool
+codec::
+Cursor::isReference (size_t & index_) const {
+    if (!m_valid
+        || m_current.code != DESCRIBED
+        || m_current.payload == m_current.start
+    ) {
+        return false;
+    }
+
+    auto descriptor = node (m_current.payload);
+
+    if (descriptor.code != ULONG) {
+        return false;
+    }
+
+    check (descriptor.payload, 8);
+
+    if (be64 (descriptor.payload) != (amqp::internal::DESCRIPTOR_TOP_32BITS
+            | static_cast<uint64_t>(amqp::internal::REFERENCED_OBJECT))
+    ) {
+        return false;
+    }
+
+    auto value = node (descriptor.payload + 8);
+
+    switch (value.code) {
+        case 0x43 :
+        case 0x44 : index_ = 0; break;
+        case 0x52 :
+        case 0x53 : check (value.payload, 1); index_ = value.payload[0]; break;
+        case 0x70 : check (value.payload, 4); index_ = be32 (value.payload); break;
+        case ULONG : check (value.payload, 8); index_ = be64 (value.payload); break;
+        default : {
+            std::stringstream ss;
+            ss << "Object reference isn't a number, format code 0x" << std::hex
+               << static_cast<int>(value.code);
+            throw std::runtime_error (ss.str());
+        }
+    }
+
+    return true;
+}
+
+/******************************************************************************/
+
+codec::References &
+codec::
+Cursor::references() const {
+    if (!m_references) {
+        m_references = std::make_shared<References>();
+    }
+
+    return *m_references;
+}
+
+/******************************************************************************/
+
+/**
+ * The root is read with a cursor of its own that shares the table and,
+ * sitting inside the root, never takes another for it. Any reference
+ * met along the way is to something already numbered so resolving it
+ * doesn't start this again, and the cursor over what it refers to
+ * doesn't number. Only the root itself is left for us to add, last.
+ */
+std::string_view
+codec::
+Cursor::object (size_t index_) const {
+    auto & table = references();
+
+    if (!table.started()) {
+        if (!m_walk) {
+            std::stringstream ss;
+            ss << "Reference to object " << index_
+               << " outside of anything read against a schema";
+            throw std::runtime_error (ss.str());
+        }
+
+        table.start();
+
+        Cursor walk (m_root, *this);
+        walk.m_numbering = true;
+        walk.next();
+
+        bool object = References::isObject (walk);
+
+        m_walk (&walk);
+
+        if (object) {
+            table.add (m_root);
+        }
+    }
+
+    return table.object (index_);
+}
+
+/******************************************************************************/
+
+bool
+codec::
+Cursor::numbering() const {
+    return m_numbering;
+}
+
+/******************************************************************************/
+
+size_t
+codec::
+Cursor::getList() const {
+    switch (m_current.code) {
+        case LIST8  : return m_current.payload[1];
+        case LIST32 : return be32 (m_current.payload + 4);
+        default     : return 0;
+    }
+}
+
+/******************************************************************************/
+
+size_t
+codec::
+Cursor::getMap() const {
+    switch (m_current.code) {
+        case MAP8  : return m_current.payload[1];
+        case MAP32 : return be32 (m_current.payload + 4);
+        default    : return 0;
+    }
+}
+
+/******************************************************************************/
+
+size_t
+codec::
+Cursor::getArray() const {
+    switch (m_current.code) {
+        case ARRAY8  : return m_current.payload[1];
+        case ARRAY32 : return be32 (m_current.payload + 4);
+        default      : return 0;
+    }
+}
+
+/******************************************************************************/
+
+std::string_view
+codec::
+Cursor::getArrayElements (uint8_t & code_) const {
+    code_ = 0;
+
+    const uint8_t * p = m_current.payload;
+    const uint8_t * ctor;
+    const uint8_t * end;
+    size_t count;
+
+    switch (m_current.code) {
+        case ARRAY8  : {
+            end = p + 1 + p[0];
+            check (p + 1, 1, end);
+            count = p[1];
+            ctor = p + 2;
+            break;
+        }
+        case ARRAY32 : {
+            end = p + 4 + be32 (p);
+            check (p + 4, 4, end);
+            count = be32 (p + 4);
+            ctor = p + 8;
+            break;
+        }
+        default : return std::string_view();
+    }
+
+    if (ctor >= end) {
+        return std::string_view();
+    }
+
+    /*
+     * Zero width constructors (true, false, null, the zeros) and those
+     * from 0xa0 up have no fixed width payload
+     */
+    if (*ctor < 0x50 || *ctor >= 0xa0) {
+        return std::string_view();
+    }
+
+    // the elements are the array's, not whatever follows it
+    auto width = payloadSize (*ctor, ctor + 1);
+    check (ctor + 1, count * width, end);
+
+    code_ = *ctor;
+
+    return view (ctor + 1, count * width);
+}
+
+/******************************************************************************/
+
+bool
+codec::
+Cursor::getBool() const {
+    switch (m_current.code) {
+        case 0x41 : return true;
+        case 0x56 : return m_current.payload[0] != 0;
+        default   : return false;
+    }
+}
+
+/******************************************************************************/
+
+uint8_t
+codec::
+Cursor::getUByte() const {
+    return m_current.code == 0x50 ? m_current.payload[0] : 0;
+}
+
+/******************************************************************************/
+
+int8_t
+codec::
+Cursor::getByte() const {
+    return m_current.code == 0x51 ? static_cast<int8_t>(m_current.payload[0]) : 0;
+}
+
+/******************************************************************************/
+
+uint16_t
+codec::
+Cursor::getUShort() const {
+    return m_current.code == 0x60 ? be16 (m_current.payload) : 0;
+}
+
+/******************************************************************************/
+
+int16_t
+codec::
+Cursor::getShort() const {
+    return m_current.code == 0x61 ? static_cast<int16_t>(be16 (m_current.payload)) : 0;
+}
+
+/******************************************************************************/
+
+uint32_t
+codec::
+Cursor::getUInt() const {
+    switch (m_current.code) {
+        case 0x70 : return be32 (m_current.payload);
+        case 0x52 : return m_current.payload[0];
+        default   : return 0;
+    }
+}
+
+/******************************************************************************/
+
+int32_t
+codec::
+Cursor::getInt() const {
+    switch (m_current.code) {
+        case 0x71 : return static_cast<int32_t>(be32 (m_current.payload));
+        case 0x54 : return static_cast<int8_t>(m_current.payload[0]);
+        default   : return 0;
+    }
+}
+
+/******************************************************************************/
+
+uint32_t
+codec::
+Cursor::getChar() const {
+    return m_current.code == 0x73 ? be32 (m_current.payload) : 0;
+}
+
+/******************************************************************************/
+
+uint64_t
+codec::
+Cursor::getULong() const {
+    switch (m_current.code) {
+        case 0x80 : return be64 (m_current.payload);
+        case 0x53 : return m_current.payload[0];
+        default   : return 0;
+    }
+}
+
+/******************************************************************************/
+
+int64_t
+codec::
+Cursor::getLong() const {
+    switch (m_current.code) {
+        case 0x81 : return static_cast<int64_t>(be64 (m_current.payload));
+        case 0x55 : return static_cast<int8_t>(m_current.payload[0]);
+        default   : return 0;
+    }
+}
+
+/******************************************************************************/
+
+int64_t
+codec::
+Cursor::getTimestamp() const {
+    return m_current.code == 0x83
+        ? static_cast<int64_t>(be64 (m_current.payload))
+        : 0;
+}
+
+/******************************************************************************/
+
+float
+codec::
+Cursor::getFloat() const {
+    if (m_current.code != 0x72) return 0.0F;
+
+    auto bits = be32 (m_current.payload);
+    float rtn;
+    memcpy (&rtn, &bits, sizeof (rtn));
+    return rtn;
+}
+
+/******************************************************************************/
+
+double
+codec::
+Cursor::getDouble() const {
+    if (m_current.code != 0x82) return 0.0;
+
+    auto bits = be64 (m_current.payload);
+    double rtn;
+    memcpy (&rtn, &bits, sizeof (rtn));
+    return rtn;
+}
+
+/******************************************************************************/
+
+std::string_view
+codec::
+Cursor::getString() const {
+    switch (m_current.code) {
+        case 0xa1 : return view (m_current.payload + 1, m_current.payload[0]);
+        case 0xb1 : return view (m_current.payload + 4, be32 (m_current.payload));
+        default   : return std::string_view();
+    }
+}
+
+/******************************************************************************/
+
+std::string_view
+codec::
+Cursor::getSymbol() const {
+    switch (m_current.code) {
+        case 0xa3 : return view (m_current.payload + 1, m_current.payload[0]);
+        case 0xb3 : return view (m_current.payload + 4, be32 (m_current.payload));
+        default   : return std::string_view();
+    }
+}
+
+/******************************************************************************/
+
+std::string_view
+codec::
+Cursor::getBinary() const {
+    switch (m_current.code) {
+        case 0xa0 : return view (m_current.payload + 1, m_current.payload[0]);
+        case 0xb0 : return view (m_current.payload + 4, be32 (m_current.payload));
+        default   : return std::string_view();
+    }
+}
+
+/******************************************************************************/
+
+/**
+ * There's no arithmetic type to put them in, they're left as the IEEE 754
+ * decimal encoding they have on the wire
+ */
+std::string_view
+codec::
+Cursor::getDecimal() const {
+    switch (m_current.code) {
+        case 0x74 : return view (m_current.payload, 4);
+        case 0x84 : return view (m_current.payload, 8);
+        case 0x94 : return view (m_current.payload, 16);
+        default   : return std::string_view();
+    }
+}
+
+/******************************************************************************/
+
+std::string_view
+codec::
+Cursor::getUuid() const {
+    return m_current.code == 0x98
+        ? view (m_current.payload, 16)
+        : std::string_view();
+}
+
+/******************************************************************************/
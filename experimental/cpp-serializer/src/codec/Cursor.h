@@ -0,0 +1,287 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <utility>
+#include <functional>
+#include <string_view>
+
+/******************************************************************************/
+
+namespace codec {
+
+    /**
+     * The AMQP types we can find in a stream. The values deliberately
+     * mirror those of proton's pn_type_t so anyone used to reading
+     * proton debug output doesn't have to relearn them.
+     */
+    enum type_t {
+        AMQP_INVALID    = -1,
+        AMQP_NULL       =  1,
+        AMQP_BOOL       =  2,
+        AMQP_UBYTE      =  3,
+        AMQP_BYTE       =  4,
+        AMQP_USHORT     =  5,
+        AMQP_SHORT      =  6,
+        AMQP_UINT       =  7,
+        AMQP_INT        =  8,
+        AMQP_CHAR       =  9,
+        AMQP_ULONG      = 10,
+        AMQP_LONG       = 11,
+        AMQP_TIMESTAMP  = 12,
+        AMQP_FLOAT      = 13,
+        AMQP_DOUBLE     = 14,
+        AMQP_DECIMAL32  = 15,
+        AMQP_DECIMAL64  = 16,
+        AMQP_DECIMAL128 = 17,
+        AMQP_UUID       = 18,
+        AMQP_BINARY     = 19,
+        AMQP_STRING     = 20,
+        AMQP_SYMBOL     = 21,
+        AMQP_DESCRIBED  = 22,
+        AMQP_ARRAY      = 23,
+        AMQP_LIST       = 24,
+        AMQP_MAP        = 25
+    };
+
+    const char * type_name (type_t);
+
+    /**
+     * The reverse of type_name, AMQP_INVALID for anything that isn't the
+     * name of a type. The JVM names the primitive types of its schemas
+     * the same way.
+     */
+    type_t type_code (std::string_view);
+
+    class References;
+
+}
+
+/******************************************************************************
+ *
+ * class codec::Cursor
+ *
+ ******************************************************************************/
+
+namespace codec {
+
+    /**
+     * A zero copy decoder for an AMQP 1.0 encoded buffer.
+     *
+     * Rather than building a tree of nodes up front, as pn_data_decode does,
+     * the cursor walks the encoded bytes in place. Navigation deliberately
+     * follows the semantics of a pn_data_t so code written against one
+     * reads the same against the other
+     *
+     *   next  - move to the next sibling, or the first child if we've just
+     *           entered a compound type
+     *   enter - descend into the current node, positioned *before* its
+     *           first child
+     *   exit  - return to the parent, making it the current node again
+     *
+     * The buffer is never copied, it must outlive the cursor and anything
+     * (strings, symbols, binary) viewed through it.
+     */
+    class Cursor {
+        private :
+            struct Node {
+                /**
+                 * The first byte of the encoding. For array elements, which
+                 * share a single constructor, this is the first byte of
+                 * the value itself
+                 */
+                const uint8_t * start;
+
+                /**
+                 * First byte after the format code
+                 */
+                const uint8_t * payload;
+
+                uint8_t code;
+            };
+
+            struct Frame {
+                Node            parent;
+                const uint8_t * next;
+                const uint8_t * end;
+                size_t          remaining;
+
+                /**
+                 * Arrays encode their element constructor once so we need
+                 * to remember it for each element we move onto. An array
+                 * of described types also yields its descriptor as the
+                 * first child, as proton does.
+                 */
+                bool            array;
+                uint8_t         elementCode;
+                const uint8_t * descriptor;
+            };
+
+            const uint8_t *    m_begin;
+            const uint8_t *    m_end;
+            std::vector<Frame> m_stack;
+            Node               m_current;
+            bool               m_valid;
+
+            /**
+             * Only built if the blob turns out to have back references,
+             * shared with the cursors that walk what they refer to
+             */
+            mutable std::shared_ptr<References> m_references;
+
+            /**
+             * The object the blob's objects are numbered within, and how
+             * to read it again to number them, see root
+             */
+            std::string_view                  m_root;
+            std::function<void (Cursor *)>    m_walk;
+
+            /**
+             * Set on the cursor reading the root again to number what's
+             * in it, see auto_number
+             */
+            bool                              m_numbering;
+
+        public :
+            Cursor (const char *, size_t);
+            Cursor (const Cursor &) = delete;
+
+            /**
+             * A cursor over an object referred to from the blob another
+             * cursor is walking, see isReference, that resolves any
+             * references of its own against the other's object table
+             */
+            Cursor (std::string_view, const Cursor &);
+
+            bool next();
+            bool enter();
+            bool exit();
+
+            type_t type() const;
+
+            /**
+             * The raw AMQP format code of the current node
+             */
+            uint8_t code() const;
+
+            /**
+             * The complete encoding of the current node, constructor
+             * included. Useful for handing a sub tree off to something
+             * else without re-encoding it
+             */
+            std::string_view bytes() const;
+
+            bool isDescribed() const;
+
+            /**
+             * Corda writes any object it has already written earlier in
+             * the blob as a REFERENCED_OBJECT, a described number, rather
+             * than repeating it. True if the current node is one, with
+             * index_ set to that number
+             */
+            bool isReference (size_t & index_) const;
+
+            /**
+             * Readers of anything that can hold a back reference call this
+             * before reading it, with how to read it again. Unless the
+             * cursor is already inside such an object, one that's being
+             * read or a referenced one, that at the cursor becomes the
+             * root the blob's objects are numbered within, see References.
+             */
+            template<typename Walk>
+            void root (Walk && walk_);
+
+            /**
+             * The complete encoding of object index_. The first time one
+             * is needed the root is read again to number them.
+             */
+            std::string_view object (size_t index_) const;
+
+            /**
+             * The object table of the blob, empty until a reference has
+             * been resolved
+             */
+            References & references() const;
+
+            /**
+             * Whether this cursor is numbering the blob's objects
+             */
+            bool numbering() const;
+
+            /*
+             * Compound types, the number of child elements they hold
+             */
+            size_t getList() const;
+            size_t getMap() const;
+            size_t getArray() const;
+
+            /**
+             * For an array of fixed width primitives, the values back to
+             * back as they are on the wire, with code_ set to the format
+             * code they share. Empty, with code_ 0, for anything else,
+             * including arrays of described types or of variable width
+             * ones such as strings.
+             */
+            std::string_view getArrayElements (uint8_t & code_) const;
+
+            bool        getBool() const;
+            uint8_t     getUByte() const;
+            int8_t      getByte() const;
+            uint16_t    getUShort() const;
+            int16_t     getShort() const;
+            uint32_t    getUInt() const;
+            int32_t     getInt() const;
+            uint32_t    getChar() const;
+            uint64_t    getULong() const;
+            int64_t     getLong() const;
+            int64_t     getTimestamp() const;
+            float       getFloat() const;
+            double      getDouble() const;
+
+            /*
+             * Views into the underlying buffer, no copy is made
+             */
+            std::string_view getString() const;
+            std::string_view getSymbol() const;
+            std::string_view getBinary() const;
+            std::string_view getUuid() const;
+            std::string_view getDecimal() const;
+
+        private :
+            Node node (const uint8_t *) const;
+            size_t size (const Node &) const;
+            size_t payloadSize (uint8_t, const uint8_t *) const;
+            void check (const uint8_t *, size_t) const;
+
+            /**
+             * As above but bounded by the end of the compound value the
+             * bytes belong to rather than of the buffer
+             */
+            void check (const uint8_t *, size_t, const uint8_t * end_) const;
+    };
+
+}
+
+/******************************************************************************/
+
+template<typename Walk>
+void
+codec::
+Cursor::root (Walk && walk_) {
+    auto at = reinterpret_cast<const char *>(m_current.start);
+
+    if (!m_valid || (at >= m_root.data() && at < m_root.data() + m_root.size())) {
+        return;
+    }
+
+    m_root = bytes();
+    m_walk = std::forward<Walk> (walk_);
+    m_references.reset();
+}
+
+/******************************************************************************/
+
@@ -0,0 +1,58 @@
+#include "MappedBlob.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#include "amqp/AMQPHeader.h"
+
+/******************************************************************************/
+
+namespace {
+
+    /*
+     * The header followed by a single byte section id
+     */
+    const size_t PREAMBLE = amqp::AMQP_HEADER.size() + 1;
+
+}
+
+/******************************************************************************/
+
+codec::
+MappedBlob::MappedBlob (const std::string & path_)
+    : m_file (path_)
+{
+    if (m_file.size() < PREAMBLE) {
+        throw std::runtime_error ("Bad Header in blob, too short");
+    }
+
+    if (memcmp (m_file.data(), amqp::AMQP_HEADER.data(), amqp::AMQP_HEADER.size()) != 0) {
+        throw std::runtime_error ("Bad Header in blob");
+    }
+}
+
+/******************************************************************************/
+
+amqp::amqp_section_id_t
+codec::
+MappedBlob::section() const {
+    return static_cast<amqp::amqp_section_id_t>(m_file.data()[PREAMBLE - 1]);
+}
+
+/******************************************************************************/
+
+const char *
+codec::
+MappedBlob::payload() const {
+    return m_file.data() + PREAMBLE;
+}
+
+/******************************************************************************/
+
+size_t
+codec::
+MappedBlob::payloadSize() const {
+    return m_file.size() - PREAMBLE;
+}
+
+/******************************************************************************/
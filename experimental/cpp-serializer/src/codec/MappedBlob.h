@@ -0,0 +1,50 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <cstddef>
+
+#include "MappedFile.h"
+
+#include "amqp/AMQPSectionId.h"
+
+/******************************************************************************
+ *
+ * class codec::MappedBlob
+ *
+ ******************************************************************************/
+
+namespace codec {
+
+    /**
+     * A read only memory mapping of a serialised blob on disk.
+     *
+     * The header and section id are validated directly on the mapping,
+     * nothing is copied off of it so anything decoded from the payload
+     * (which, via the cursor, will be views into the mapping) is only
+     * valid for as long as the blob is.
+     *
+     * Throws std::runtime_error if the file can't be mapped or isn't
+     * a corda AMQP blob.
+     */
+    class MappedBlob {
+        private :
+            MappedFile m_file;
+
+        public :
+            explicit MappedBlob (const std::string &);
+
+            amqp::amqp_section_id_t section() const;
+
+            /**
+             * The encoded bytes that follow the header and section id
+             */
+            const char * payload() const;
+            size_t payloadSize() const;
+    };
+
+}
+
+/******************************************************************************/
+
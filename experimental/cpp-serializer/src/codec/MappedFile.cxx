@@ -0,0 +1,104 @@
+#include "MappedFile.h"
+
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/******************************************************************************/
+
+namespace {
+
+    std::string
+    error (const std::string & what_, const std::string & path_) {
+        std::stringstream ss;
+        ss << what_ << " " << path_ << ": " << strerror (errno);
+        return ss.str();
+    }
+
+}
+
+/******************************************************************************/
+
+codec::
+MappedFile::MappedFile (const std::string & path_)
+    : m_data (nullptr)
+    , m_size (0)
+{
+    int fd = ::open (path_.c_str(), O_RDONLY);
+
+    if (fd == -1) {
+        throw std::runtime_error (error ("Cannot open", path_));
+    }
+
+    struct stat results { };
+
+    if (::fstat (fd, &results) != 0) {
+        ::close (fd);
+        throw std::runtime_error (error ("Cannot stat", path_));
+    }
+
+    m_size = results.st_size;
+
+    // mmap won't map nothing, leave an empty file as an empty view
+    if (m_size == 0) {
+        ::close (fd);
+        return;
+    }
+
+    void * addr = ::mmap (nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // the mapping holds its own reference to the file
+    ::close (fd);
+
+    if (addr == MAP_FAILED) {
+        throw std::runtime_error (error ("Cannot map", path_));
+    }
+
+    m_data = static_cast<const char *>(addr);
+
+    // We walk files front to back exactly once, these are only hints
+    // so failure isn't worth reporting
+    ::madvise (addr, m_size, MADV_SEQUENTIAL);
+    ::madvise (addr, m_size, MADV_WILLNEED);
+}
+
+/******************************************************************************/
+
+codec::
+MappedFile::~MappedFile() {
+    if (m_data) {
+        ::munmap (const_cast<char *>(m_data), m_size);
+    }
+}
+
+/******************************************************************************/
+
+const char *
+codec::
+MappedFile::data() const {
+    return m_data;
+}
+
+/******************************************************************************/
+
+size_t
+codec::
+MappedFile::size() const {
+    return m_size;
+}
+
+/******************************************************************************/
+
+std::string_view
+codec::
+MappedFile::view() const {
+    return std::string_view (m_data, m_size);
+}
+
+/******************************************************************************/
@@ -0,0 +1,44 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <cstddef>
+#include <string_view>
+
+/******************************************************************************
+ *
+ * class codec::MappedFile
+ *
+ ******************************************************************************/
+
+namespace codec {
+
+    /**
+     * A read only, private, memory mapping of an entire file, unmapped
+     * when it goes out of scope.
+     *
+     * Throws std::runtime_error if the file can't be opened or mapped.
+     */
+    class MappedFile {
+        private :
+            const char * m_data;
+            size_t       m_size;
+
+        public :
+            explicit MappedFile (const std::string &);
+            MappedFile (const MappedFile &) = delete;
+            MappedFile & operator = (const MappedFile &) = delete;
+
+            ~MappedFile();
+
+            const char * data() const;
+            size_t size() const;
+
+            std::string_view view() const;
+    };
+
+}
+
+/******************************************************************************/
+
@@ -0,0 +1,90 @@
+#include "References.h"
+
+#include <sstream>
+#include <stdexcept>
+
+/******************************************************************************
+ *
+ * codec::References
+ *
+ ******************************************************************************/
+
+codec::
+References::References()
+    : m_started (false)
+{ }
+
+/******************************************************************************/
+
+bool
+codec::
+References::isObject (const Cursor & data_) {
+    switch (data_.type()) {
+        case AMQP_DESCRIBED : {
+            size_t index;
+            return !data_.isReference (index);
+        }
+        case AMQP_STRING :
+        case AMQP_SYMBOL :
+        case AMQP_TIMESTAMP :
+        case AMQP_UUID :
+        case AMQP_DECIMAL32 :
+        case AMQP_DECIMAL64 :
+        case AMQP_DECIMAL128 : {
+            return true;
+        }
+        default : {
+            return false;
+        }
+    }
+}
+
+/******************************************************************************/
+
+bool
+codec::
+References::started() const {
+    return m_started;
+}
+
+/******************************************************************************/
+
+void
+codec::
+References::start() {
+    m_started = true;
+    m_objects.clear();
+}
+
+/******************************************************************************/
+
+void
+codec::
+References::add (std::string_view object_) {
+    m_objects.push_back (object_);
+}
+
+/******************************************************************************/
+
+size_t
+codec::
+References::size() const {
+    return m_objects.size();
+}
+
+/******************************************************************************/
+
+std::string_view
+codec::
+References::object (size_t index_) const {
+    if (index_ >= m_objects.size()) {
+        std::stringstream ss;
+        ss << "Reference to object " << index_ << " of a blob holding "
+           << m_objects.size();
+        throw std::runtime_error (ss.str());
+    }
+
+    return m_objects[index_];
+}
+
+/******************************************************************************/
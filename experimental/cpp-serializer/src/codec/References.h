@@ -0,0 +1,78 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <vector>
+#include <string_view>
+
+#include "Cursor.h"
+
+/******************************************************************************
+ *
+ * class codec::References
+ *
+ ******************************************************************************/
+
+namespace codec {
+
+    /**
+     * The object table of a Corda blob, what its back references, see
+     * Cursor::isReference, are numbers into.
+     *
+     * The JVM numbers what it writes through writeObject, other than
+     * nulls, boxed primitives and byte arrays, in the order it finishes
+     * writing them, so a composite comes after everything in it. The
+     * first time it meets an object again it writes a reference to that
+     * number instead. What goes through writeObject is the root, the
+     * elements of lists, the keys and values of maps and any field not
+     * declared as a primitive. A String field, the name of an enum's
+     * constant or the string a type with a custom serializer is written
+     * as are put in place, never numbered and never referred to, so the
+     * table can't be built from the encoding alone. It needs the schema.
+     *
+     * The readers therefore number the objects, see Cursor::root, and
+     * only when a reference is first resolved, most blobs have none. The
+     * root is then read again, anything a reader skipped the first time
+     * included, with each value at one of the places above added as it's
+     * finished, see auto_number. Each entry is a view of the object's
+     * complete encoding, found in constant time by its number, that a
+     * new cursor can walk.
+     */
+    class References {
+        private :
+            std::vector<std::string_view> m_objects;
+
+            bool m_started;
+
+        public :
+            References();
+            References (const References &) = delete;
+
+            /**
+             * Whether the JVM numbers the value at the cursor should it
+             * have been written by writeObject. A reference is not an
+             * object of its own.
+             */
+            static bool isObject (const Cursor &);
+
+            /**
+             * Set once the objects start being numbered, references met
+             * while they are can only be to those before them
+             */
+            bool started() const;
+            void start();
+
+            void add (std::string_view);
+
+            size_t size() const;
+
+            /**
+             * The complete encoding of object index_, throws
+             * std::runtime_error if the blob doesn't hold that many
+             */
+            std::string_view object (size_t index_) const;
+    };
+
+}
+
+/******************************************************************************/
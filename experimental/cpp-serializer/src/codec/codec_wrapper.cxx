@@ -0,0 +1,431 @@
+#include "codec_wrapper.h"
+#include "References.h"
+
+#include <sstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+/******************************************************************************/
+
+std::ostream&
+operator << (std::ostream& stream, codec::Cursor * data_) {
+    auto type = data_->type();
+    stream << std::setw (2) << type << " " << codec::type_name (type);
+
+    switch (type) {
+        case codec::AMQP_ULONG :
+            {
+                stream << " " << data_->getULong();
+                break;
+            }
+        case codec::AMQP_LIST :
+            {
+                stream << " #entries: " << data_->getList();
+                break;
+            }
+        case codec::AMQP_STRING :
+            {
+                stream << " " << data_->getString();
+                break;
+            }
+        case codec::AMQP_INT :
+            {
+                stream << " " << data_->getInt();
+                break;
+            }
+        case codec::AMQP_BOOL :
+            {
+                stream << " " << (data_->getBool() ? "true" : "false");
+                break;
+            }
+        case codec::AMQP_SYMBOL :
+            {
+                stream << " " << data_->getSymbol();
+                break;
+            }
+
+        default : break;
+    }
+
+    return stream;
+}
+
+/******************************************************************************/
+
+void
+codec::is_described (Cursor * data_) {
+    if (data_->type() != AMQP_DESCRIBED) {
+        throw std::runtime_error ("Expected a described type");
+    }
+}
+
+/******************************************************************************/
+
+void
+codec::is_ulong (Cursor * data_) {
+    auto t = data_->type();
+    if (t != AMQP_ULONG) {
+        std::stringstream ss;
+        ss << "Expected an unsigned long but received " << type_name (t);
+        throw std::runtime_error (ss.str());
+    }
+}
+
+/******************************************************************************/
+
+void
+codec::is_symbol (Cursor * data_) {
+    if (data_->type() != AMQP_SYMBOL) {
+        throw std::runtime_error ("Expected a symbol");
+    }
+}
+
+/******************************************************************************/
+
+void
+codec::is_list (Cursor * data_) {
+    if (data_->type() != AMQP_LIST) {
+        throw std::runtime_error ("Expected a list");
+    }
+}
+
+/******************************************************************************/
+
+void
+codec::is_map (Cursor * data_) {
+    if (data_->type() != AMQP_MAP) {
+        throw std::runtime_error ("Expected a map");
+    }
+}
+
+/******************************************************************************/
+
+void
+codec::is_string (Cursor * data_, bool allowNull) {
+    if (data_->type() != AMQP_STRING) {
+        if (!allowNull || data_->type() != AMQP_NULL) {
+            throw std::runtime_error ("Expected a String");
+        }
+    }
+}
+
+/******************************************************************************/
+
+std::string
+codec::get_string (Cursor * data_, bool allowNull) {
+    if (data_->type() == AMQP_STRING) {
+        return std::string (data_->getString());
+    } else  if (allowNull && data_->type() == AMQP_NULL) {
+        return "";
+    }
+    throw std::runtime_error ("Expected a String");
+}
+
+/******************************************************************************/
+
+template<>
+std::string
+codec::get_symbol<std::string> (Cursor * data_) {
+    is_symbol (data_);
+    return std::string (data_->getSymbol());
+}
+
+template<>
+std::string_view
+codec::get_symbol<std::string_view> (Cursor * data_) {
+    is_symbol (data_);
+    return data_->getSymbol();
+}
+
+/******************************************************************************/
+
+bool
+codec::get_boolean (Cursor * data_) {
+    if (data_->type() == AMQP_BOOL) {
+        return data_->getBool();
+    }
+    throw std::runtime_error ("Expected a boolean");
+}
+
+/******************************************************************************
+ *
+ * codec::auto_enter
+ *
+ ******************************************************************************/
+
+codec::
+auto_enter::auto_enter (Cursor * data_, bool next_)
+    : m_data (data_)
+{
+    m_data->enter();
+    m_data->next();
+    if (next_) m_data->next();
+}
+
+/******************************************************************************/
+
+codec::
+auto_enter::~auto_enter() {
+    m_data->exit();
+}
+
+/******************************************************************************
+ *
+ * codec::auto_next
+ *
+ ******************************************************************************/
+
+codec::
+auto_next::auto_next (
+    Cursor * data_
+) : m_data (data_) {
+}
+
+/******************************************************************************/
+
+codec::
+auto_next::~auto_next() {
+    m_data->next();
+}
+
+/******************************************************************************
+ *
+ * codec::auto_list_enter
+ *
+ ******************************************************************************/
+
+codec::
+auto_list_enter::auto_list_enter (Cursor * data_, bool next_)
+    : m_elements (data_->type() == AMQP_ARRAY ? data_->getArray() : data_->getList())
+    , m_data (data_)
+{
+   m_data->enter();
+   if (next_) {
+       m_data->next();
+   }
+}
+
+/******************************************************************************/
+
+codec::
+auto_list_enter::~auto_list_enter() {
+    m_data->exit();
+}
+
+/******************************************************************************/
+
+size_t
+codec::
+auto_list_enter::elements() const {
+    return m_elements;
+}
+
+/******************************************************************************
+ *
+ * codec::auto_map_enter
+ *
+ ******************************************************************************/
+
+codec::
+auto_map_enter::auto_map_enter (Cursor * data_, bool next_)
+    : m_entries (data_->getMap() / 2)
+    , m_data (data_)
+{
+    is_map (data_);
+
+    m_data->enter();
+    if (next_) {
+        m_data->next();
+    }
+}
+
+/******************************************************************************/
+
+codec::
+auto_map_enter::~auto_map_enter() {
+    m_data->exit();
+}
+
+/******************************************************************************/
+
+size_t
+codec::
+auto_map_enter::entries() const {
+    return m_entries;
+}
+
+/******************************************************************************
+ *
+ * codec::auto_resolve
+ *
+ ******************************************************************************/
+
+codec::
+auto_resolve::auto_resolve (Cursor * data_)
+    : m_data (data_)
+    , m_index (0)
+{
+    if (data_->isReference (m_index)) {
+        m_object.emplace (data_->object (m_index), *data_);
+        m_object->next();
+    }
+}
+
+/******************************************************************************/
+
+codec::
+auto_resolve::~auto_resolve() {
+    if (m_object) {
+        m_data->next();
+    }
+}
+
+/******************************************************************************/
+
+size_t
+codec::
+auto_resolve::index() const {
+    return m_index;
+}
+
+/******************************************************************************/
+
+codec::Cursor *
+codec::
+auto_resolve::object() {
+    return &*m_object;
+}
+
+/******************************************************************************
+ *
+ * codec::auto_number
+ *
+ ******************************************************************************/
+
+codec::
+auto_number::auto_number (Cursor * data_, bool object_)
+    : m_data (data_)
+{
+    if (object_ && data_->numbering() && References::isObject (*data_)) {
+        m_object = data_->bytes();
+    }
+}
+
+/******************************************************************************/
+
+codec::
+auto_number::~auto_number() {
+    if (!m_object.empty()) {
+        m_data->references().add (m_object);
+    }
+}
+
+/******************************************************************************
+ *
+ *
+ *
+ ******************************************************************************/
+
+template<>
+int32_t
+codec::
+readAndNext<int32_t> (
+    Cursor * data_,
+    bool tolerateDeviance_
+) {
+    auto_next an (data_);
+    return data_->getInt();
+}
+
+/******************************************************************************/
+
+template<>
+std::string_view
+codec::
+readAndNext<std::string_view> (
+    Cursor * data_,
+    bool tolerateDeviance_
+) {
+    auto_next an (data_);
+
+    switch (data_->type()) {
+        case AMQP_STRING : return data_->getString();
+        case AMQP_SYMBOL : return data_->getSymbol();
+        case AMQP_NULL : {
+            if (tolerateDeviance_) return std::string_view();
+            break;
+        }
+        default : break;
+    }
+
+    std::stringstream ss;
+    ss << "Expected a String but found [" << data_ << "]";
+    throw std::runtime_error (ss.str());
+}
+
+/******************************************************************************/
+
+template<>
+std::string
+codec::
+readAndNext<std::string> (
+    Cursor * data_,
+    bool tolerateDeviance_
+) {
+    return std::string (readAndNext<std::string_view> (data_, tolerateDeviance_));
+}
+
+/******************************************************************************/
+
+template<>
+bool
+codec::
+readAndNext<bool> (
+    Cursor * data_,
+    bool tolerateDeviance_
+) {
+    auto_next an (data_);
+    return data_->getBool();
+}
+
+/******************************************************************************/
+
+template<>
+double
+codec::
+readAndNext<double> (
+    Cursor * data_,
+    bool tolerateDeviance_
+) {
+    auto_next an (data_);
+    return data_->getDouble();
+}
+
+/******************************************************************************/
+
+template<>
+long
+codec::
+readAndNext<long> (
+    Cursor * data_,
+    bool tolerateDeviance_
+) {
+    auto_next an (data_);
+    return data_->getLong();
+}
+
+/******************************************************************************/
+
+template<>
+u_long
+codec::
+readAndNext<u_long> (
+    Cursor * data_,
+    bool tolerateDeviance_
+) {
+    auto_next an (data_);
+    return data_->getULong();
+}
+
+/******************************************************************************/
@@ -0,0 +1,195 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <iosfwd>
+#include <string>
+#include <optional>
+#include <string_view>
+#include <sys/types.h>
+
+#include "Cursor.h"
+
+/******************************************************************************/
+
+/**
+ * Friendly ostream operator for a cursor, prints the current node
+ */
+std::ostream& operator << (std::ostream& stream, codec::Cursor * data_);
+
+/******************************************************************************/
+
+/**
+ * The equivalents of the proton wrapper functions for the native cursor
+ * so readers can be written in exactly the same style against either
+ */
+namespace codec {
+
+    void is_list (Cursor *);
+    void is_map (Cursor *);
+    void is_ulong (Cursor *);
+    void is_symbol (Cursor *);
+    void is_string (Cursor *, bool allowNull = false);
+    void is_described (Cursor *);
+
+    template<typename T>
+    T get_symbol (Cursor * data_) {
+        return T {};
+    }
+
+    template<>
+    std::string get_symbol<std::string> (Cursor *);
+
+    template<>
+    std::string_view get_symbol<std::string_view> (Cursor *);
+
+    bool get_boolean (Cursor *);
+    std::string get_string (Cursor *, bool allowNull = false);
+
+    /**
+     * Enter the current node and move onto its first child
+     */
+    class auto_enter {
+        private :
+            Cursor * m_data;
+
+        public :
+            explicit auto_enter (Cursor *, bool next_ = false);
+            ~auto_enter();
+    };
+
+    class auto_next {
+        private :
+            Cursor * m_data;
+
+        public :
+            explicit auto_next (Cursor *);
+            auto_next (const auto_next &) = delete;
+
+            explicit operator Cursor *() {
+                return m_data;
+            }
+
+            ~auto_next();
+    };
+
+    /**
+     * Enter a list, or an array, the JVM writes its primitive arrays as
+     * those, and move onto its first element
+     */
+    class auto_list_enter {
+        private :
+            size_t   m_elements;
+            Cursor * m_data;
+
+        public :
+            explicit auto_list_enter (Cursor *, bool next_ = false);
+            ~auto_list_enter();
+
+            size_t elements() const;
+    };
+
+    /**
+     * As auto_list_enter for a map, whose children are each of its keys
+     * followed by its value
+     */
+    class auto_map_enter {
+        private :
+            size_t   m_entries;
+            Cursor * m_data;
+
+        public :
+            explicit auto_map_enter (Cursor *, bool next_ = false);
+            ~auto_map_enter();
+
+            /**
+             * The number of keys
+             */
+            size_t entries() const;
+    };
+
+    /**
+     * Readers of anything the JVM may have written as a back reference,
+     * see Cursor::isReference, start with one of these. If the current
+     * node is a reference it holds a cursor on the object referred to,
+     * ready to be read in its place, and moves the original past the
+     * reference as it goes out of scope. Otherwise it does nothing.
+     */
+    class auto_resolve {
+        private :
+            Cursor *              m_data;
+            size_t                m_index;
+            std::optional<Cursor> m_object;
+
+        public :
+            explicit auto_resolve (Cursor *);
+            auto_resolve (const auto_resolve &) = delete;
+            ~auto_resolve();
+
+            explicit operator bool() const {
+                return m_object.has_value();
+            }
+
+            /**
+             * The object's number in the blob's object table
+             */
+            size_t index() const;
+
+            Cursor * object();
+    };
+
+    /**
+     * Readers put one of these around reading anything the JVM wrote
+     * with writeObject, an element of a list, a key or value of a map or
+     * a field not of a primitive type. While the cursor is numbering the
+     * blob's objects, see References, the value is added to the table
+     * once it's been read, after everything inside it, if it's one the
+     * JVM numbers. Otherwise it does nothing.
+     */
+    class auto_number {
+        private :
+            Cursor *         m_data;
+            std::string_view m_object;
+
+        public :
+            explicit auto_number (Cursor *, bool object_ = true);
+            auto_number (const auto_number &) = delete;
+            ~auto_number();
+    };
+
+}
+
+/******************************************************************************/
+
+namespace codec {
+
+    template<typename T>
+    T
+    readAndNext (Cursor *, bool tolerateDeviance_ = false) {
+        return T{};
+    }
+
+    template<>
+    int32_t readAndNext<int32_t> (Cursor *, bool);
+
+    template<>
+    std::string readAndNext<std::string> (Cursor *, bool);
+
+    template<>
+    std::string_view readAndNext<std::string_view> (Cursor *, bool);
+
+    template<>
+    bool readAndNext<bool> (Cursor *, bool);
+
+    template<>
+    double readAndNext<double> (Cursor *, bool);
+
+    template<>
+    long readAndNext<long> (Cursor *, bool);
+
+    template<>
+    u_long readAndNext<u_long> (Cursor *, bool);
+
+}
+
+/******************************************************************************/
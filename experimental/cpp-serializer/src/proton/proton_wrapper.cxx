@@ -114,6 +114,15 @@ proton::is_list (pn_data_t * data_) {
 
 /******************************************************************************/
 
+void
+proton::is_map (pn_data_t * data_) {
+    if (pn_data_type(data_) != PN_MAP) {
+        throw std::runtime_error ("Expected a map");
+    }
+}
+
+/******************************************************************************/
+
 void
 proton::is_string (pn_data_t * data_, bool allowNull) {
     if (pn_data_type(data_) != PN_STRING) {
@@ -26,6 +26,7 @@ namespace proton {
     bool pn_data_enter(pn_data_t *);
 
     void is_list (pn_data_t *);
+    void is_map (pn_data_t *);
     void is_ulong (pn_data_t *);
     void is_symbol (pn_data_t *);
     void is_string (pn_data_t *, bool allowNull = false);
@@ -0,0 +1,308 @@
+#include "Encoder.h"
+
+#include <array>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "amqp/descriptors/AMQPDescriptorRegistory.h"
+
+/******************************************************************************/
+
+namespace {
+
+    /*
+     * Format codes, see section 1.6 of the AMQP 1.0 specification
+     */
+    constexpr char DESCRIBED  = '\x00';
+    constexpr char NULL_      = '\x40';
+    constexpr char TRUE_      = '\x41';
+    constexpr char FALSE_     = '\x42';
+    constexpr char EMPTY_LIST = '\x45';
+    constexpr char SMALLINT   = '\x54';
+    constexpr char SMALLLONG  = '\x55';
+    constexpr char INT        = '\x71';
+    constexpr char ULONG      = '\x80';
+    constexpr char LONG       = '\x81';
+    constexpr char DOUBLE     = '\x82';
+    constexpr char VBIN8      = '\xa0';
+    constexpr char STR8       = '\xa1';
+    constexpr char SYM8       = '\xa3';
+    constexpr char VBIN32     = '\xb0';
+    constexpr char STR32      = '\xb1';
+    constexpr char SYM32      = '\xb3';
+    constexpr char MAP8       = '\xc1';
+    constexpr char LIST32     = '\xd0';
+
+    /*
+     * AMQP is big endian on the wire
+     */
+    inline void
+    be32 (char * p_, uint32_t i_) {
+        p_[0] = static_cast<char>(i_ >> 24U);
+        p_[1] = static_cast<char>(i_ >> 16U);
+        p_[2] = static_cast<char>(i_ >> 8U);
+        p_[3] = static_cast<char>(i_);
+    }
+
+    inline void
+    be64 (char * p_, uint64_t i_) {
+        be32 (p_, static_cast<uint32_t>(i_ >> 32U));
+        be32 (p_ + 4, static_cast<uint32_t>(i_));
+    }
+
+    inline bool
+    small (int64_t i_) {
+        return i_ >= std::numeric_limits<int8_t>::min()
+            && i_ <= std::numeric_limits<int8_t>::max();
+    }
+
+    /*
+     * Binary, strings and symbols share their encoding, only the codes differ
+     */
+    inline void
+    variable (std::string & buffer_, char code8_, char code32_, std::string_view s_) {
+        if (s_.size() <= std::numeric_limits<uint8_t>::max()) {
+            buffer_ += code8_;
+            buffer_ += static_cast<char>(s_.size());
+        } else {
+            if (s_.size() > std::numeric_limits<uint32_t>::max()) {
+                throw std::runtime_error ("String, symbol or binary too large to encode");
+            }
+
+            char header[5] { code32_ };
+            be32 (header + 1, static_cast<uint32_t>(s_.size()));
+            buffer_.append (header, sizeof (header));
+        }
+
+        buffer_.append (s_.data(), s_.size());
+    }
+
+    uint64_t
+    fnv1a (std::string_view bytes_, uint64_t hash_) {
+        for (auto c : bytes_) {
+            hash_ ^= static_cast<uint8_t>(c);
+            hash_ *= 0x100000001b3UL;
+        }
+
+        return hash_;
+    }
+
+    std::string
+    base64 (const uint8_t * bytes_, size_t size_) {
+        const char * alphabet =
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+        std::string rtn;
+        rtn.reserve (((size_ + 2) / 3) * 4);
+
+        for (size_t i { 0 } ; i < size_ ; i += 3) {
+            uint32_t n = static_cast<uint32_t>(bytes_[i]) << 16U;
+            if (i + 1 < size_) n |= static_cast<uint32_t>(bytes_[i + 1]) << 8U;
+            if (i + 2 < size_) n |= bytes_[i + 2];
+
+            rtn += alphabet[(n >> 18U) & 0x3fU];
+            rtn += alphabet[(n >> 12U) & 0x3fU];
+            rtn += i + 1 < size_ ? alphabet[(n >> 6U) & 0x3fU] : '=';
+            rtn += i + 2 < size_ ? alphabet[n & 0x3fU] : '=';
+        }
+
+        return rtn;
+    }
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::serialiser::Encoder
+ *
+ ******************************************************************************/
+
+amqp::internal::serialiser::
+Encoder::Encoder (std::string & buffer_)
+    : m_buffer (buffer_)
+{ }
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+Encoder::putNull() {
+    m_buffer += NULL_;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+Encoder::putBool (bool b_) {
+    m_buffer += b_ ? TRUE_ : FALSE_;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+Encoder::putInt (int32_t i_) {
+    if (small (i_)) {
+        char bytes[2] { SMALLINT, static_cast<char>(i_) };
+        m_buffer.append (bytes, sizeof (bytes));
+    } else {
+        char bytes[5] { INT };
+        be32 (bytes + 1, static_cast<uint32_t>(i_));
+        m_buffer.append (bytes, sizeof (bytes));
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+Encoder::putLong (int64_t l_) {
+    if (small (l_)) {
+        char bytes[2] { SMALLLONG, static_cast<char>(l_) };
+        m_buffer.append (bytes, sizeof (bytes));
+    } else {
+        char bytes[9] { LONG };
+        be64 (bytes + 1, static_cast<uint64_t>(l_));
+        m_buffer.append (bytes, sizeof (bytes));
+    }
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+Encoder::putULong (uint64_t l_) {
+    char bytes[9] { ULONG };
+    be64 (bytes + 1, l_);
+    m_buffer.append (bytes, sizeof (bytes));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+Encoder::putDouble (double d_) {
+    uint64_t bits;
+    memcpy (&bits, &d_, sizeof (bits));
+
+    char bytes[9] { DOUBLE };
+    be64 (bytes + 1, bits);
+    m_buffer.append (bytes, sizeof (bytes));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+Encoder::putString (std::string_view s_) {
+    variable (m_buffer, STR8, STR32, s_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+Encoder::putSymbol (std::string_view s_) {
+    variable (m_buffer, SYM8, SYM32, s_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+Encoder::putBinary (std::string_view bytes_) {
+    variable (m_buffer, VBIN8, VBIN32, bytes_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+Encoder::putDescribed() {
+    m_buffer += DESCRIBED;
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+Encoder::putDescribed (int id_) {
+    putDescribed();
+    putULong (DESCRIPTOR_TOP_32BITS | static_cast<uint64_t>(id_));
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+Encoder::putEmptyList() {
+    m_buffer += EMPTY_LIST;
+}
+
+/******************************************************************************/
+
+/**
+ * AMQP has no empty map constructor, a map8 with a count of zero
+ */
+void
+amqp::internal::serialiser::
+Encoder::putEmptyMap() {
+    char bytes[3] { MAP8, 1, 0 };
+    m_buffer.append (bytes, sizeof (bytes));
+}
+
+/******************************************************************************/
+
+size_t
+amqp::internal::serialiser::
+Encoder::beginList() {
+    auto rtn = m_buffer.size();
+
+    char header[9] { LIST32 };
+    m_buffer.append (header, sizeof (header));
+
+    return rtn;
+}
+
+/******************************************************************************/
+
+/**
+ * The size covers the count as well as the elements
+ */
+void
+amqp::internal::serialiser::
+Encoder::endList (size_t start_, uint32_t count_) {
+    auto size = m_buffer.size() - start_ - 5;
+
+    if (size > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error ("List too large to encode");
+    }
+
+    be32 (&m_buffer[start_ + 1], static_cast<uint32_t>(size));
+    be32 (&m_buffer[start_ + 5], count_);
+}
+
+/******************************************************************************/
+
+void
+amqp::internal::serialiser::
+Encoder::putEncoded (std::string_view bytes_) {
+    m_buffer.append (bytes_.data(), bytes_.size());
+}
+
+/******************************************************************************/
+
+std::string
+amqp::internal::serialiser::
+descriptor (std::string_view fingerprint_) {
+    std::array<uint8_t, 16> bytes { };
+
+    be64 (reinterpret_cast<char *>(bytes.data()), fnv1a (fingerprint_, 0xcbf29ce484222325UL));
+    be64 (reinterpret_cast<char *>(bytes.data() + 8), fnv1a (fingerprint_, 0x84222325cbf29ce4UL));
+
+    return "net.corda:" + base64 (bytes.data(), bytes.size());
+}
+
+/******************************************************************************/
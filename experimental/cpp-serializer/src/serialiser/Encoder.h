@@ -0,0 +1,92 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <string>
+#include <cstdint>
+#include <string_view>
+
+/******************************************************************************
+ *
+ * class amqp::internal::serialiser::Encoder
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::serialiser {
+
+    /**
+     * The writing counterpart of codec::Cursor, appends the AMQP 1.0
+     * encoding of each value put to it onto the end of a buffer.
+     *
+     * Everything is written in a single pass. A list's size and count
+     * aren't known until its last element has been written so beginList
+     * leaves room for a 32 bit header that endList fills in, rather than
+     * encoding the elements somewhere else first and copying them in.
+     *
+     * The buffer belongs to the caller, reusing one between blobs means
+     * once it has grown large enough nothing is allocated at all.
+     */
+    class Encoder {
+        private :
+            std::string & m_buffer;
+
+        public :
+            explicit Encoder (std::string &);
+
+            void putNull();
+            void putBool (bool);
+            void putInt (int32_t);
+            void putLong (int64_t);
+            void putULong (uint64_t);
+            void putDouble (double);
+            void putString (std::string_view);
+            void putSymbol (std::string_view);
+            void putBinary (std::string_view);
+
+            /**
+             * Starts a described type, the descriptor and then the
+             * described value should be put next
+             */
+            void putDescribed();
+
+            /**
+             * A described type whose descriptor is one of the Corda
+             * ulongs, see AMQPDescriptorRegistory.h
+             */
+            void putDescribed (int);
+
+            void putEmptyList();
+            void putEmptyMap();
+
+            /**
+             * Returns where the list starts, to be handed back to endList
+             * along with the number of elements written in between
+             */
+            size_t beginList();
+            void endList (size_t, uint32_t);
+
+            /**
+             * Bytes that are already encoded, a cached schema for example
+             */
+            void putEncoded (std::string_view);
+    };
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::serialiser {
+
+    /**
+     * A descriptor symbol, "net.corda:" followed by 16 base64 encoded
+     * bytes as the JVM's are, derived from a fingerprint of the type.
+     *
+     * These aren't the JVM's fingerprints, computing those needs the
+     * Java class, but the same fingerprint always gives the same
+     * descriptor so blobs of a type can be matched with each other.
+     */
+    std::string descriptor (std::string_view);
+
+}
+
+/******************************************************************************/
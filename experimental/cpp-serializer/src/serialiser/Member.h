@@ -0,0 +1,359 @@
+#pragma once
+
+/******************************************************************************/
+
+#include <set>
+#include <tuple>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <type_traits>
+
+#include "Encoder.h"
+
+#include "amqp/reader/Binary.h"
+#include "amqp/binding/Binding.h"
+#include "amqp/descriptors/AMQPDescriptorRegistory.h"
+
+/******************************************************************************
+ *
+ * amqp::internal::serialiser::Types
+ *
+ ******************************************************************************/
+
+namespace amqp::internal::serialiser {
+
+    /**
+     * The type notations of a schema as it's built, each type is only
+     * written the first time it's seen
+     */
+    struct Types {
+        std::set<std::string> names;
+        std::string           bytes;
+        uint32_t              count { 0 };
+
+        bool
+        add (const std::string & name_) {
+            if (!names.insert (name_).second) return false;
+
+            ++count;
+            return true;
+        }
+    };
+
+}
+
+/******************************************************************************
+ *
+ * amqp::internal::serialiser::Member
+ *
+ ******************************************************************************/
+
+/**
+ * How a member of type M is described in a schema and how its values are
+ * encoded, the counterpart of binding::Member.
+ *
+ *   name     - the type as the schema knows it
+ *   list     - whether fields of it are restricted types, a field's type
+ *              then being "*" and its requires naming the type
+ *   schema   - add its type notation, and those of anything it holds,
+ *              nothing for primitives
+ *   encode   - put a value
+ */
+namespace amqp::internal::serialiser {
+
+    template<typename M>
+    struct unencodable : std::false_type { };
+
+    template<typename M, typename = void>
+    struct Member {
+        static_assert (unencodable<M>::value,
+            "Only int32_t, int64_t, double, bool, std::string, "
+            "amqp::reader::Binary, bound structs and vectors of them can "
+            "be serialised");
+    };
+
+    template<typename M>
+    struct Primitive {
+        static constexpr bool list { false };
+
+        static std::string
+        name() {
+            return Member<M>::type;
+        }
+
+        static void
+        schema (Types &) { }
+    };
+
+    template<>
+    struct Member<int32_t> : Primitive<int32_t> {
+        static constexpr const char * type { "int" };
+
+        static void
+        encode (Encoder & out_, int32_t value_) {
+            out_.putInt (value_);
+        }
+    };
+
+    template<>
+    struct Member<int64_t> : Primitive<int64_t> {
+        static constexpr const char * type { "long" };
+
+        static void
+        encode (Encoder & out_, int64_t value_) {
+            out_.putLong (value_);
+        }
+    };
+
+    template<>
+    struct Member<double> : Primitive<double> {
+        static constexpr const char * type { "double" };
+
+        static void
+        encode (Encoder & out_, double value_) {
+            out_.putDouble (value_);
+        }
+    };
+
+    template<>
+    struct Member<bool> : Primitive<bool> {
+        static constexpr const char * type { "boolean" };
+
+        static void
+        encode (Encoder & out_, bool value_) {
+            out_.putBool (value_);
+        }
+    };
+
+    template<>
+    struct Member<std::string> : Primitive<std::string> {
+        static constexpr const char * type { "string" };
+
+        static void
+        encode (Encoder & out_, const std::string & value_) {
+            out_.putString (value_);
+        }
+    };
+
+    template<>
+    struct Member<amqp::reader::Binary> : Primitive<amqp::reader::Binary> {
+        static constexpr const char * type { "binary" };
+
+        static void
+        encode (Encoder & out_, const amqp::reader::Binary & value_) {
+            out_.putBinary (value_.bytes);
+        }
+    };
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::serialiser {
+
+    /**
+     * A type's object descriptor, the symbol and a null code
+     */
+    inline void
+    putDescriptor (Encoder & out_, const std::string & symbol_) {
+        out_.putDescribed (OBJECT_DESCRIPTOR);
+        auto list = out_.beginList();
+        out_.putSymbol (symbol_);
+        out_.putNull();
+        out_.endList (list, 2);
+    }
+
+    /**
+     * A composite's field. Members can't be null so every field is
+     * mandatory. One of a restricted type is "*" requiring that type
+     */
+    inline void
+    putField (
+        Encoder & out_,
+        std::string_view name_,
+        const std::string & type_,
+        bool restricted_
+    ) {
+        out_.putDescribed (FIELD);
+        auto list = out_.beginList();
+        out_.putString (name_);
+
+        if (restricted_) {
+            out_.putString ("*");
+            auto required = out_.beginList();
+            out_.putString (type_);
+            out_.endList (required, 1);
+        } else {
+            out_.putString (type_);
+            out_.putEmptyList();
+        }
+
+        out_.putNull();                 // default
+        out_.putNull();                 // label
+        out_.putBool (true);            // mandatory
+        out_.putBool (false);           // multiple
+        out_.endList (list, 7);
+    }
+
+    /**
+     * Vectors are java.util.Lists, a restricted type with a list source
+     */
+    template<typename E>
+    struct Member<std::vector<E>> {
+        static constexpr bool list { true };
+
+        static const std::string &
+        name() {
+            static const std::string name { "java.util.List<" + Member<E>::name() + ">" };
+            return name;
+        }
+
+        static const std::string &
+        descriptor() {
+            static const std::string descriptor { serialiser::descriptor (name()) };
+            return descriptor;
+        }
+
+        static void
+        schema (Types & types_) {
+            if (!types_.add (name())) return;
+
+            {
+                Encoder out (types_.bytes);
+
+                out.putDescribed (RESTRICTED_TYPE);
+                auto list = out.beginList();
+                out.putString (name());
+                out.putNull();              // label
+                out.putEmptyList();         // provides
+                out.putString ("list");     // source
+                putDescriptor (out, descriptor());
+                out.putEmptyList();         // choices
+                out.endList (list, 6);
+            }
+
+            Member<E>::schema (types_);
+        }
+
+        static void
+        encode (Encoder & out_, const std::vector<E> & value_) {
+            out_.putDescribed();
+            out_.putSymbol (descriptor());
+
+            auto list = out_.beginList();
+            for (const auto & element : value_) {
+                Member<E>::encode (out_, element);
+            }
+            out_.endList (list, static_cast<uint32_t>(value_.size()));
+        }
+    };
+
+}
+
+/******************************************************************************/
+
+namespace amqp::internal::serialiser {
+
+    /**
+     * Whether a Binding names the descriptor its type has on the JVM
+     */
+    template<typename T, typename = void>
+    struct has_descriptor : std::false_type { };
+
+    template<typename T>
+    struct has_descriptor<T, std::void_t<decltype (amqp::binding::Binding<T>::descriptor)>>
+        : std::true_type { };
+
+    /**
+     * Bound structs are composites, encoded as a described list of
+     * their bound members in the order the binding lists them
+     */
+    template<typename T>
+    struct Member<T, std::enable_if_t<amqp::binding::is_bound_struct_v<T>>> {
+        using Binding = amqp::binding::Binding<T>;
+
+        static constexpr bool list { false };
+
+        static std::string
+        name() {
+            return std::string (Binding::type);
+        }
+
+        /**
+         * Unless the binding says otherwise, derived from the type's name
+         * along with the names and types of its fields
+         */
+        static const std::string &
+        descriptor() {
+            static const std::string descriptor = []() {
+                if constexpr (has_descriptor<T>::value) {
+                    return std::string (Binding::descriptor);
+                } else {
+                    std::string fingerprint { name() };
+
+                    std::apply ([&](const auto & ... field_) {
+                        ((fingerprint += "|" + std::string (field_.name) + ":"
+                            + Member<typename std::decay_t<decltype (field_)>::Type>::name()), ...);
+                    }, Binding::fields);
+
+                    return serialiser::descriptor (fingerprint);
+                }
+            }();
+
+            return descriptor;
+        }
+
+        static void
+        schema (Types & types_) {
+            if (!types_.add (name())) return;
+
+            {
+                Encoder out (types_.bytes);
+
+                out.putDescribed (COMPOSITE_TYPE);
+                auto list = out.beginList();
+                out.putString (name());
+                out.putNull();              // label
+                out.putEmptyList();         // provides
+                putDescriptor (out, descriptor());
+
+                auto fields = out.beginList();
+                std::apply ([&](const auto & ... field_) {
+                    (field<typename std::decay_t<decltype (field_)>::Type> (out, field_.name), ...);
+                }, Binding::fields);
+                out.endList (fields, std::tuple_size_v<std::decay_t<decltype (Binding::fields)>>);
+
+                out.endList (list, 5);
+            }
+
+            std::apply ([&](const auto & ... field_) {
+                (Member<typename std::decay_t<decltype (field_)>::Type>::schema (types_), ...);
+            }, Binding::fields);
+        }
+
+        static void
+        encode (Encoder & out_, const T & value_) {
+            out_.putDescribed();
+            out_.putSymbol (descriptor());
+
+            auto list = out_.beginList();
+            std::apply ([&](const auto & ... field_) {
+                (Member<typename std::decay_t<decltype (field_)>::Type>::encode (
+                    out_, value_.*field_.member), ...);
+            }, Binding::fields);
+            out_.endList (list, std::tuple_size_v<std::decay_t<decltype (Binding::fields)>>);
+        }
+
+    private :
+        template<typename M>
+        static void
+        field (Encoder & out_, std::string_view name_) {
+            putField (out_, name_, Member<M>::name(), Member<M>::list);
+        }
+    };
+
+}
+
+/******************************************************************************/